@@ -0,0 +1,642 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "mococrw/aead_stream.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <thread>
+
+#include <boost/format.hpp>
+
+#include "mococrw/error.h"
+#include "mococrw/kdf.h"
+#include "mococrw/private/bounded_queue.h"
+#include "mococrw/private/parallel.h"
+#include "mococrw/util.h"
+
+namespace mococrw
+{
+using namespace openssl;
+
+const size_t AEADStreamEncryptor::DefaultSegmentSize = 64 * 1024;
+const size_t AEADStreamEncryptor::HeaderLength = 8 /* magic */ + 1 /* mode */ +
+                                                 4 /* segment size */ + 16 /* salt */ +
+                                                 7 /* nonce prefix */;
+const size_t AEADStreamEncryptor::TagLength = 16;
+
+namespace
+{
+const std::vector<uint8_t> streamMagic = {'M', 'C', 'R', 'W', 'S', 'T', 'M', 1};
+const size_t saltOffset = 13;
+const size_t saltLength = 16;
+const size_t noncePrefixOffset = saltOffset + saltLength;
+const size_t noncePrefixLength = 7;
+const size_t nonceLength = 12;
+const size_t streamKeyLength = 32;
+const size_t maximumSegmentSize = 16 * 1024 * 1024;
+const uint64_t maximumNumberOfSegments = uint64_t{1} << 32;
+
+/* The file pipeline moves batches of about this size between the stages. */
+const size_t pipelineBatchSize = 4 * 1024 * 1024;
+const size_t pipelineDepth = 2;
+
+/* The enum values of SymmetricCipherMode are not part of the format, so use stable
+ * identifiers. */
+const std::map<SymmetricCipherMode, uint8_t> modeIdentifiers = {
+        {SymmetricCipherMode::GCM, 1}, {SymmetricCipherMode::CHACHA20_POLY1305, 2}};
+
+struct StreamParameters
+{
+    SymmetricCipherMode mode;
+    size_t segmentSize;
+};
+
+void checkMasterKey(const std::vector<uint8_t> &masterKey)
+{
+    if (masterKey.size() < streamKeyLength) {
+        auto formatter = boost::format("Master key must be at least %d bytes long.");
+        formatter % streamKeyLength;
+        throw MoCOCrWException(formatter.str());
+    }
+}
+
+void checkSegmentSize(size_t segmentSize)
+{
+    if (segmentSize == 0 || segmentSize > maximumSegmentSize) {
+        throw MoCOCrWException("Invalid segment size for AEAD stream.");
+    }
+}
+
+std::vector<uint8_t> createHeader(SymmetricCipherMode mode, size_t segmentSize)
+{
+    auto identifier = modeIdentifiers.find(mode);
+    if (identifier == modeIdentifiers.end()) {
+        throw MoCOCrWException("Unsupported cipher mode for AEAD stream.");
+    }
+    checkSegmentSize(segmentSize);
+
+    std::vector<uint8_t> header(streamMagic);
+    header.reserve(AEADStreamEncryptor::HeaderLength);
+    header.push_back(identifier->second);
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        header.push_back(static_cast<uint8_t>(segmentSize >> shift));
+    }
+    auto random = utility::cryptoRandomBytes(saltLength + noncePrefixLength);
+    header.insert(header.end(), random.begin(), random.end());
+    return header;
+}
+
+StreamParameters parseHeader(const std::vector<uint8_t> &header)
+{
+    if (header.size() != AEADStreamEncryptor::HeaderLength ||
+        !std::equal(streamMagic.begin(), streamMagic.end(), header.begin())) {
+        throw MoCOCrWException("Invalid AEAD stream header.");
+    }
+
+    StreamParameters parameters;
+    uint8_t identifier = header[streamMagic.size()];
+    auto entry = std::find_if(modeIdentifiers.begin(),
+                              modeIdentifiers.end(),
+                              [identifier](const std::pair<const SymmetricCipherMode, uint8_t> &e) {
+                                  return e.second == identifier;
+                              });
+    if (entry == modeIdentifiers.end()) {
+        throw MoCOCrWException("AEAD stream uses an unknown cipher mode.");
+    }
+    parameters.mode = entry->first;
+
+    parameters.segmentSize = 0;
+    for (size_t i = streamMagic.size() + 1; i < saltOffset; i++) {
+        parameters.segmentSize = (parameters.segmentSize << 8) | header[i];
+    }
+    checkSegmentSize(parameters.segmentSize);
+    return parameters;
+}
+
+std::vector<uint8_t> deriveStreamKey(const std::vector<uint8_t> &masterKey,
+                                     const std::vector<uint8_t> &header)
+{
+    checkMasterKey(masterKey);
+    /* The header contains the random salt and binds the key to all stream parameters. */
+    return X963KDF(DigestTypes::SHA256).deriveKey(masterKey, streamKeyLength, header);
+}
+
+/* Seals and opens the segments of one stream. All methods are const and may be called
+ * concurrently. */
+class SegmentCipher
+{
+public:
+    SegmentCipher(const std::vector<uint8_t> &masterKey, std::vector<uint8_t> header)
+            : _header{std::move(header)}
+            , _parameters{parseHeader(_header)}
+            , _key{_parameters.mode,
+                   SymmetricCipherKeySize::S_256,
+                   deriveStreamKey(masterKey, _header)}
+    {
+    }
+
+    const std::vector<uint8_t> &getHeader() const { return _header; }
+
+    size_t getSegmentSize() const { return _parameters.segmentSize; }
+
+    size_t getSealedSegmentSize() const
+    {
+        return _parameters.segmentSize + AEADStreamEncryptor::TagLength;
+    }
+
+    size_t seal(uint64_t index, bool last, const uint8_t *in, size_t length, uint8_t *out) const
+    {
+        auto nonce = _nonce(index, last);
+        return aeadSeal(_key,
+                        nonce.data(),
+                        nonce.size(),
+                        _header.data(),
+                        _header.size(),
+                        in,
+                        length,
+                        out,
+                        length + AEADStreamEncryptor::TagLength,
+                        AEADStreamEncryptor::TagLength);
+    }
+
+    size_t open(uint64_t index, bool last, const uint8_t *in, size_t length, uint8_t *out) const
+    {
+        if (length < AEADStreamEncryptor::TagLength) {
+            throw MoCOCrWException("AEAD stream is truncated.");
+        }
+        auto nonce = _nonce(index, last);
+        try {
+            return aeadOpen(_key,
+                            nonce.data(),
+                            nonce.size(),
+                            _header.data(),
+                            _header.size(),
+                            in,
+                            length,
+                            out,
+                            length - AEADStreamEncryptor::TagLength,
+                            AEADStreamEncryptor::TagLength);
+        } catch (const MoCOCrWException &) {
+            auto formatter = boost::format("Segment %d of the AEAD stream can't be authenticated.");
+            formatter % index;
+            throw MoCOCrWException(formatter.str());
+        }
+    }
+
+private:
+    std::array<uint8_t, nonceLength> _nonce(uint64_t index, bool last) const
+    {
+        if (index >= maximumNumberOfSegments) {
+            throw MoCOCrWException("AEAD stream exceeds the maximum number of segments.");
+        }
+        std::array<uint8_t, nonceLength> nonce;
+        std::copy(_header.begin() + noncePrefixOffset,
+                  _header.begin() + noncePrefixOffset + noncePrefixLength,
+                  nonce.begin());
+        for (size_t i = 0; i < 4; i++) {
+            nonce[noncePrefixLength + i] = static_cast<uint8_t>(index >> (8 * (3 - i)));
+        }
+        nonce[nonceLength - 1] = last ? 1 : 0;
+        return nonce;
+    }
+
+    std::vector<uint8_t> _header;
+    StreamParameters _parameters;
+    AESKey _key;
+};
+
+uint64_t getFileSize(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.good()) {
+        throw MoCOCrWException("Could not open file " + filename);
+    }
+    return static_cast<uint64_t>(file.tellg());
+}
+
+struct PipelineBatch
+{
+    uint64_t firstSegment = 0;
+    size_t numberOfSegments = 0;
+    std::vector<uint8_t> input;
+    std::vector<uint8_t> output;
+};
+
+/*
+ * Process the segments of a file in three stages: a reader thread reads batches of segments, the
+ * calling thread processes the segments of a batch in parallel and a writer thread writes the
+ * results. The stages are connected by bounded queues, so reading, processing and writing
+ * overlap while only a few batches are kept in memory.
+ *
+ * process(index, last, in, length, out) returns the number of bytes written to out.
+ */
+template <class Process>
+void runSegmentPipeline(std::ifstream &input,
+                        const std::string &inputFile,
+                        uint64_t inputLength,
+                        size_t inputSegmentSize,
+                        std::ofstream &output,
+                        const std::string &outputFile,
+                        size_t outputSegmentSize,
+                        unsigned int numberOfThreads,
+                        Process &&process)
+{
+    uint64_t numberOfSegments =
+            inputLength == 0 ? 1 : (inputLength - 1) / inputSegmentSize + 1;
+    if (numberOfSegments > maximumNumberOfSegments) {
+        throw MoCOCrWException("AEAD stream exceeds the maximum number of segments.");
+    }
+    size_t segmentsPerBatch = std::max<size_t>(1, pipelineBatchSize / inputSegmentSize);
+
+    detail::BoundedQueue<PipelineBatch> readQueue(pipelineDepth);
+    detail::BoundedQueue<PipelineBatch> writeQueue(pipelineDepth);
+    std::exception_ptr readError;
+    std::exception_ptr processError;
+    std::exception_ptr writeError;
+
+    std::thread reader([&]() {
+        try {
+            for (uint64_t first = 0; first < numberOfSegments; first += segmentsPerBatch) {
+                PipelineBatch batch;
+                batch.firstSegment = first;
+                batch.numberOfSegments = static_cast<size_t>(
+                        std::min<uint64_t>(segmentsPerBatch, numberOfSegments - first));
+                uint64_t offset = first * inputSegmentSize;
+                auto length = static_cast<size_t>(std::min<uint64_t>(
+                        batch.numberOfSegments * inputSegmentSize, inputLength - offset));
+                batch.input.resize(length);
+                input.read(reinterpret_cast<char *>(batch.input.data()), length);
+                if (static_cast<size_t>(input.gcount()) != length) {
+                    throw MoCOCrWException("Error while reading file " + inputFile);
+                }
+                if (!readQueue.push(std::move(batch))) {
+                    break;
+                }
+            }
+        } catch (...) {
+            readError = std::current_exception();
+        }
+        readQueue.close();
+    });
+
+    std::thread writer([&]() {
+        try {
+            PipelineBatch batch;
+            while (writeQueue.pop(batch)) {
+                output.write(reinterpret_cast<const char *>(batch.output.data()),
+                             batch.output.size());
+                if (!output.good()) {
+                    throw MoCOCrWException("Error while writing file " + outputFile);
+                }
+            }
+        } catch (...) {
+            writeError = std::current_exception();
+            writeQueue.close();
+            readQueue.close();
+        }
+    });
+
+    try {
+        PipelineBatch batch;
+        while (readQueue.pop(batch)) {
+            std::vector<size_t> written(batch.numberOfSegments);
+            batch.output.resize(batch.numberOfSegments * outputSegmentSize);
+            detail::parallelFor(batch.numberOfSegments, numberOfThreads, [&](size_t i) {
+                uint64_t index = batch.firstSegment + i;
+                size_t inOffset = i * inputSegmentSize;
+                size_t length = std::min(inputSegmentSize, batch.input.size() - inOffset);
+                written[i] = process(index,
+                                     index + 1 == numberOfSegments,
+                                     batch.input.data() + inOffset,
+                                     length,
+                                     batch.output.data() + i * outputSegmentSize);
+            });
+            /* Only the last segment of the stream may be shorter than a full segment. */
+            batch.output.resize((batch.numberOfSegments - 1) * outputSegmentSize + written.back());
+            if (!writeQueue.push(std::move(batch))) {
+                break;
+            }
+        }
+    } catch (...) {
+        processError = std::current_exception();
+        readQueue.close();
+    }
+    writeQueue.close();
+    reader.join();
+    writer.join();
+
+    for (const auto &error : {readError, processError, writeError}) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+std::ofstream openOutputFile(const std::string &filename)
+{
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.good()) {
+        throw MoCOCrWException("Could not open file " + filename);
+    }
+    return file;
+}
+
+/* Remove a partially written output file before the error is passed on. */
+template <class Func>
+void removeOutputOnError(const std::string &outputFile, Func &&func)
+{
+    try {
+        func();
+    } catch (...) {
+        std::remove(outputFile.c_str());
+        throw;
+    }
+}
+}  // namespace
+
+class AEADStreamEncryptor::Impl
+{
+public:
+    Impl(SymmetricCipherMode mode, const std::vector<uint8_t> &masterKey, size_t segmentSize)
+            : _cipher{masterKey, createHeader(mode, segmentSize)}
+    {
+    }
+
+    ~Impl() { utility::vectorCleanse(_buffer); }
+
+    std::vector<uint8_t> update(const std::vector<uint8_t> &plaintext)
+    {
+        _checkNotFinished();
+        std::vector<uint8_t> out;
+        _writeHeader(out);
+
+        _buffer.insert(_buffer.end(), plaintext.begin(), plaintext.end());
+        /* A full segment is only sealed once more data follows, as it could be the last one. */
+        size_t segmentSize = _cipher.getSegmentSize();
+        size_t offset = 0;
+        while (_buffer.size() - offset > segmentSize) {
+            _sealSegment(false, _buffer.data() + offset, segmentSize, out);
+            offset += segmentSize;
+        }
+        _buffer.erase(_buffer.begin(), _buffer.begin() + offset);
+        return out;
+    }
+
+    std::vector<uint8_t> finish()
+    {
+        _checkNotFinished();
+        std::vector<uint8_t> out;
+        _writeHeader(out);
+        _sealSegment(true, _buffer.data(), _buffer.size(), out);
+        utility::vectorCleanse(_buffer);
+        _buffer.clear();
+        _finished = true;
+        return out;
+    }
+
+private:
+    void _checkNotFinished() const
+    {
+        if (_finished) {
+            throw MoCOCrWException("AEAD stream was already finished.");
+        }
+    }
+
+    void _writeHeader(std::vector<uint8_t> &out)
+    {
+        if (!_headerWritten) {
+            out.insert(out.end(), _cipher.getHeader().begin(), _cipher.getHeader().end());
+            _headerWritten = true;
+        }
+    }
+
+    void _sealSegment(bool last, const uint8_t *in, size_t length, std::vector<uint8_t> &out)
+    {
+        size_t offset = out.size();
+        out.resize(offset + length + TagLength);
+        _cipher.seal(_nextSegment++, last, in, length, out.data() + offset);
+    }
+
+    SegmentCipher _cipher;
+    std::vector<uint8_t> _buffer;
+    uint64_t _nextSegment = 0;
+    bool _headerWritten = false;
+    bool _finished = false;
+};
+
+AEADStreamEncryptor::AEADStreamEncryptor(SymmetricCipherMode mode,
+                                         const std::vector<uint8_t> &masterKey,
+                                         size_t segmentSize)
+        : _impl{std::make_unique<Impl>(mode, masterKey, segmentSize)}
+{
+}
+
+AEADStreamEncryptor::~AEADStreamEncryptor() = default;
+
+std::vector<uint8_t> AEADStreamEncryptor::update(const std::vector<uint8_t> &plaintext)
+{
+    return _impl->update(plaintext);
+}
+
+std::vector<uint8_t> AEADStreamEncryptor::finish() { return _impl->finish(); }
+
+void AEADStreamEncryptor::encryptFile(SymmetricCipherMode mode,
+                                      const std::vector<uint8_t> &masterKey,
+                                      const std::string &inputFile,
+                                      const std::string &outputFile,
+                                      size_t segmentSize,
+                                      unsigned int numberOfThreads)
+{
+    SegmentCipher cipher{masterKey, createHeader(mode, segmentSize)};
+    auto inputLength = getFileSize(inputFile);
+    std::ifstream input(inputFile, std::ios::binary);
+
+    auto output = openOutputFile(outputFile);
+    removeOutputOnError(outputFile, [&]() {
+        output.write(reinterpret_cast<const char *>(cipher.getHeader().data()),
+                     cipher.getHeader().size());
+        runSegmentPipeline(input,
+                           inputFile,
+                           inputLength,
+                           cipher.getSegmentSize(),
+                           output,
+                           outputFile,
+                           cipher.getSealedSegmentSize(),
+                           numberOfThreads,
+                           [&](uint64_t index,
+                               bool last,
+                               const uint8_t *in,
+                               size_t length,
+                               uint8_t *out) { return cipher.seal(index, last, in, length, out); });
+        output.close();
+        if (output.fail()) {
+            throw MoCOCrWException("Error while writing file " + outputFile);
+        }
+    });
+}
+
+class AEADStreamDecryptor::Impl
+{
+public:
+    explicit Impl(const std::vector<uint8_t> &masterKey) : _masterKey{masterKey}
+    {
+        checkMasterKey(_masterKey);
+    }
+
+    ~Impl() { utility::vectorCleanse(_masterKey); }
+
+    std::vector<uint8_t> update(const std::vector<uint8_t> &ciphertext)
+    {
+        _checkNotFinished();
+        _buffer.insert(_buffer.end(), ciphertext.begin(), ciphertext.end());
+        std::vector<uint8_t> out;
+        if (!_readHeader()) {
+            return out;
+        }
+
+        /* Hold back the segment which could be the last one until more data arrives. */
+        size_t sealedSegmentSize = _cipher->getSealedSegmentSize();
+        size_t offset = 0;
+        while (_buffer.size() - offset > sealedSegmentSize) {
+            _openSegment(false, _buffer.data() + offset, sealedSegmentSize, out);
+            offset += sealedSegmentSize;
+        }
+        _buffer.erase(_buffer.begin(), _buffer.begin() + offset);
+        return out;
+    }
+
+    std::vector<uint8_t> finish()
+    {
+        _checkNotFinished();
+        if (!_readHeader()) {
+            throw MoCOCrWException("AEAD stream is too short to contain the header.");
+        }
+        std::vector<uint8_t> out;
+        _openSegment(true, _buffer.data(), _buffer.size(), out);
+        _buffer.clear();
+        _finished = true;
+        return out;
+    }
+
+private:
+    void _checkNotFinished() const
+    {
+        if (_finished) {
+            throw MoCOCrWException("AEAD stream was already finished.");
+        }
+    }
+
+    bool _readHeader()
+    {
+        if (_cipher) {
+            return true;
+        }
+        if (_buffer.size() < AEADStreamEncryptor::HeaderLength) {
+            return false;
+        }
+        auto headerEnd = _buffer.begin() + AEADStreamEncryptor::HeaderLength;
+        _cipher = std::make_unique<SegmentCipher>(_masterKey,
+                                                  std::vector<uint8_t>(_buffer.begin(), headerEnd));
+        _buffer.erase(_buffer.begin(), headerEnd);
+        return true;
+    }
+
+    void _openSegment(bool last, const uint8_t *in, size_t length, std::vector<uint8_t> &out)
+    {
+        size_t offset = out.size();
+        out.resize(offset + std::max(length, AEADStreamEncryptor::TagLength) -
+                   AEADStreamEncryptor::TagLength);
+        try {
+            _cipher->open(_nextSegment++, last, in, length, out.data() + offset);
+        } catch (const MoCOCrWException &) {
+            /* Don't release the plaintext of the segments which were already authenticated in
+             * this call either, the caller gets the exception only. */
+            utility::vectorCleanse(out);
+            _finished = true;
+            throw;
+        }
+    }
+
+    std::vector<uint8_t> _masterKey;
+    std::unique_ptr<SegmentCipher> _cipher;
+    std::vector<uint8_t> _buffer;
+    uint64_t _nextSegment = 0;
+    bool _finished = false;
+};
+
+AEADStreamDecryptor::AEADStreamDecryptor(const std::vector<uint8_t> &masterKey)
+        : _impl{std::make_unique<Impl>(masterKey)}
+{
+}
+
+AEADStreamDecryptor::~AEADStreamDecryptor() = default;
+
+std::vector<uint8_t> AEADStreamDecryptor::update(const std::vector<uint8_t> &ciphertext)
+{
+    return _impl->update(ciphertext);
+}
+
+std::vector<uint8_t> AEADStreamDecryptor::finish() { return _impl->finish(); }
+
+void AEADStreamDecryptor::decryptFile(const std::vector<uint8_t> &masterKey,
+                                      const std::string &inputFile,
+                                      const std::string &outputFile,
+                                      unsigned int numberOfThreads)
+{
+    checkMasterKey(masterKey);
+    auto fileSize = getFileSize(inputFile);
+    if (fileSize < AEADStreamEncryptor::HeaderLength + AEADStreamEncryptor::TagLength) {
+        throw MoCOCrWException("AEAD stream is truncated.");
+    }
+    std::ifstream input(inputFile, std::ios::binary);
+    std::vector<uint8_t> header(AEADStreamEncryptor::HeaderLength);
+    input.read(reinterpret_cast<char *>(header.data()), header.size());
+    if (static_cast<size_t>(input.gcount()) != header.size()) {
+        throw MoCOCrWException("Error while reading file " + inputFile);
+    }
+    SegmentCipher cipher{masterKey, std::move(header)};
+
+    auto output = openOutputFile(outputFile);
+    removeOutputOnError(outputFile, [&]() {
+        runSegmentPipeline(input,
+                           inputFile,
+                           fileSize - AEADStreamEncryptor::HeaderLength,
+                           cipher.getSealedSegmentSize(),
+                           output,
+                           outputFile,
+                           cipher.getSegmentSize(),
+                           numberOfThreads,
+                           [&](uint64_t index,
+                               bool last,
+                               const uint8_t *in,
+                               size_t length,
+                               uint8_t *out) { return cipher.open(index, last, in, length, out); });
+        output.close();
+        if (output.fail()) {
+            throw MoCOCrWException("Error while writing file " + outputFile);
+        }
+    });
+}
+
+}  // namespace mococrw
@@ -39,24 +39,27 @@ using SSL_SIGNATURE_DATA_Ptr = std::unique_ptr<unsigned char, SSLFree<unsigned c
 /*
  * Creates the digest of the given message using the specified hash function
  */
-std::vector<uint8_t> createHash(openssl::DigestTypes hashFunction,
-                                const std::vector<uint8_t> &message)
+std::vector<uint8_t> createHash(openssl::DigestTypes hashFunction, ByteView message)
 {
     switch (hashFunction) {
         case openssl::DigestTypes::SHA1:
-            return sha1(message);
+            return sha1(message.data(), message.size());
         case openssl::DigestTypes::SHA256:
-            return sha256(message);
+            return sha256(message.data(), message.size());
         case openssl::DigestTypes::SHA384:
-            return sha384(message);
+            return sha384(message.data(), message.size());
         case openssl::DigestTypes::SHA512:
-            return sha512(message);
+            return sha512(message.data(), message.size());
         case openssl::DigestTypes::SHA3_256:
-            return sha3_256(message);
+            return sha3_256(message.data(), message.size());
         case openssl::DigestTypes::SHA3_384:
-            return sha3_384(message);
+            return sha3_384(message.data(), message.size());
         case openssl::DigestTypes::SHA3_512:
-            return sha3_512(message);
+            return sha3_512(message.data(), message.size());
+        case openssl::DigestTypes::BLAKE2b_512:
+            return blake2b512(message.data(), message.size());
+        case openssl::DigestTypes::BLAKE2s_256:
+            return blake2s256(message.data(), message.size());
         default:
             throw MoCOCrWException("Unknown Hash Function");
     };
@@ -66,8 +69,7 @@ std::vector<uint8_t> createHash(openssl::DigestTypes hashFunction,
  * Performs the signature using the openssl EVP_PKEY_sign interface
  * (common for RSA and ECDSA signatures)
  */
-std::vector<uint8_t> signHelper(SSL_EVP_PKEY_CTX_Ptr &keyCtx,
-                                const std::vector<uint8_t> &toBeSigned)
+std::vector<uint8_t> signHelper(SSL_EVP_PKEY_CTX_Ptr &keyCtx, ByteView toBeSigned)
 {
     size_t sigLen;
     SSL_SIGNATURE_DATA_Ptr signatureData;
@@ -99,6 +101,49 @@ MessageSignatureCtx::~MessageSignatureCtx() = default;
 DigestVerificationCtx::~DigestVerificationCtx() = default;
 MessageVerificationCtx::~MessageVerificationCtx() = default;
 
+/*
+ * Default ByteView overloads for implementations outside of this library
+ */
+std::vector<uint8_t> DigestSignatureCtx::signDigest(ByteView messageDigest)
+{
+    return signDigest(messageDigest.toVector());
+}
+
+std::vector<uint8_t> MessageSignatureCtx::signMessage(ByteView message)
+{
+    return signMessage(message.toVector());
+}
+
+void DigestVerificationCtx::verifyDigest(ByteView signature, ByteView digest)
+{
+    verifyDigest(signature.toVector(), digest.toVector());
+}
+
+void MessageVerificationCtx::verifyMessage(ByteView signature, ByteView message)
+{
+    verifyMessage(signature.toVector(), message.toVector());
+}
+
+VerificationResult DigestVerificationCtx::tryVerifyDigest(ByteView signature, ByteView digest)
+{
+    try {
+        verifyDigest(signature, digest);
+    } catch (const MoCOCrWException &) {
+        return VerificationResult{VerificationStatus::Mismatch};
+    }
+    return VerificationResult::valid();
+}
+
+VerificationResult MessageVerificationCtx::tryVerifyMessage(ByteView signature, ByteView message)
+{
+    try {
+        verifyMessage(signature, message);
+    } catch (const MoCOCrWException &) {
+        return VerificationResult{VerificationStatus::Mismatch};
+    }
+    return VerificationResult::valid();
+}
+
 /*
  * ####################
  * #  RSA Encryption  #
@@ -174,7 +219,7 @@ public:
                               message.size());
 
         } catch (const OpenSSLException &e) {
-            throw MoCOCrWException(e.what());
+            throw MoCOCrWException(e);
         }
 
         return std::vector<uint8_t>(decryptedMessage.get(),
@@ -257,7 +302,7 @@ public:
                               message.size());
 
         } catch (const OpenSSLException &e) {
-            throw MoCOCrWException(e.what());
+            throw MoCOCrWException(e);
         }
 
         return std::vector<uint8_t>(encryptedMessage.get(),
@@ -330,7 +375,7 @@ class RSASignaturePrivateKeyCtx::Impl : public RSASignatureImpl<AsymmetricPrivat
     using RSASignatureImpl<AsymmetricPrivateKey>::RSASignatureImpl;
 
 public:
-    std::vector<uint8_t> signDigest(const std::vector<uint8_t> &messageDigest)
+    std::vector<uint8_t> signDigest(ByteView messageDigest)
     {
         size_t expectedDigestSize = Hash::getDigestSize(_hashFunction);
         if (messageDigest.size() != expectedDigestSize) {
@@ -346,11 +391,11 @@ public:
 
             return signHelper(keyCtx, messageDigest);
         } catch (const OpenSSLException &e) {
-            throw MoCOCrWException(e.what());
+            throw MoCOCrWException(e);
         }
     }
 
-    std::vector<uint8_t> signMessage(const std::vector<uint8_t> &message)
+    std::vector<uint8_t> signMessage(ByteView message)
     {
         return signDigest(createHash(_hashFunction, message));
     }
@@ -383,11 +428,21 @@ std::vector<uint8_t> RSASignaturePrivateKeyCtx::signDigest(
     return _impl->signDigest(messageDigest);
 }
 
+std::vector<uint8_t> RSASignaturePrivateKeyCtx::signDigest(ByteView messageDigest)
+{
+    return _impl->signDigest(messageDigest);
+}
+
 std::vector<uint8_t> RSASignaturePrivateKeyCtx::signMessage(const std::vector<uint8_t> &message)
 {
     return _impl->signMessage(message);
 }
 
+std::vector<uint8_t> RSASignaturePrivateKeyCtx::signMessage(ByteView message)
+{
+    return _impl->signMessage(message);
+}
+
 /*
  * PIMPL-Class for RSASignaturePublicKeyCtx
  */
@@ -395,8 +450,7 @@ class RSASignaturePublicKeyCtx::Impl : public RSASignatureImpl<AsymmetricPublicK
 {
 public:
     using RSASignatureImpl<AsymmetricPublicKey>::RSASignatureImpl;
-    void verifyDigest(const std::vector<uint8_t> &signature,
-                      const std::vector<uint8_t> &messageDigest)
+    void verifyDigest(ByteView signature, ByteView messageDigest)
     {
         size_t expectedDigestSize = Hash::getDigestSize(_hashFunction);
         if (messageDigest.size() != expectedDigestSize) {
@@ -405,28 +459,51 @@ public:
         }
 
         try {
-            auto keyCtx = _EVP_PKEY_CTX_new(_key.internal());
-            _EVP_PKEY_verify_init(keyCtx.get());
-
-            _padding->prepareOpenSSLContext(keyCtx, _hashFunction);
-
+            auto keyCtx = _createVerificationCtx();
             _EVP_PKEY_verify(keyCtx.get(),
                              reinterpret_cast<const unsigned char *>(signature.data()),
                              signature.size(),
                              reinterpret_cast<const unsigned char *>(messageDigest.data()),
                              messageDigest.size());
         } catch (const OpenSSLException &e) {
-            throw MoCOCrWException((boost::format{"Signature validation failed. "
-                                                  "OpenSSL info: %1%"} %
-                                    e.what())
-                                           .str());
+            throw MoCOCrWException(e, "Signature validation failed. OpenSSL info: ");
         }
     }
 
-    void verifyMessage(const std::vector<uint8_t> &signature, const std::vector<uint8_t> &message)
+    void verifyMessage(ByteView signature, ByteView message)
     {
         verifyDigest(signature, createHash(_hashFunction, message));
     }
+
+    VerificationResult tryVerifyDigest(ByteView signature, ByteView messageDigest)
+    {
+        if (messageDigest.size() != Hash::getDigestSize(_hashFunction)) {
+            return VerificationResult{VerificationStatus::InvalidLength};
+        }
+        auto keyCtx = _createVerificationCtx();
+        if (!_EVP_PKEY_tryVerify(keyCtx.get(),
+                                 signature.data(),
+                                 signature.size(),
+                                 messageDigest.data(),
+                                 messageDigest.size())) {
+            return VerificationResult{VerificationStatus::Mismatch};
+        }
+        return VerificationResult::valid();
+    }
+
+    VerificationResult tryVerifyMessage(ByteView signature, ByteView message)
+    {
+        return tryVerifyDigest(signature, createHash(_hashFunction, message));
+    }
+
+private:
+    SSL_EVP_PKEY_CTX_Ptr _createVerificationCtx()
+    {
+        auto keyCtx = _EVP_PKEY_CTX_new(_key.internal());
+        _EVP_PKEY_verify_init(keyCtx.get());
+        _padding->prepareOpenSSLContext(keyCtx, _hashFunction);
+        return keyCtx;
+    }
 };
 
 RSASignaturePublicKeyCtx::RSASignaturePublicKeyCtx(const AsymmetricPublicKey &key,
@@ -462,12 +539,33 @@ void RSASignaturePublicKeyCtx::verifyDigest(const std::vector<uint8_t> &signatur
     _impl->verifyDigest(signature, messageDigest);
 }
 
+void RSASignaturePublicKeyCtx::verifyDigest(ByteView signature, ByteView messageDigest)
+{
+    _impl->verifyDigest(signature, messageDigest);
+}
+
+VerificationResult RSASignaturePublicKeyCtx::tryVerifyDigest(ByteView signature,
+                                                             ByteView messageDigest)
+{
+    return _impl->tryVerifyDigest(signature, messageDigest);
+}
+
 void RSASignaturePublicKeyCtx::verifyMessage(const std::vector<uint8_t> &signature,
                                              const std::vector<uint8_t> &message)
 {
     _impl->verifyMessage(signature, message);
 }
 
+void RSASignaturePublicKeyCtx::verifyMessage(ByteView signature, ByteView message)
+{
+    _impl->verifyMessage(signature, message);
+}
+
+VerificationResult RSASignaturePublicKeyCtx::tryVerifyMessage(ByteView signature, ByteView message)
+{
+    return _impl->tryVerifyMessage(signature, message);
+}
+
 /* ###########
  * #  ECDSA  #
  * ###########
@@ -531,7 +629,7 @@ class ECDSASignaturePrivateKeyCtx::Impl : public ECDSAImpl<AsymmetricPrivateKey>
 public:
     using ECDSAImpl<AsymmetricPrivateKey>::ECDSAImpl;
 
-    std::vector<uint8_t> signDigest(const std::vector<uint8_t> &messageDigest)
+    std::vector<uint8_t> signDigest(ByteView messageDigest)
     {
         std::vector<uint8_t> signature = _signAsn1(messageDigest);
         if (_sigFormat == ECDSASignatureFormat::ASN1_SEQUENCE_OF_INTS) {
@@ -543,13 +641,13 @@ public:
         }
     }
 
-    std::vector<uint8_t> signMessage(const std::vector<uint8_t> &message)
+    std::vector<uint8_t> signMessage(ByteView message)
     {
         return signDigest(createHash(_hashFunction, message));
     }
 
 private:
-    std::vector<uint8_t> _signAsn1(const std::vector<uint8_t> &messageDigest)
+    std::vector<uint8_t> _signAsn1(ByteView messageDigest)
     {
         size_t expectedDigestSize = Hash::getDigestSize(_hashFunction);
         if (messageDigest.size() != expectedDigestSize) {
@@ -563,7 +661,7 @@ private:
 
             return signHelper(keyCtx, messageDigest);
         } catch (const OpenSSLException &e) {
-            throw MoCOCrWException(e.what());
+            throw MoCOCrWException(e);
         }
     }
 };
@@ -602,14 +700,24 @@ std::vector<uint8_t> ECDSASignaturePrivateKeyCtx::signDigest(
     return _impl->signDigest(messageDigest);
 }
 
+std::vector<uint8_t> ECDSASignaturePrivateKeyCtx::signDigest(ByteView messageDigest)
+{
+    return _impl->signDigest(messageDigest);
+}
+
 std::vector<uint8_t> ECDSASignaturePrivateKeyCtx::signMessage(const std::vector<uint8_t> &message)
 {
     return _impl->signMessage(message);
 }
 
+std::vector<uint8_t> ECDSASignaturePrivateKeyCtx::signMessage(ByteView message)
+{
+    return _impl->signMessage(message);
+}
+
 namespace
 {
-std::vector<uint8_t> _IEEE1363EcSignatureToAsn1ECSignature(const std::vector<uint8_t> &signature,
+std::vector<uint8_t> _IEEE1363EcSignatureToAsn1ECSignature(ByteView signature,
                                                            size_t keySizeBytes)
 {
     if (signature.size() != 2 * keySizeBytes) {
@@ -634,8 +742,7 @@ class ECDSASignaturePublicKeyCtx::Impl : public ECDSAImpl<AsymmetricPublicKey>
 public:
     using ECDSAImpl<AsymmetricPublicKey>::ECDSAImpl;
 
-    void verifyDigest(const std::vector<uint8_t> &signature,
-                      const std::vector<uint8_t> &messageDigest)
+    void verifyDigest(ByteView signature, ByteView messageDigest)
     {
         if (_sigFormat == ECDSASignatureFormat::IEEE1363) {
             size_t keySizeBytes = (_key.getKeySize() + 7) / 8;
@@ -648,14 +755,48 @@ public:
         }
     }
 
-    void verifyMessage(const std::vector<uint8_t> &signature, const std::vector<uint8_t> &message)
+    void verifyMessage(ByteView signature, ByteView message)
     {
         verifyDigest(signature, createHash(_hashFunction, message));
     }
 
+    VerificationResult tryVerifyDigest(ByteView signature, ByteView messageDigest)
+    {
+        if (messageDigest.size() != Hash::getDigestSize(_hashFunction)) {
+            return VerificationResult{VerificationStatus::InvalidLength};
+        }
+
+        std::vector<uint8_t> asn1Signature;
+        if (_sigFormat == ECDSASignatureFormat::IEEE1363) {
+            size_t keySizeBytes = (_key.getKeySize() + 7) / 8;
+            if (signature.size() != 2 * keySizeBytes) {
+                return VerificationResult{VerificationStatus::InvalidLength};
+            }
+            asn1Signature = _IEEE1363EcSignatureToAsn1ECSignature(signature, keySizeBytes);
+            signature = asn1Signature;
+        } else if (_sigFormat != ECDSASignatureFormat::ASN1_SEQUENCE_OF_INTS) {
+            throw MoCOCrWException("ECDSA Signature type not recognized.");
+        }
+
+        auto keyCtx = _EVP_PKEY_CTX_new(_key.internal());
+        _EVP_PKEY_verify_init(keyCtx.get());
+        if (!_EVP_PKEY_tryVerify(keyCtx.get(),
+                                 signature.data(),
+                                 signature.size(),
+                                 messageDigest.data(),
+                                 messageDigest.size())) {
+            return VerificationResult{VerificationStatus::Mismatch};
+        }
+        return VerificationResult::valid();
+    }
+
+    VerificationResult tryVerifyMessage(ByteView signature, ByteView message)
+    {
+        return tryVerifyDigest(signature, createHash(_hashFunction, message));
+    }
+
 private:
-    void _verifyAsn1(const std::vector<uint8_t> &signature,
-                     const std::vector<uint8_t> &messageDigest)
+    void _verifyAsn1(ByteView signature, ByteView messageDigest)
     {
         size_t expectedDigestSize = Hash::getDigestSize(_hashFunction);
         if (messageDigest.size() != expectedDigestSize) {
@@ -673,10 +814,7 @@ private:
                              reinterpret_cast<const unsigned char *>(messageDigest.data()),
                              messageDigest.size());
         } catch (const OpenSSLException &e) {
-            throw MoCOCrWException((boost::format{"Signature validation failed. "
-                                                  "OpenSSL info: %1%"} %
-                                    e.what())
-                                           .str());
+            throw MoCOCrWException(e, "Signature validation failed. OpenSSL info: ");
         }
     }
 };
@@ -743,12 +881,34 @@ void ECDSASignaturePublicKeyCtx::verifyDigest(const std::vector<uint8_t> &signat
     _impl->verifyDigest(signature, messageDigest);
 }
 
+void ECDSASignaturePublicKeyCtx::verifyDigest(ByteView signature, ByteView messageDigest)
+{
+    _impl->verifyDigest(signature, messageDigest);
+}
+
+VerificationResult ECDSASignaturePublicKeyCtx::tryVerifyDigest(ByteView signature,
+                                                               ByteView messageDigest)
+{
+    return _impl->tryVerifyDigest(signature, messageDigest);
+}
+
 void ECDSASignaturePublicKeyCtx::verifyMessage(const std::vector<uint8_t> &signature,
                                                const std::vector<uint8_t> &message)
 {
     _impl->verifyMessage(signature, message);
 }
 
+void ECDSASignaturePublicKeyCtx::verifyMessage(ByteView signature, ByteView message)
+{
+    _impl->verifyMessage(signature, message);
+}
+
+VerificationResult ECDSASignaturePublicKeyCtx::tryVerifyMessage(ByteView signature,
+                                                                ByteView message)
+{
+    return _impl->tryVerifyMessage(signature, message);
+}
+
 /* ###########
  * #  EdDSA  #
  * ###########
@@ -782,7 +942,7 @@ class EdDSASignaturePrivateKeyCtx::Impl : public EdDSAImpl<AsymmetricPrivateKey>
 {
 public:
     using EdDSAImpl<AsymmetricPrivateKey>::EdDSAImpl;
-    std::vector<uint8_t> signMessage(const std::vector<uint8_t> &message)
+    std::vector<uint8_t> signMessage(ByteView message)
     {
         std::vector<uint8_t> signature;
         try {
@@ -797,7 +957,7 @@ public:
             signature.resize(siglen);
             _EVP_DigestSign(mctx.get(), signature.data(), &siglen, message.data(), message.size());
         } catch (const OpenSSLException &e) {
-            throw MoCOCrWException(e.what());
+            throw MoCOCrWException(e);
         }
 
         return signature;
@@ -828,6 +988,11 @@ std::vector<uint8_t> EdDSASignaturePrivateKeyCtx::signMessage(const std::vector<
     return _impl->signMessage(message);
 }
 
+std::vector<uint8_t> EdDSASignaturePrivateKeyCtx::signMessage(ByteView message)
+{
+    return _impl->signMessage(message);
+}
+
 /*
  * PIMPL-Class for EdDSASignaturePublicKeyCtx
  */
@@ -835,7 +1000,7 @@ class EdDSASignaturePublicKeyCtx::Impl : public EdDSAImpl<AsymmetricPublicKey>
 {
 public:
     using EdDSAImpl<AsymmetricPublicKey>::EdDSAImpl;
-    void verifyMessage(const std::vector<uint8_t> &signature, const std::vector<uint8_t> &message)
+    void verifyMessage(ByteView signature, ByteView message)
     {
         try {
             auto mctx = _EVP_MD_CTX_create();
@@ -843,11 +1008,22 @@ public:
             _EVP_DigestVerify(
                     mctx.get(), signature.data(), signature.size(), message.data(), message.size());
         } catch (const OpenSSLException &e) {
-            throw MoCOCrWException((boost::format{"Signature validation failed. "
-                                                  "OpenSSL info: %1%"} %
-                                    e.what())
-                                           .str());
+            throw MoCOCrWException(e, "Signature validation failed. OpenSSL info: ");
+        }
+    }
+
+    VerificationResult tryVerifyMessage(ByteView signature, ByteView message)
+    {
+        auto mctx = _EVP_MD_CTX_create();
+        _EVP_DigestVerifyInit(mctx.get(), openssl::DigestTypes::NONE, _key.internal());
+        if (!_EVP_DigestTryVerify(mctx.get(),
+                                  signature.data(),
+                                  signature.size(),
+                                  message.data(),
+                                  message.size())) {
+            return VerificationResult{VerificationStatus::Mismatch};
         }
+        return VerificationResult::valid();
     }
 };
 
@@ -881,4 +1057,15 @@ void EdDSASignaturePublicKeyCtx::verifyMessage(const std::vector<uint8_t> &signa
     _impl->verifyMessage(signature, message);
 }
 
+void EdDSASignaturePublicKeyCtx::verifyMessage(ByteView signature, ByteView message)
+{
+    _impl->verifyMessage(signature, message);
+}
+
+VerificationResult EdDSASignaturePublicKeyCtx::tryVerifyMessage(ByteView signature,
+                                                                ByteView message)
+{
+    return _impl->tryVerifyMessage(signature, message);
+}
+
 }  // namespace mococrw
@@ -0,0 +1,432 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "mococrw/chunk_manifest.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <map>
+
+#include <boost/format.hpp>
+
+#include "mococrw/error.h"
+#include "mococrw/hash.h"
+#include "mococrw/private/parallel.h"
+
+namespace mococrw
+{
+using namespace openssl;
+
+const size_t ChunkManifest::DefaultChunkSize = 1024 * 1024;
+
+namespace
+{
+const std::vector<uint8_t> manifestMagic = {'M', 'C', 'R', 'W', 'M', 'N', 'F', 1};
+const size_t manifestHeaderSize = 8 /* magic */ + 1 /* digest */ + 8 /* chunk size */ +
+                                  8 /* total size */;
+
+const uint8_t leafPrefix = 0x00;
+const uint8_t nodePrefix = 0x01;
+
+/* The enum values of DigestTypes are not part of the format, so use stable identifiers. */
+const std::map<DigestTypes, uint8_t> digestIdentifiers = {{DigestTypes::SHA1, 1},
+                                                          {DigestTypes::SHA256, 2},
+                                                          {DigestTypes::SHA384, 3},
+                                                          {DigestTypes::SHA512, 4},
+                                                          {DigestTypes::SHA3_256, 5},
+                                                          {DigestTypes::SHA3_384, 6},
+                                                          {DigestTypes::SHA3_512, 7},
+                                                          {DigestTypes::BLAKE2b_512, 8},
+                                                          {DigestTypes::BLAKE2s_256, 9}};
+
+void checkDigestType(DigestTypes digestType)
+{
+    if (digestIdentifiers.find(digestType) == digestIdentifiers.end()) {
+        throw MoCOCrWException("Unsupported digest type for chunk manifest.");
+    }
+}
+
+DigestTypes digestTypeFromIdentifier(uint8_t identifier)
+{
+    for (const auto &entry : digestIdentifiers) {
+        if (entry.second == identifier) {
+            return entry.first;
+        }
+    }
+    throw MoCOCrWException("Chunk manifest uses an unknown digest type.");
+}
+
+size_t numberOfChunksFor(uint64_t totalSize, size_t chunkSize)
+{
+    if (totalSize == 0) {
+        return 1;
+    }
+    return static_cast<size_t>((totalSize - 1) / chunkSize + 1);
+}
+
+std::vector<uint8_t> hashLeaf(DigestTypes digestType, const uint8_t *data, size_t length)
+{
+    return Hash::fromDigestType(digestType).update(&leafPrefix, 1).update(data, length).digest();
+}
+
+std::vector<uint8_t> hashNode(DigestTypes digestType,
+                              const std::vector<uint8_t> &left,
+                              const std::vector<uint8_t> &right)
+{
+    return Hash::fromDigestType(digestType)
+            .update(&nodePrefix, 1)
+            .update(left)
+            .update(right)
+            .digest();
+}
+
+/* Returns all levels of the tree, starting with the leaves and ending with the root. */
+std::vector<std::vector<std::vector<uint8_t>>> buildTree(
+        DigestTypes digestType, const std::vector<std::vector<uint8_t>> &leaves)
+{
+    std::vector<std::vector<std::vector<uint8_t>>> levels{leaves};
+    while (levels.back().size() > 1) {
+        const auto &current = levels.back();
+        std::vector<std::vector<uint8_t>> next;
+        next.reserve((current.size() + 1) / 2);
+        for (size_t i = 0; i < current.size(); i += 2) {
+            if (i + 1 < current.size()) {
+                next.push_back(hashNode(digestType, current[i], current[i + 1]));
+            } else {
+                next.push_back(current[i]);
+            }
+        }
+        levels.push_back(std::move(next));
+    }
+    return levels;
+}
+
+void appendUint64(std::vector<uint8_t> &out, uint64_t value)
+{
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<uint8_t>(value >> shift));
+    }
+}
+
+uint64_t readUint64(const uint8_t *in)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+}  // namespace
+
+ChunkManifest::ChunkManifest(DigestTypes digestType,
+                             size_t chunkSize,
+                             uint64_t totalSize,
+                             std::vector<std::vector<uint8_t>> chunkHashes)
+        : _digestType(digestType)
+        , _chunkSize(chunkSize)
+        , _totalSize(totalSize)
+        , _chunkHashes(std::move(chunkHashes))
+{
+    _rootHash = buildTree(_digestType, _chunkHashes).back().front();
+}
+
+ChunkManifest ChunkManifest::fromBuffer(const uint8_t *data,
+                                        size_t length,
+                                        DigestTypes digestType,
+                                        size_t chunkSize,
+                                        unsigned int numberOfThreads)
+{
+    checkDigestType(digestType);
+    if (chunkSize == 0) {
+        throw MoCOCrWException("Chunk size must not be 0.");
+    }
+    if (data == nullptr && length > 0) {
+        throw MoCOCrWException("No data given for chunk manifest.");
+    }
+
+    auto numberOfChunks = numberOfChunksFor(length, chunkSize);
+    std::vector<std::vector<uint8_t>> chunkHashes(numberOfChunks);
+    detail::parallelFor(numberOfChunks, numberOfThreads, [&](size_t index) {
+        size_t offset = index * chunkSize;
+        chunkHashes[index] =
+                hashLeaf(digestType, data + offset, std::min(chunkSize, length - offset));
+    });
+
+    return ChunkManifest(digestType, chunkSize, length, std::move(chunkHashes));
+}
+
+ChunkManifest ChunkManifest::fromBuffer(const std::vector<uint8_t> &data,
+                                        DigestTypes digestType,
+                                        size_t chunkSize,
+                                        unsigned int numberOfThreads)
+{
+    return fromBuffer(data.data(), data.size(), digestType, chunkSize, numberOfThreads);
+}
+
+ChunkManifest ChunkManifest::fromFile(const std::string &filename,
+                                      DigestTypes digestType,
+                                      size_t chunkSize,
+                                      unsigned int numberOfThreads)
+{
+    checkDigestType(digestType);
+    if (chunkSize == 0) {
+        throw MoCOCrWException("Chunk size must not be 0.");
+    }
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.good()) {
+        throw MoCOCrWException("Could not open file " + filename);
+    }
+    uint64_t totalSize = static_cast<uint64_t>(file.tellg());
+    file.close();
+
+    auto numberOfChunks = numberOfChunksFor(totalSize, chunkSize);
+    std::vector<std::vector<uint8_t>> chunkHashes(numberOfChunks);
+    detail::parallelFor(numberOfChunks, numberOfThreads, [&](size_t index) {
+        uint64_t offset = static_cast<uint64_t>(index) * chunkSize;
+        auto length = static_cast<size_t>(std::min<uint64_t>(chunkSize, totalSize - offset));
+        std::vector<uint8_t> chunk(length);
+
+        std::ifstream chunkFile(filename, std::ios::binary);
+        chunkFile.seekg(offset);
+        chunkFile.read(reinterpret_cast<char *>(chunk.data()), length);
+        if (!chunkFile.good() || static_cast<size_t>(chunkFile.gcount()) != length) {
+            throw MoCOCrWException("Error while reading file " + filename);
+        }
+        chunkHashes[index] = hashLeaf(digestType, chunk.data(), chunk.size());
+    });
+
+    return ChunkManifest(digestType, chunkSize, totalSize, std::move(chunkHashes));
+}
+
+std::vector<uint8_t> ChunkManifest::getSignedData() const
+{
+    std::vector<uint8_t> header(manifestMagic);
+    header.reserve(manifestHeaderSize + _rootHash.size());
+    header.push_back(digestIdentifiers.at(_digestType));
+    appendUint64(header, _chunkSize);
+    appendUint64(header, _totalSize);
+    header.insert(header.end(), _rootHash.begin(), _rootHash.end());
+    return header;
+}
+
+std::vector<uint8_t> ChunkManifest::serialize() const
+{
+    auto serialized = getSignedData();
+    serialized.reserve(serialized.size() + _chunkHashes.size() * _rootHash.size());
+    for (const auto &chunkHash : _chunkHashes) {
+        serialized.insert(serialized.end(), chunkHash.begin(), chunkHash.end());
+    }
+    return serialized;
+}
+
+ChunkManifest ChunkManifest::deserialize(const std::vector<uint8_t> &serializedManifest)
+{
+    if (serializedManifest.size() < manifestHeaderSize ||
+        !std::equal(manifestMagic.begin(), manifestMagic.end(), serializedManifest.begin())) {
+        throw MoCOCrWException("Invalid chunk manifest header.");
+    }
+
+    const uint8_t *in = serializedManifest.data() + manifestMagic.size();
+    auto digestType = digestTypeFromIdentifier(in[0]);
+    uint64_t chunkSize = readUint64(in + 1);
+    uint64_t totalSize = readUint64(in + 9);
+    if (chunkSize == 0 || chunkSize > std::numeric_limits<size_t>::max()) {
+        throw MoCOCrWException("Invalid chunk size in chunk manifest.");
+    }
+
+    auto digestSize = Hash::getDigestSize(digestType);
+    uint64_t numberOfChunks = numberOfChunksFor(totalSize, chunkSize);
+    auto available = serializedManifest.size() - manifestHeaderSize;
+    if (available < digestSize) {
+        throw MoCOCrWException("Chunk manifest doesn't contain a root hash.");
+    }
+    /* Compare the number of chunk hashes instead of the number of all hashes, as
+     * numberOfChunks + 1 overflows for crafted sizes. */
+    if (available % digestSize != 0 || available / digestSize - 1 != numberOfChunks) {
+        throw MoCOCrWException(
+                (boost::format("Chunk manifest size mismatch: expected %d chunk hashes but got "
+                               "%d.") %
+                 numberOfChunks % (available / digestSize - 1))
+                        .str());
+    }
+
+    auto hashBegin = serializedManifest.begin() + manifestHeaderSize;
+    std::vector<uint8_t> rootHash(hashBegin, hashBegin + digestSize);
+    std::vector<std::vector<uint8_t>> chunkHashes(numberOfChunks);
+    for (size_t i = 0; i < numberOfChunks; i++) {
+        auto begin = hashBegin + (i + 1) * digestSize;
+        chunkHashes[i].assign(begin, begin + digestSize);
+    }
+
+    ChunkManifest manifest(digestType, chunkSize, totalSize, std::move(chunkHashes));
+    if (manifest._rootHash != rootHash) {
+        throw MoCOCrWException("Chunk hashes of the manifest don't match its root hash.");
+    }
+    return manifest;
+}
+
+std::vector<uint8_t> ChunkManifest::sign(MessageSignatureCtx &signatureCtx) const
+{
+    return signatureCtx.signMessage(getSignedData());
+}
+
+void ChunkManifest::verifySignature(MessageVerificationCtx &verificationCtx,
+                                    const std::vector<uint8_t> &signature) const
+{
+    verificationCtx.verifyMessage(signature, getSignedData());
+}
+
+const std::vector<uint8_t> &ChunkManifest::getChunkHash(size_t chunkIndex) const
+{
+    if (chunkIndex >= _chunkHashes.size()) {
+        throw MoCOCrWException(
+                (boost::format("Chunk index %d out of range (%d chunks).") % chunkIndex %
+                 _chunkHashes.size())
+                        .str());
+    }
+    return _chunkHashes[chunkIndex];
+}
+
+size_t ChunkManifest::getChunkIndex(uint64_t offset) const
+{
+    if (offset >= _totalSize) {
+        throw MoCOCrWException("Offset exceeds the size of the artifact.");
+    }
+    return static_cast<size_t>(offset / _chunkSize);
+}
+
+uint64_t ChunkManifest::getChunkOffset(size_t chunkIndex) const
+{
+    getChunkHash(chunkIndex);
+    return static_cast<uint64_t>(chunkIndex) * _chunkSize;
+}
+
+size_t ChunkManifest::getChunkLength(size_t chunkIndex) const
+{
+    auto offset = getChunkOffset(chunkIndex);
+    return static_cast<size_t>(std::min<uint64_t>(_chunkSize, _totalSize - offset));
+}
+
+void ChunkManifest::verifyChunk(size_t chunkIndex, const uint8_t *data, size_t length) const
+{
+    const auto &expected = getChunkHash(chunkIndex);
+    if (length != getChunkLength(chunkIndex)) {
+        throw MoCOCrWException(
+                (boost::format("Chunk %d has an invalid length: expected %d bytes but got %d.") %
+                 chunkIndex % getChunkLength(chunkIndex) % length)
+                        .str());
+    }
+    if (hashLeaf(_digestType, data, length) != expected) {
+        throw MoCOCrWException(
+                (boost::format("Verification of chunk %d failed.") % chunkIndex).str());
+    }
+}
+
+void ChunkManifest::verifyChunk(size_t chunkIndex, const std::vector<uint8_t> &data) const
+{
+    verifyChunk(chunkIndex, data.data(), data.size());
+}
+
+void ChunkManifest::verifyRange(uint64_t offset,
+                                const uint8_t *data,
+                                size_t length,
+                                unsigned int numberOfThreads) const
+{
+    if (offset % _chunkSize != 0) {
+        throw MoCOCrWException("Range to verify doesn't start at a chunk boundary.");
+    }
+    if (offset > _totalSize || length > _totalSize - offset) {
+        throw MoCOCrWException("Range to verify exceeds the size of the artifact.");
+    }
+    auto end = offset + length;
+    if (end % _chunkSize != 0 && end != _totalSize) {
+        throw MoCOCrWException("Range to verify doesn't end at a chunk boundary.");
+    }
+    if (length == 0 && _totalSize != 0) {
+        throw MoCOCrWException("Range to verify is empty.");
+    }
+
+    auto firstChunk = static_cast<size_t>(offset / _chunkSize);
+    auto rangeChunks = std::max<size_t>(1, numberOfChunksFor(length, _chunkSize));
+    detail::parallelFor(rangeChunks, numberOfThreads, [&](size_t i) {
+        size_t chunkOffset = i * _chunkSize;
+        verifyChunk(firstChunk + i,
+                    data + chunkOffset,
+                    std::min<size_t>(_chunkSize, length - chunkOffset));
+    });
+}
+
+std::vector<std::vector<uint8_t>> ChunkManifest::getInclusionProof(size_t chunkIndex) const
+{
+    getChunkHash(chunkIndex);
+
+    auto levels = buildTree(_digestType, _chunkHashes);
+    std::vector<std::vector<uint8_t>> proof;
+    auto index = chunkIndex;
+    for (size_t level = 0; level + 1 < levels.size(); level++) {
+        auto sibling = index ^ 1;
+        if (sibling < levels[level].size()) {
+            proof.push_back(levels[level][sibling]);
+        }
+        index /= 2;
+    }
+    return proof;
+}
+
+void ChunkManifest::verifyInclusion(const std::vector<uint8_t> &rootHash,
+                                    DigestTypes digestType,
+                                    size_t numberOfChunks,
+                                    size_t chunkIndex,
+                                    const uint8_t *data,
+                                    size_t length,
+                                    const std::vector<std::vector<uint8_t>> &proof)
+{
+    checkDigestType(digestType);
+    if (chunkIndex >= numberOfChunks) {
+        throw MoCOCrWException("Chunk index out of range.");
+    }
+
+    auto node = hashLeaf(digestType, data, length);
+    auto proofEntry = proof.begin();
+    auto index = chunkIndex;
+    for (auto levelSize = numberOfChunks; levelSize > 1; levelSize = (levelSize + 1) / 2) {
+        auto sibling = index ^ 1;
+        if (sibling < levelSize) {
+            if (proofEntry == proof.end()) {
+                throw MoCOCrWException("Inclusion proof is too short.");
+            }
+            node = (index & 1) ? hashNode(digestType, *proofEntry, node)
+                               : hashNode(digestType, node, *proofEntry);
+            ++proofEntry;
+        }
+        index /= 2;
+    }
+
+    if (proofEntry != proof.end()) {
+        throw MoCOCrWException("Inclusion proof is too long.");
+    }
+    if (node != rootHash) {
+        throw MoCOCrWException(
+                (boost::format("Chunk %d is not part of the manifest.") % chunkIndex).str());
+    }
+}
+
+}  // namespace mococrw
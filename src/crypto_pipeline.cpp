@@ -0,0 +1,178 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "mococrw/crypto_pipeline.h"
+
+#include <algorithm>
+
+#include "mococrw/error.h"
+
+namespace mococrw
+{
+using namespace openssl;
+
+/* Small enough that a chunk of input and output stays in the L1/L2 cache while it is passed
+ * through all parts of the stage. */
+const size_t CipherDigestStage::ChunkSize = 16 * 1024;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+template <class Func>
+void measure(CipherDigestStage::Throughput &throughput, size_t bytes, Func &&func)
+{
+    auto start = Clock::now();
+    func();
+    throughput.time += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+    throughput.bytes += bytes;
+}
+
+template <class Digests>
+auto findDigest(Digests &digests, DigestTypes digestType, CipherDigestStage::Tap tap)
+        -> decltype(digests.front())
+{
+    for (auto &digest : digests) {
+        if (digest.digestType == digestType && digest.tap == tap) {
+            return digest;
+        }
+    }
+    throw MoCOCrWException("Digest was not added to the stage.");
+}
+}  // namespace
+
+double CipherDigestStage::Throughput::bytesPerSecond() const
+{
+    if (time.count() == 0) {
+        return 0;
+    }
+    return static_cast<double>(bytes) / std::chrono::duration<double>(time).count();
+}
+
+CipherDigestStage::CipherDigestStage(AESCipher &cipher) : _cipher(cipher) {}
+
+CipherDigestStage &CipherDigestStage::addDigest(DigestTypes digestType, Tap tap)
+{
+    _checkConfigurable();
+    for (const auto &digest : _digests) {
+        if (digest.digestType == digestType && digest.tap == tap) {
+            throw MoCOCrWException("Digest was already added to the stage.");
+        }
+    }
+    _digests.push_back(DigestTap{digestType, tap, Hash::fromDigestType(digestType), {}});
+    return *this;
+}
+
+CipherDigestStage &CipherDigestStage::setMAC(MessageAuthenticationCode &mac, Tap tap)
+{
+    _checkConfigurable();
+    if (_mac) {
+        throw MoCOCrWException("A MAC was already set for the stage.");
+    }
+    _mac = &mac;
+    _macTap = tap;
+    return *this;
+}
+
+size_t CipherDigestStage::update(const uint8_t *in, size_t length, uint8_t *out, size_t outCapacity)
+{
+    if (_finished) {
+        throw MoCOCrWException("Stage was already finished.");
+    }
+    if (outCapacity < _cipher.getMaxUpdateOutputLength(length)) {
+        throw MoCOCrWException("Output buffer is too small.");
+    }
+    _started = true;
+
+    size_t written = 0;
+    for (size_t offset = 0; offset < length; offset += ChunkSize) {
+        size_t chunkLength = std::min(ChunkSize, length - offset);
+        /* The input taps run first, so in-place operation doesn't hand them cipher output. */
+        _feedTaps(Tap::Input, in + offset, chunkLength);
+
+        size_t chunkWritten = 0;
+        measure(_cipherThroughput, chunkLength, [&]() {
+            chunkWritten =
+                    _cipher.update(in + offset, chunkLength, out + written, outCapacity - written);
+        });
+
+        _feedTaps(Tap::Output, out + written, chunkWritten);
+        written += chunkWritten;
+    }
+    return written;
+}
+
+size_t CipherDigestStage::finish(uint8_t *out, size_t outCapacity)
+{
+    if (_finished) {
+        throw MoCOCrWException("Stage was already finished.");
+    }
+    size_t written = 0;
+    measure(_cipherThroughput, 0, [&]() { written = _cipher.finish(out, outCapacity); });
+    _feedTaps(Tap::Output, out, written);
+    _started = true;
+    _finished = true;
+    return written;
+}
+
+std::vector<uint8_t> CipherDigestStage::digest(DigestTypes digestType, Tap tap)
+{
+    auto &digest = findDigest(_digests, digestType, tap);
+    if (!_finished) {
+        throw MoCOCrWException("Stage must be finished before retrieving a digest.");
+    }
+    return digest.hash.digest();
+}
+
+const CipherDigestStage::Throughput &CipherDigestStage::getDigestThroughput(DigestTypes digestType,
+                                                                            Tap tap) const
+{
+    return findDigest(_digests, digestType, tap).throughput;
+}
+
+const CipherDigestStage::Throughput &CipherDigestStage::getMACThroughput() const
+{
+    if (!_mac) {
+        throw MoCOCrWException("No MAC was set for the stage.");
+    }
+    return _macThroughput;
+}
+
+void CipherDigestStage::_checkConfigurable() const
+{
+    if (_started) {
+        throw MoCOCrWException("Stage can't be changed after data was processed.");
+    }
+}
+
+void CipherDigestStage::_feedTaps(Tap tap, const uint8_t *data, size_t length)
+{
+    if (length == 0) {
+        return;
+    }
+    for (auto &digest : _digests) {
+        if (digest.tap == tap) {
+            measure(digest.throughput, length, [&]() { digest.hash.update(data, length); });
+        }
+    }
+    if (_mac && _macTap == tap) {
+        measure(_macThroughput, length, [&]() { _mac->update(ByteView{data, length}); });
+    }
+}
+
+}  // namespace mococrw
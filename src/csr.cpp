@@ -69,7 +69,7 @@ void CertificateSigningRequest::verify() const
     try {
         _X509_REQ_verify(_req.get(), pubkey.get());
     } catch (const OpenSSLException &error) {
-        throw MoCOCrWException(error.what());
+        throw MoCOCrWException(error);
     }
 }
 
@@ -186,6 +186,7 @@ protected:
 
         /* initialize the de/encryptor */
         _symmetricCipher = _symCipherFactoryFunc(_key_encrypt);
+        _authenticatedCipher = dynamic_cast<AuthenticatedEncryptionI *>(_symmetricCipher.get());
     }
 
     const std::shared_ptr<KeyDerivationFunction> _kdf;
@@ -200,6 +201,9 @@ protected:
     const std::vector<uint8_t> _macSalt;
 
     std::unique_ptr<SymmetricCipherI> _symmetricCipher;
+    /* Set if the symmetric cipher is an authenticated cipher. Its tag is appended to the
+     * ciphertext. */
+    AuthenticatedEncryptionI *_authenticatedCipher = nullptr;
     std::vector<uint8_t> _macValue;
     bool _isFinished = false;
 };
@@ -215,7 +219,7 @@ public:
 
     ~Impl(){};
 
-    void update(const std::vector<uint8_t> &message)
+    void update(ByteView message)
     {
         if (!_symmetricCipher) {
             throw MoCOCrWException("Encryption context is not initialized.");
@@ -237,6 +241,18 @@ public:
         std::vector<uint8_t> result;
 
         result = _symmetricCipher->finish();
+        if (_authenticatedCipher) {
+            auto authTag = _authenticatedCipher->getAuthTag();
+            /* The decryptor splits the tag off the ciphertext by its length. */
+            if (authTag.size() != AESKey::DefaultAuthTagLength) {
+                auto formatter = boost::format(
+                        "Authentication tag of the symmetric cipher has %d bytes. Must be %d "
+                        "bytes.");
+                formatter % authTag.size() % AESKey::DefaultAuthTagLength;
+                throw MoCOCrWException(formatter.str());
+            }
+            result.insert(result.end(), authTag.begin(), authTag.end());
+        }
         /* IEEE 1363a requires that the MAC is computed over the ciphertext */
         _mac->update(result);
 
@@ -287,19 +303,77 @@ public:
         setEphemeralKey(ctxBuilder._impl->_ephemeralKey);
     }
 
-    void update(const std::vector<uint8_t> &message)
+    void update(ByteView message)
     {
         if (_isFinished) {
             throw MoCOCrWException("update() is invoked after finish was invoked.");
         }
 
-        _symmetricCipher->update(message);
+        if (_authenticatedCipher) {
+            /* The last bytes of the ciphertext are the tag of the authenticated cipher. Hold
+             * them back until the end of the ciphertext is known. */
+            _heldBackCiphertext.insert(_heldBackCiphertext.end(), message.begin(), message.end());
+            if (_heldBackCiphertext.size() > AESKey::DefaultAuthTagLength) {
+                size_t releasable = _heldBackCiphertext.size() - AESKey::DefaultAuthTagLength;
+                _symmetricCipher->update(ByteView{_heldBackCiphertext.data(), releasable});
+                _heldBackCiphertext.erase(_heldBackCiphertext.begin(),
+                                          _heldBackCiphertext.begin() + releasable);
+            }
+        } else {
+            _symmetricCipher->update(message);
+        }
 
         /* also set the ciphertext for mac calculation */
         _mac->update(message);
     }
 
     std::vector<uint8_t> finish()
+    {
+        _calculateMac();
+        _mac->verify(_tag);
+        return _finishDecryption();
+    }
+
+    VerificationResult tryFinish(std::vector<uint8_t> &plaintext)
+    {
+        _calculateMac();
+        auto result = _mac->tryVerify(_tag);
+        if (!result) {
+            _isFinished = true;
+            return result;
+        }
+
+        if (_authenticatedCipher && _heldBackCiphertext.size() != AESKey::DefaultAuthTagLength) {
+            _isFinished = true;
+            return VerificationResult{VerificationStatus::InvalidLength};
+        }
+
+        /* The MAC is valid, so a failure of the authenticated cipher is unexpected. It is still
+         * reported by the status rather than by an exception. */
+        try {
+            plaintext = _finishDecryption();
+        } catch (const MoCOCrWException &) {
+            _isFinished = true;
+            return VerificationResult{VerificationStatus::Mismatch};
+        }
+        return result;
+    }
+
+    void setEphemeralKey(const AsymmetricPublicKey &ephKey)
+    {
+        /* calculate the keys for encryption and MAC */
+        auto sharedSecret = openssl::_EVP_derive_key(ephKey.internal(), _privKey.internal());
+        createKeysAndInstantiateMacAndSymCipher(std::move(sharedSecret));
+    }
+
+    void setMAC(const std::vector<uint8_t> &tag)
+    {
+        _tag = tag;
+        _macIsSet = true;
+    }
+
+private:
+    void _calculateMac()
     {
         if (_isFinished) {
             throw MoCOCrWException("finish() is invoked twice.");
@@ -313,7 +387,17 @@ public:
         _mac->update(_macSalt);
         /* We don't care for the result as we invoke verify */
         _mac->finish();
-        _mac->verify(_tag);
+    }
+
+    std::vector<uint8_t> _finishDecryption()
+    {
+        if (_authenticatedCipher) {
+            if (_heldBackCiphertext.size() != AESKey::DefaultAuthTagLength) {
+                throw MoCOCrWException(
+                        "Ciphertext is too short to contain the authentication tag.");
+            }
+            _authenticatedCipher->setAuthTag(_heldBackCiphertext);
+        }
 
         std::vector<uint8_t> result;
 
@@ -325,23 +409,10 @@ public:
         return result;
     }
 
-    void setEphemeralKey(const AsymmetricPublicKey &ephKey)
-    {
-        /* calculate the keys for encryption and MAC */
-        auto sharedSecret = openssl::_EVP_derive_key(ephKey.internal(), _privKey.internal());
-        createKeysAndInstantiateMacAndSymCipher(std::move(sharedSecret));
-    }
-
-    void setMAC(const std::vector<uint8_t> &tag)
-    {
-        _tag = tag;
-        _macIsSet = true;
-    }
-
-private:
     AsymmetricPrivateKey _privKey;
     std::vector<uint8_t> _tag;
     bool _macIsSet = false;
+    std::vector<uint8_t> _heldBackCiphertext;
 };
 
 ECIESEncryptionCtx::ECIESEncryptionCtx(const ECIESCtxBuilder &ctxBuilder)
@@ -353,6 +424,8 @@ ECIESEncryptionCtx::~ECIESEncryptionCtx() = default;
 
 void ECIESEncryptionCtx::update(const std::vector<uint8_t> &message) { _impl->update(message); }
 
+void ECIESEncryptionCtx::update(ByteView message) { _impl->update(message); }
+
 std::vector<uint8_t> ECIESEncryptionCtx::finish() { return _impl->finish(); }
 
 AsymmetricPublicKey ECIESEncryptionCtx::getEphemeralKey() { return _impl->getEphemeralKey(); }
@@ -368,8 +441,15 @@ ECIESDecryptionCtx::~ECIESDecryptionCtx() = default;
 
 void ECIESDecryptionCtx::update(const std::vector<uint8_t> &message) { _impl->update(message); }
 
+void ECIESDecryptionCtx::update(ByteView message) { _impl->update(message); }
+
 std::vector<uint8_t> ECIESDecryptionCtx::finish() { return _impl->finish(); }
 
+VerificationResult ECIESDecryptionCtx::tryFinish(std::vector<uint8_t> &plaintext)
+{
+    return _impl->tryFinish(plaintext);
+}
+
 void ECIESDecryptionCtx::setMAC(const std::vector<uint8_t> &tag) { _impl->setMAC(tag); }
 
 ECIESCtxBuilder::ECIESCtxBuilder() { _impl = std::make_unique<ECIESCtxBuilder::Impl>(); }
@@ -17,6 +17,11 @@
  * #L%
  */
 #include "mococrw/hash.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
 #include "mococrw/error.h"
 #include "mococrw/util.h"
 
@@ -134,6 +139,88 @@ std::vector<uint8_t> sha3_512(const std::vector<uint8_t> &message)
     return Hash::sha3_512().update(message).digest();
 }
 
+std::vector<uint8_t> blake2b512(const uint8_t *message, size_t length)
+{
+    return Hash::blake2b512().update(message, length).digest();
+}
+
+std::vector<uint8_t> blake2b512(const std::string &message)
+{
+    return Hash::blake2b512().update(message).digest();
+}
+
+std::vector<uint8_t> blake2b512(const std::vector<uint8_t> &message)
+{
+    return Hash::blake2b512().update(message).digest();
+}
+
+std::vector<uint8_t> blake2s256(const uint8_t *message, size_t length)
+{
+    return Hash::blake2s256().update(message, length).digest();
+}
+
+std::vector<uint8_t> blake2s256(const std::string &message)
+{
+    return Hash::blake2s256().update(message).digest();
+}
+
+std::vector<uint8_t> blake2s256(const std::vector<uint8_t> &message)
+{
+    return Hash::blake2s256().update(message).digest();
+}
+
+namespace
+{
+/* A single output call isn't subject to Shake::MaxOutputLength. */
+std::vector<uint8_t> xofOneShot(XofTypes xofType,
+                                const uint8_t *message,
+                                size_t length,
+                                size_t outputLength)
+{
+    auto ctx = _EVP_MD_CTX_create();
+    _EVP_MD_CTX_init(ctx.get());
+    _EVP_DigestInit_ex(ctx.get(), _getMDPtrFromXofType(xofType), NULL);
+    _EVP_DigestUpdate(ctx.get(), message, length);
+    std::vector<uint8_t> output(outputLength);
+    if (outputLength > 0) {
+        _EVP_DigestFinalXOF(ctx.get(), output.data(), output.size());
+    }
+    return output;
+}
+}  // namespace
+
+std::vector<uint8_t> shake128(const uint8_t *message, size_t length, size_t outputLength)
+{
+    return xofOneShot(XofTypes::SHAKE128, message, length, outputLength);
+}
+
+std::vector<uint8_t> shake128(const std::string &message, size_t outputLength)
+{
+    return shake128(
+            reinterpret_cast<const uint8_t *>(message.data()), message.size(), outputLength);
+}
+
+std::vector<uint8_t> shake128(const std::vector<uint8_t> &message, size_t outputLength)
+{
+    return shake128(message.data(), message.size(), outputLength);
+}
+
+std::vector<uint8_t> shake256(const uint8_t *message, size_t length, size_t outputLength)
+{
+    return xofOneShot(XofTypes::SHAKE256, message, length, outputLength);
+}
+
+std::vector<uint8_t> shake256(const std::string &message, size_t outputLength)
+{
+    return shake256(
+            reinterpret_cast<const uint8_t *>(message.data()), message.size(), outputLength);
+}
+
+std::vector<uint8_t> shake256(const std::vector<uint8_t> &message, size_t outputLength)
+{
+    return shake256(message.data(), message.size(), outputLength);
+}
+
 size_t Hash::getDigestSize(openssl::DigestTypes digestType)
 {
     return Hash::lengthInBytes.at(digestType);
@@ -147,7 +234,9 @@ const std::map<DigestTypes, size_t> Hash::lengthInBytes = {{DigestTypes::SHA1, 1
                                                            {DigestTypes::SHA512, 512 / 8},
                                                            {DigestTypes::SHA3_256, 256 / 8},
                                                            {DigestTypes::SHA3_384, 384 / 8},
-                                                           {DigestTypes::SHA3_512, 512 / 8}};
+                                                           {DigestTypes::SHA3_512, 512 / 8},
+                                                           {DigestTypes::BLAKE2b_512, 512 / 8},
+                                                           {DigestTypes::BLAKE2s_256, 256 / 8}};
 
 Hash::Hash(const DigestTypes digestType) : _digestType(digestType)
 {
@@ -171,6 +260,10 @@ Hash Hash::sha3_384() { return Hash{DigestTypes::SHA3_384}; }
 
 Hash Hash::sha3_512() { return Hash{DigestTypes::SHA3_512}; }
 
+Hash Hash::blake2b512() { return Hash{DigestTypes::BLAKE2b_512}; }
+
+Hash Hash::blake2s256() { return Hash{DigestTypes::BLAKE2s_256}; }
+
 std::vector<uint8_t> Hash::digest()
 {
     if (_finalDigestValue.empty()) {
@@ -196,4 +289,172 @@ Hash &Hash::update(const uint8_t *chunk, size_t length)
     return *this;
 }
 
+#if OPENSSL_VERSION_NUMBER >= 0x30300000L
+const size_t Shake::MaxOutputLength = std::numeric_limits<size_t>::max();
+#else
+/* Bounds the memory and the repeated generation of the output stream of older OpenSSL versions,
+ * which can't squeeze incrementally. */
+const size_t Shake::MaxOutputLength = 16 * 1024 * 1024;
+#endif
+
+Shake::Shake(const XofTypes xofType) : _xofType(xofType)
+{
+    const EVP_MD *xofFn = _getMDPtrFromXofType(xofType);
+    _absorbCtx = _EVP_MD_CTX_create();
+    _EVP_MD_CTX_init(_absorbCtx.get());
+    _EVP_DigestInit_ex(_absorbCtx.get(), xofFn, NULL);
+}
+
+Shake Shake::shake128() { return Shake{XofTypes::SHAKE128}; }
+
+Shake Shake::shake256() { return Shake{XofTypes::SHAKE256}; }
+
+Shake Shake::fromXofType(const XofTypes xofType) { return Shake{xofType}; }
+
+Shake &Shake::update(const std::string &chunk)
+{
+    return update(reinterpret_cast<const uint8_t *>(chunk.c_str()), chunk.length());
+}
+
+Shake &Shake::update(const std::vector<uint8_t> &chunk)
+{
+    return update(chunk.data(), chunk.size());
+}
+
+Shake &Shake::update(const uint8_t *chunk, size_t length)
+{
+    if (_isSqueezing) {
+        throw MoCOCrWException("update method cannot be called after squeeze was called");
+    }
+    _EVP_DigestUpdate(_absorbCtx.get(), chunk, length);
+    return *this;
+}
+
+std::vector<uint8_t> Shake::squeeze(size_t length)
+{
+    std::vector<uint8_t> output(length);
+    squeeze(output.data(), output.size());
+    return output;
+}
+
+void Shake::squeeze(uint8_t *output, size_t length)
+{
+    if (length > MaxOutputLength - _squeezedLength) {
+        throw MoCOCrWException("The maximum output length of the XOF was exceeded.");
+    }
+    _isSqueezing = true;
+    if (length == 0) {
+        return;
+    }
+#if OPENSSL_VERSION_NUMBER >= 0x30300000L
+    _EVP_DigestSqueeze(_absorbCtx.get(), output, length);
+#else
+    if (_outputOffset + length > _output.size()) {
+        _generateOutput(_squeezedLength + length);
+    }
+    std::copy_n(_output.begin() + _outputOffset, length, output);
+    _outputOffset += length;
+#endif
+    _squeezedLength += length;
+}
+
+void Shake::_generateOutput(size_t minimumLength)
+{
+    /* The output of an XOF of length n is a prefix of its output of any length m > n. Hence,
+     * finalizing a copy of the absorbing context yields the already squeezed output followed by
+     * new output. Doubling the length keeps the total amount of generated output linear. */
+    const size_t keccakRate = (_xofType == XofTypes::SHAKE128) ? 168 : 136;
+    size_t newLength = std::min(std::max({minimumLength, 2 * _generatedLength, keccakRate}),
+                                MaxOutputLength);
+
+    auto squeezeCtx = _EVP_MD_CTX_create();
+    _EVP_MD_CTX_copy_ex(squeezeCtx.get(), _absorbCtx.get());
+    std::vector<uint8_t> output(newLength);
+    _EVP_DigestFinalXOF(squeezeCtx.get(), output.data(), output.size());
+    // Drop the prefix which was already squeezed.
+    _output.assign(output.begin() + _squeezedLength, output.end());
+    _outputOffset = 0;
+    _generatedLength = newLength;
+}
+
+/* Small enough to stay in the L1/L2 cache while all digest contexts consume it. */
+const size_t MultiHash::ChunkSize = 16 * 1024;
+
+MultiHash::MultiHash(const std::set<DigestTypes> &digestTypes)
+{
+    if (digestTypes.empty()) {
+        throw MoCOCrWException("At least one digest type has to be given for MultiHash.");
+    }
+    _hashes.reserve(digestTypes.size());
+    for (auto digestType : digestTypes) {
+        if (digestType == DigestTypes::NONE) {
+            throw MoCOCrWException("DigestTypes::NONE is not supported by MultiHash.");
+        }
+        _hashes.emplace_back(digestType, Hash::fromDigestType(digestType));
+    }
+}
+
+MultiHash &MultiHash::update(const std::string &chunk)
+{
+    return update(reinterpret_cast<const uint8_t *>(chunk.c_str()), chunk.length());
+}
+
+MultiHash &MultiHash::update(const std::vector<uint8_t> &chunk)
+{
+    return update(chunk.data(), chunk.size());
+}
+
+MultiHash &MultiHash::update(const uint8_t *chunk, size_t length)
+{
+    size_t offset = 0;
+    while (offset < length) {
+        size_t chunkLength = std::min(ChunkSize, length - offset);
+        for (auto &hash : _hashes) {
+            hash.second.update(chunk + offset, chunkLength);
+        }
+        offset += chunkLength;
+    }
+    return *this;
+}
+
+MultiHash &MultiHash::updateFromFile(const std::string &filename)
+{
+    std::ifstream file{filename, std::ios::binary};
+    if (!file.good()) {
+        throw MoCOCrWException("Cannot open file " + filename);
+    }
+
+    std::vector<uint8_t> buffer(ChunkSize);
+    while (file) {
+        file.read(reinterpret_cast<char *>(buffer.data()), buffer.size());
+        if (file.bad()) {
+            throw MoCOCrWException("Error while reading file " + filename);
+        }
+        if (file.gcount() > 0) {
+            update(buffer.data(), file.gcount());
+        }
+    }
+    return *this;
+}
+
+std::map<DigestTypes, std::vector<uint8_t>> MultiHash::digest()
+{
+    std::map<DigestTypes, std::vector<uint8_t>> digests;
+    for (auto &hash : _hashes) {
+        digests.emplace(hash.first, hash.second.digest());
+    }
+    return digests;
+}
+
+std::vector<uint8_t> MultiHash::digest(DigestTypes digestType)
+{
+    auto hash = std::find_if(_hashes.begin(), _hashes.end(), [digestType](const auto &entry) {
+        return entry.first == digestType;
+    });
+    if (hash == _hashes.end()) {
+        throw MoCOCrWException("The requested digest type was not computed by this MultiHash.");
+    }
+    return hash->second.digest();
+}
+
 }  // namespace mococrw
@@ -23,6 +23,13 @@ namespace mococrw
 {
 KeyDerivationFunction::~KeyDerivationFunction() = default;
 
+std::vector<uint8_t> KeyDerivationFunction::deriveKey(ByteView password,
+                                                      const size_t outputLength,
+                                                      ByteView salt)
+{
+    return deriveKey(password.toVector(), outputLength, salt.toVector());
+}
+
 class PBKDF2::Impl
 {
 public:
@@ -33,13 +40,17 @@ public:
 
     ~Impl() = default;
 
-    std::vector<uint8_t> deriveKey(const std::vector<uint8_t>& password,
-                                   const size_t outputLength,
-                                   const std::vector<uint8_t>& salt)
+    std::vector<uint8_t> deriveKey(ByteView password, const size_t outputLength, ByteView salt)
     {
         std::vector<uint8_t> derivedKey(outputLength);
         const EVP_MD* digestFn = openssl::_getMDPtrFromDigestType(_hashFunction);
-        openssl::_PKCS5_PBKDF2_HMAC(password, salt, _iterations, digestFn, derivedKey);
+        openssl::_PKCS5_PBKDF2_HMAC(password.data(),
+                                    password.size(),
+                                    salt.data(),
+                                    salt.size(),
+                                    _iterations,
+                                    digestFn,
+                                    derivedKey);
 
         return derivedKey;
     }
@@ -63,6 +74,11 @@ std::vector<uint8_t> PBKDF2::deriveKey(const std::vector<uint8_t>& password,
     return _impl->deriveKey(password, outputLength, salt);
 }
 
+std::vector<uint8_t> PBKDF2::deriveKey(ByteView password, const size_t outputLength, ByteView salt)
+{
+    return _impl->deriveKey(password, outputLength, salt);
+}
+
 PBKDF2::PBKDF2(PBKDF2&& other) = default;
 
 PBKDF2& PBKDF2::operator=(PBKDF2&& other)
@@ -86,13 +102,16 @@ public:
 
     ~Impl() = default;
 
-    std::vector<uint8_t> deriveKey(const std::vector<uint8_t>& password,
-                                   const size_t outputLength,
-                                   const std::vector<uint8_t>& salt)
+    std::vector<uint8_t> deriveKey(ByteView password, const size_t outputLength, ByteView salt)
     {
         std::vector<uint8_t> derivedKey(outputLength);
         const EVP_MD* digestFn = openssl::_getMDPtrFromDigestType(_hashFunction);
-        openssl::_ECDH_KDF_X9_63(derivedKey, password, salt, digestFn);
+        openssl::_ECDH_KDF_X9_63(derivedKey,
+                                 password.data(),
+                                 password.size(),
+                                 salt.data(),
+                                 salt.size(),
+                                 digestFn);
         return derivedKey;
     }
 
@@ -114,6 +133,11 @@ std::vector<uint8_t> X963KDF::deriveKey(const std::vector<uint8_t>& password,
     return _impl->deriveKey(password, outputLength, salt);
 }
 
+std::vector<uint8_t> X963KDF::deriveKey(ByteView password, const size_t outputLength, ByteView salt)
+{
+    return _impl->deriveKey(password, outputLength, salt);
+}
+
 X963KDF::X963KDF(X963KDF&& other) = default;
 
 X963KDF::X963KDF(const X963KDF& other) : _impl(std::make_unique<X963KDF::Impl>(*other._impl)) {}
@@ -229,7 +229,7 @@ AsymmetricKey ECCSpec::generate() const
         pkey = _EVP_PKEY_keygen(keyCtx.get());
 
     } catch (const OpenSSLException &e) {
-        throw MoCOCrWException(e.what());
+        throw MoCOCrWException(e);
     }
     return AsymmetricKey{std::move(pkey)};
 }
@@ -254,7 +254,7 @@ std::unique_ptr<AsymmetricKey::Spec> AsymmetricKey::getKeySpec() const
                 throw MoCOCrWException("Key type not supported.");
         }
     } catch (const OpenSSLException &e) {
-        throw MoCOCrWException(e.what());
+        throw MoCOCrWException(e);
     }
 }
 }  // namespace mococrw
@@ -20,8 +20,12 @@
 #include "mococrw/mac.h"
 #include "mococrw/error.h"
 #include "mococrw/openssl_wrap.h"
+#include "mococrw/private/parallel.h"
+
+#include <array>
 
 #include <openssl/crypto.h>
+#include <openssl/evp.h>
 #include <openssl/hmac.h>
 #include <boost/format.hpp>
 
@@ -29,12 +33,70 @@ namespace mococrw
 {
 MessageAuthenticationCode::~MessageAuthenticationCode() = default;
 
+void MessageAuthenticationCode::update(ByteView message) { update(message.toVector()); }
+
+VerificationResult MessageAuthenticationCode::tryVerify(ByteView macValue)
+{
+    try {
+        verify(macValue.toVector());
+    } catch (const MoCOCrWException &) {
+        return VerificationResult{VerificationStatus::Mismatch};
+    }
+    return VerificationResult::valid();
+}
+
+/* Large enough to amortize the copy of the keyed context, small enough to balance the load when
+ * the messages differ in size. */
+const size_t MessageAuthenticationCode::BatchBlockSize = 64;
+
+namespace
+{
+template <class Impl, class Algorithm>
+std::vector<std::vector<uint8_t>> computeMACBatch(
+        Algorithm algorithm,
+        const std::vector<MessageAuthenticationCode::KeyedMessage> &items,
+        unsigned int numberOfThreads)
+{
+    std::vector<std::vector<uint8_t>> macs(items.size());
+    detail::parallelFor(items.size(), numberOfThreads, [&](size_t i) {
+        Impl mac{algorithm, items[i].key};
+        mac.update(items[i].message);
+        macs[i] = mac.finish();
+    });
+    return macs;
+}
+
+template <class Impl>
+std::vector<bool> verifyMACBatch(const Impl &keyedMac,
+                                 const std::vector<MessageAuthenticationCode::TaggedMessage> &items,
+                                 unsigned int numberOfThreads)
+{
+    const size_t blockSize = MessageAuthenticationCode::BatchBlockSize;
+    size_t blocks = (items.size() + blockSize - 1) / blockSize;
+    /* One byte per item, so workers never write to the same word of the bitmap. */
+    std::vector<uint8_t> valid(items.size(), 0);
+    detail::parallelFor(blocks, numberOfThreads, [&](size_t block) {
+        Impl mac{keyedMac};
+        size_t end = std::min(items.size(), (block + 1) * blockSize);
+        for (size_t i = block * blockSize; i < end; i++) {
+            mac.reset();
+            mac.update(items[i].message);
+            auto result = mac.finish();
+            const auto &tag = items[i].tag;
+            valid[i] = tag.size() == result.size() &&
+                       CRYPTO_memcmp(tag.data(), result.data(), tag.size()) == 0;
+        }
+    });
+    return std::vector<bool>(valid.begin(), valid.end());
+}
+}  // namespace
+
 /* HMAC */
 
 class HMAC::Impl
 {
 public:
-    Impl(openssl::DigestTypes hashFunction, const std::vector<uint8_t> &key)
+    Impl(openssl::DigestTypes hashFunction, ByteView key)
     {
         const EVP_MD *digestFn = openssl::_getMDPtrFromDigestType(hashFunction);
 
@@ -43,19 +105,33 @@ public:
         }
 
         _ctx = openssl::_HMAC_CTX_new();
-        openssl::_HMAC_Init_ex(_ctx.get(), key, digestFn, NULL);
+        openssl::_HMAC_Init_ex(_ctx.get(), key.data(), key.size(), digestFn, NULL);
     }
 
     ~Impl() = default;
 
     Impl(Impl &&) = default;
 
-    void update(const std::vector<uint8_t> &message)
+    Impl(const Impl &other)
+            : _ctx(openssl::_HMAC_CTX_copy(other._ctx.get()))
+            , _isFinished(other._isFinished)
+            , _result(other._result)
+    {
+    }
+
+    void reset()
+    {
+        openssl::_HMAC_reinit(_ctx.get());
+        _isFinished = false;
+        _result.clear();
+    }
+
+    void update(ByteView message)
     {
         if (_isFinished) {
             throw MoCOCrWException("update() can't be called after finish()");
         }
-        openssl::_HMAC_Update(_ctx.get(), message);
+        openssl::_HMAC_Update(_ctx.get(), message.data(), message.size());
     }
 
     std::vector<uint8_t> finish()
@@ -71,20 +147,33 @@ public:
         return _result;
     }
 
-    void verify(const std::vector<uint8_t> &hmacValue)
+    VerificationResult tryVerify(ByteView hmacValue)
     {
         if (!_isFinished) {
             finish();
         }
 
         if (hmacValue.size() != _result.size()) {
-            throw MoCOCrWException("HMAC verification failed. Length differs.");
+            return VerificationResult{VerificationStatus::InvalidLength};
         }
 
         if (CRYPTO_memcmp(hmacValue.data(), _result.data(), hmacValue.size())) {
-            throw MoCOCrWException(
-                    "HMAC verification failed. Calculated value: " + utility::toHex(_result) +
-                    ". Received value: " + utility::toHex(hmacValue));
+            return VerificationResult{VerificationStatus::Mismatch};
+        }
+        return VerificationResult::valid();
+    }
+
+    void verify(const std::vector<uint8_t> &hmacValue)
+    {
+        switch (tryVerify(hmacValue).getStatus()) {
+            case VerificationStatus::Valid:
+                return;
+            case VerificationStatus::InvalidLength:
+                throw MoCOCrWException("HMAC verification failed. Length differs.");
+            default:
+                throw MoCOCrWException(
+                        "HMAC verification failed. Calculated value: " + utility::toHex(_result) +
+                        ". Received value: " + utility::toHex(hmacValue));
         }
     }
 
@@ -99,6 +188,8 @@ HMAC::HMAC(mococrw::openssl::DigestTypes hashFunction, const std::vector<uint8_t
     _impl = std::make_unique<HMAC::Impl>(hashFunction, key);
 }
 
+HMAC::HMAC(std::unique_ptr<Impl> impl) : _impl(std::move(impl)) {}
+
 HMAC::~HMAC() = default;
 
 HMAC::HMAC(HMAC &&other) = default;
@@ -107,16 +198,39 @@ HMAC &HMAC::operator=(HMAC &&other) = default;
 
 void HMAC::update(const std::vector<uint8_t> &message) { _impl->update(message); }
 
+void HMAC::update(ByteView message) { _impl->update(message); }
+
 std::vector<uint8_t> HMAC::finish() { return _impl->finish(); }
 
 void HMAC::verify(const std::vector<uint8_t> &hmacValue) { _impl->verify(hmacValue); }
 
+VerificationResult HMAC::tryVerify(ByteView hmacValue) { return _impl->tryVerify(hmacValue); }
+
+void HMAC::reset() { _impl->reset(); }
+
+HMAC HMAC::clone() const { return HMAC{std::make_unique<HMAC::Impl>(*_impl)}; }
+
+std::vector<std::vector<uint8_t>> HMAC::computeBatch(openssl::DigestTypes hashFunction,
+                                                     const std::vector<KeyedMessage> &items,
+                                                     unsigned int numberOfThreads)
+{
+    return computeMACBatch<HMAC::Impl>(hashFunction, items, numberOfThreads);
+}
+
+std::vector<bool> HMAC::verifyBatch(openssl::DigestTypes hashFunction,
+                                    const std::vector<uint8_t> &key,
+                                    const std::vector<TaggedMessage> &items,
+                                    unsigned int numberOfThreads)
+{
+    return verifyMACBatch(HMAC::Impl{hashFunction, key}, items, numberOfThreads);
+}
+
 /* CMAC */
 
 class CMAC::Impl
 {
 public:
-    Impl(openssl::CmacCipherTypes cipherType, const std::vector<uint8_t> &key)
+    Impl(openssl::CmacCipherTypes cipherType, ByteView key)
     {
         const EVP_CIPHER *cipher = openssl::_getCipherPtrFromCmacCipherType(cipherType);
 
@@ -130,19 +244,33 @@ public:
         }
 
         _ctx = openssl::_CMAC_CTX_new();
-        openssl::_CMAC_Init(_ctx.get(), key, cipher, nullptr);
+        openssl::_CMAC_Init(_ctx.get(), key.data(), key.size(), cipher, nullptr);
     }
 
     ~Impl() = default;
 
     Impl(Impl &&) = default;
 
-    void update(const std::vector<uint8_t> &message)
+    Impl(const Impl &other)
+            : _ctx(openssl::_CMAC_CTX_copy(other._ctx.get()))
+            , _isFinished(other._isFinished)
+            , _result(other._result)
+    {
+    }
+
+    void reset()
+    {
+        openssl::_CMAC_reinit(_ctx.get());
+        _isFinished = false;
+        _result.clear();
+    }
+
+    void update(ByteView message)
     {
         if (_isFinished) {
             throw MoCOCrWException("update() can't be called after finish()");
         }
-        openssl::_CMAC_Update(_ctx.get(), message);
+        openssl::_CMAC_Update(_ctx.get(), message.data(), message.size());
     }
 
     std::vector<uint8_t> finish()
@@ -158,20 +286,33 @@ public:
         return _result;
     }
 
-    void verify(const std::vector<uint8_t> &cmacValue)
+    VerificationResult tryVerify(ByteView cmacValue)
     {
         if (!_isFinished) {
             finish();
         }
 
         if (cmacValue.size() != _result.size()) {
-            throw MoCOCrWException("CMAC verification failed. Length differs.");
+            return VerificationResult{VerificationStatus::InvalidLength};
         }
 
         if (CRYPTO_memcmp(cmacValue.data(), _result.data(), cmacValue.size())) {
-            throw MoCOCrWException(
-                    "CMAC verification failed. Calculated value: " + utility::toHex(_result) +
-                    ". Received value: " + utility::toHex(cmacValue));
+            return VerificationResult{VerificationStatus::Mismatch};
+        }
+        return VerificationResult::valid();
+    }
+
+    void verify(const std::vector<uint8_t> &cmacValue)
+    {
+        switch (tryVerify(cmacValue).getStatus()) {
+            case VerificationStatus::Valid:
+                return;
+            case VerificationStatus::InvalidLength:
+                throw MoCOCrWException("CMAC verification failed. Length differs.");
+            default:
+                throw MoCOCrWException(
+                        "CMAC verification failed. Calculated value: " + utility::toHex(_result) +
+                        ". Received value: " + utility::toHex(cmacValue));
         }
     }
 
@@ -186,6 +327,8 @@ CMAC::CMAC(mococrw::openssl::CmacCipherTypes cipherType, const std::vector<uint8
 {
 }
 
+CMAC::CMAC(std::unique_ptr<Impl> impl) : _impl(std::move(impl)) {}
+
 CMAC::~CMAC() = default;
 
 CMAC::CMAC(CMAC &&other) = default;
@@ -194,8 +337,152 @@ CMAC &CMAC::operator=(CMAC &&other) = default;
 
 void CMAC::update(const std::vector<uint8_t> &message) { _impl->update(message); }
 
+void CMAC::update(ByteView message) { _impl->update(message); }
+
 std::vector<uint8_t> CMAC::finish() { return _impl->finish(); }
 
 void CMAC::verify(const std::vector<uint8_t> &cmacValue) { _impl->verify(cmacValue); }
 
+VerificationResult CMAC::tryVerify(ByteView cmacValue) { return _impl->tryVerify(cmacValue); }
+
+void CMAC::reset() { _impl->reset(); }
+
+CMAC CMAC::clone() const { return CMAC{std::make_unique<CMAC::Impl>(*_impl)}; }
+
+std::vector<std::vector<uint8_t>> CMAC::computeBatch(openssl::CmacCipherTypes cipherType,
+                                                     const std::vector<KeyedMessage> &items,
+                                                     unsigned int numberOfThreads)
+{
+    return computeMACBatch<CMAC::Impl>(cipherType, items, numberOfThreads);
+}
+
+std::vector<bool> CMAC::verifyBatch(openssl::CmacCipherTypes cipherType,
+                                    const std::vector<uint8_t> &key,
+                                    const std::vector<TaggedMessage> &items,
+                                    unsigned int numberOfThreads)
+{
+    return verifyMACBatch(CMAC::Impl{cipherType, key}, items, numberOfThreads);
+}
+
+/* Poly1305 */
+
+namespace
+{
+constexpr size_t poly1305TagSize = 16;
+}  // namespace
+
+const size_t Poly1305::KeySize = 32;
+const size_t Poly1305::TagSize = poly1305TagSize;
+
+class Poly1305::Impl
+{
+public:
+    Impl(ByteView key)
+    {
+        if (key.size() != KeySize) {
+            throw MoCOCrWException("Poly1305 requires a key of 32 bytes.");
+        }
+
+        /* OpenSSL 1.1.1 provides Poly1305 as an EVP_PKEY MAC. EVP_MAC is only available as of
+         * OpenSSL 3.0. */
+        _key = openssl::_EVP_PKEY_new_raw_private_key(EVP_PKEY_POLY1305, key.data(), key.size());
+        _ctx = openssl::_EVP_MD_CTX_create();
+        openssl::_EVP_DigestSignInit(_ctx.get(), openssl::DigestTypes::NONE, _key.get());
+    }
+
+    void update(ByteView message)
+    {
+        if (_isFinished) {
+            throw MoCOCrWException("update() can't be called after finish()");
+        }
+        openssl::_EVP_DigestUpdate(_ctx.get(), message.data(), message.size());
+    }
+
+    size_t finish(uint8_t *out, size_t outCapacity)
+    {
+        if (_isFinished) {
+            throw MoCOCrWException("finish() can't be called twice.");
+        }
+        if (outCapacity < _result.size()) {
+            throw MoCOCrWException("Output buffer is too small.");
+        }
+
+        _finalize();
+        std::copy(_result.begin(), _result.end(), out);
+
+        return _result.size();
+    }
+
+    VerificationResult tryVerify(ByteView tag)
+    {
+        if (!_isFinished) {
+            _finalize();
+        }
+
+        if (tag.size() != _result.size()) {
+            return VerificationResult{VerificationStatus::InvalidLength};
+        }
+
+        if (CRYPTO_memcmp(tag.data(), _result.data(), _result.size())) {
+            return VerificationResult{VerificationStatus::Mismatch};
+        }
+        return VerificationResult::valid();
+    }
+
+    void verify(const std::vector<uint8_t> &tag)
+    {
+        switch (tryVerify(tag).getStatus()) {
+            case VerificationStatus::Valid:
+                return;
+            case VerificationStatus::InvalidLength:
+                throw MoCOCrWException("Poly1305 verification failed. Length differs.");
+            default:
+                throw MoCOCrWException("Poly1305 verification failed.");
+        }
+    }
+
+private:
+    void _finalize()
+    {
+        size_t length = _result.size();
+        openssl::_EVP_DigestSignFinal(_ctx.get(), _result.data(), &length);
+        _isFinished = true;
+    }
+
+    openssl::SSL_EVP_PKEY_Ptr _key;
+    openssl::SSL_EVP_MD_CTX_Ptr _ctx;
+    bool _isFinished = false;
+    std::array<uint8_t, poly1305TagSize> _result = {};
+};
+
+Poly1305::Poly1305(const std::vector<uint8_t> &key) : _impl(std::make_unique<Poly1305::Impl>(key))
+{
+}
+
+Poly1305::~Poly1305() = default;
+
+Poly1305::Poly1305(Poly1305 &&other) = default;
+
+Poly1305 &Poly1305::operator=(Poly1305 &&other) = default;
+
+void Poly1305::update(const std::vector<uint8_t> &message) { _impl->update(message); }
+
+void Poly1305::update(ByteView message) { _impl->update(message); }
+
+std::vector<uint8_t> Poly1305::finish()
+{
+    std::vector<uint8_t> tag(TagSize);
+    tag.resize(_impl->finish(tag.data(), tag.size()));
+    return tag;
+}
+
+size_t Poly1305::finish(uint8_t *out, size_t outCapacity)
+{
+    return _impl->finish(out, outCapacity);
+}
+
+void Poly1305::verify(const std::vector<uint8_t> &tag) { _impl->verify(tag); }
+
+VerificationResult Poly1305::tryVerify(ByteView tag) { return _impl->tryVerify(tag); }
+
 }  // namespace mococrw
@@ -0,0 +1,165 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mococrw/symmetric_crypto.h"
+
+namespace mococrw
+{
+/**
+ * @brief Segmented streaming AEAD format
+ *
+ * AuthenticatedAESCipher authenticates a whole message with a single tag, so no plaintext can
+ * be trusted before the end of the message was processed. The streaming format splits the
+ * plaintext into segments of a fixed size which are sealed independently (STREAM construction,
+ * similar to Tink's streaming AEAD):
+ *
+ *   header || segment_0 || ... || segment_n
+ *
+ * - The header consists of a magic value, the cipher mode, the segment size, a random salt and
+ *   a random nonce prefix (AEADStreamEncryptor::HeaderLength bytes).
+ * - A fresh key is derived for every stream from the master key and the header (X9.63 KDF with
+ *   SHA-256), so nonces never repeat across streams.
+ * - Segment i is sealed with the nonce noncePrefix (7 bytes) || i (4 bytes, big endian) ||
+ *   lastSegmentFlag (1 byte) and the header as associated data. It consists of at most
+ *   segmentSize bytes of ciphertext followed by a 16 byte tag.
+ *
+ * Segments can be released as soon as they are authenticated. Reordering, truncating or
+ * extending the stream is detected. Because the segments are independent, they can be
+ * processed in parallel.
+ *
+ * Supported modes are SymmetricCipherMode::GCM (AES-256-GCM) and
+ * SymmetricCipherMode::CHACHA20_POLY1305. The master key must be at least 32 bytes long.
+ */
+class AEADStreamEncryptor
+{
+public:
+    /**
+     * Default size of the plaintext segments (64 KiB)
+     */
+    static const size_t DefaultSegmentSize;
+    static const size_t HeaderLength;
+    static const size_t TagLength;
+
+    /**
+     * @param mode the AEAD used for the segments
+     * @param masterKey the master key from which the stream key is derived
+     * @param segmentSize the size of the plaintext segments (1 byte to 16 MiB)
+     * @throws MoCOCrWException if a parameter is invalid
+     */
+    AEADStreamEncryptor(SymmetricCipherMode mode,
+                        const std::vector<uint8_t> &masterKey,
+                        size_t segmentSize = DefaultSegmentSize);
+
+    ~AEADStreamEncryptor();
+
+    /**
+     * Encrypt the next part of the plaintext.
+     *
+     * @return the ciphertext of all completed segments. The output of the first call starts with
+     *         the header.
+     */
+    std::vector<uint8_t> update(const std::vector<uint8_t> &plaintext);
+
+    /**
+     * Seal the remaining plaintext as the last segment.
+     *
+     * @return the remaining ciphertext
+     */
+    std::vector<uint8_t> finish();
+
+    /**
+     * Encrypt a file using a pipeline which reads, encrypts and writes on separate threads. The
+     * segments are encrypted in parallel. If an error occurs, the output file is removed.
+     *
+     * @param numberOfThreads number of threads encrypting segments. 0 selects the number of
+     *                        hardware threads.
+     * @throws MoCOCrWException if a file can't be read or written
+     */
+    static void encryptFile(SymmetricCipherMode mode,
+                            const std::vector<uint8_t> &masterKey,
+                            const std::string &inputFile,
+                            const std::string &outputFile,
+                            size_t segmentSize = DefaultSegmentSize,
+                            unsigned int numberOfThreads = 0);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> _impl;
+};
+
+/**
+ * @brief Decryptor of the segmented streaming AEAD format
+ *
+ * @sa AEADStreamEncryptor
+ */
+class AEADStreamDecryptor
+{
+public:
+    /**
+     * @param masterKey the master key. The cipher mode and segment size are read from the
+     *                  header of the stream.
+     */
+    explicit AEADStreamDecryptor(const std::vector<uint8_t> &masterKey);
+
+    ~AEADStreamDecryptor();
+
+    /**
+     * Decrypt the next part of the ciphertext.
+     *
+     * @return the plaintext of all completed and authenticated segments. The segment which may
+     *         be the last one is held back until more data arrives or finish() is called.
+     * @throws MoCOCrWException if the header is invalid or a segment can't be authenticated
+     */
+    std::vector<uint8_t> update(const std::vector<uint8_t> &ciphertext);
+
+    /**
+     * Authenticate and decrypt the last segment.
+     *
+     * @throws MoCOCrWException if the stream is truncated or the last segment can't be
+     *                          authenticated
+     */
+    std::vector<uint8_t> finish();
+
+    /**
+     * Decrypt a file using a pipeline which reads, decrypts and writes on separate threads. The
+     * segments are decrypted in parallel.
+     *
+     * If the file can't be authenticated or another error occurs, the output file is removed.
+     *
+     * @param numberOfThreads number of threads decrypting segments. 0 selects the number of
+     *                        hardware threads.
+     * @throws MoCOCrWException if a file can't be read or written or the ciphertext can't be
+     *                          authenticated
+     */
+    static void decryptFile(const std::vector<uint8_t> &masterKey,
+                            const std::string &inputFile,
+                            const std::string &outputFile,
+                            unsigned int numberOfThreads = 0);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> _impl;
+};
+
+}  // namespace mococrw
@@ -19,8 +19,10 @@
 #pragma once
 
 #include <memory>
+#include "byte_view.h"
 #include "openssl_wrap.h"
 #include "padding_mode.h"
+#include "verification_result.h"
 #include "x509.h"
 
 namespace mococrw
@@ -215,6 +217,14 @@ public:
      * @throw MoCOCrWException If digest size doesn't match the expected digest size.
      */
     virtual std::vector<uint8_t> signDigest(const std::vector<uint8_t>& messageDigest) = 0;
+
+    /**
+     * @brief Signs a digest referenced by a ByteView
+     *
+     * The contexts of this library read the digest in place. The default implementation copies
+     * it and calls signDigest(const std::vector<uint8_t>&).
+     */
+    virtual std::vector<uint8_t> signDigest(ByteView messageDigest);
 };
 
 /**
@@ -239,6 +249,14 @@ public:
      * @throw MoCOCrWException If the sign operation fails.
      */
     virtual std::vector<uint8_t> signMessage(const std::vector<uint8_t>& message) = 0;
+
+    /**
+     * @brief Signs a message referenced by a ByteView
+     *
+     * The contexts of this library read the message in place. The default implementation copies
+     * it and calls signMessage(const std::vector<uint8_t>&).
+     */
+    virtual std::vector<uint8_t> signMessage(ByteView message);
 };
 
 /**
@@ -263,6 +281,30 @@ public:
      */
     virtual void verifyDigest(const std::vector<uint8_t>& signature,
                               const std::vector<uint8_t>& digest) = 0;
+
+    /**
+     * @brief Verifies the signature of a digest, both referenced by ByteViews
+     *
+     * The contexts of this library read the data in place. The default implementation copies it
+     * and calls verifyDigest(const std::vector<uint8_t>&, const std::vector<uint8_t>&).
+     */
+    virtual void verifyDigest(ByteView signature, ByteView digest);
+
+    /**
+     * @brief Verifies the signature of a digest without throwing if it is invalid
+     *
+     * An invalid or malformed signature is reported through the returned status instead of an
+     * exception, which makes rejecting many forged signatures cheap. The contexts of this library
+     * neither throw nor format a message for an invalid signature. The default implementation for
+     * other implementations of this interface maps an exception from verifyDigest() to
+     * VerificationStatus::Mismatch.
+     *
+     * @return VerificationStatus::Valid, VerificationStatus::Mismatch or
+     *         VerificationStatus::InvalidLength if the digest or the signature has a wrong size
+     * @throw MoCOCrWException If the verification can't be performed, e.g. because the key is not
+     *                         usable.
+     */
+    virtual VerificationResult tryVerifyDigest(ByteView signature, ByteView digest);
 };
 
 /**
@@ -287,6 +329,21 @@ public:
      */
     virtual void verifyMessage(const std::vector<uint8_t>& signature,
                                const std::vector<uint8_t>& message) = 0;
+
+    /**
+     * @brief Verifies the signature of a message, both referenced by ByteViews
+     *
+     * The contexts of this library read the data in place. The default implementation copies it
+     * and calls verifyMessage(const std::vector<uint8_t>&, const std::vector<uint8_t>&).
+     */
+    virtual void verifyMessage(ByteView signature, ByteView message);
+
+    /**
+     * @brief Verifies the signature of a message without throwing if it is invalid
+     *
+     * @see DigestVerificationCtx::tryVerifyDigest()
+     */
+    virtual VerificationResult tryVerifyMessage(ByteView signature, ByteView message);
 };
 
 /**
@@ -334,8 +391,12 @@ public:
 
     std::vector<uint8_t> signDigest(const std::vector<uint8_t>& messageDigest) override;
 
+    std::vector<uint8_t> signDigest(ByteView messageDigest) override;
+
     std::vector<uint8_t> signMessage(const std::vector<uint8_t>& message) override;
 
+    std::vector<uint8_t> signMessage(ByteView message) override;
+
 private:
     /**
      * Internal class for applying the PIMPL design pattern
@@ -407,9 +468,17 @@ public:
     void verifyDigest(const std::vector<uint8_t>& signature,
                       const std::vector<uint8_t>& digest) override;
 
+    void verifyDigest(ByteView signature, ByteView digest) override;
+
+    VerificationResult tryVerifyDigest(ByteView signature, ByteView digest) override;
+
     void verifyMessage(const std::vector<uint8_t>& signature,
                        const std::vector<uint8_t>& message) override;
 
+    void verifyMessage(ByteView signature, ByteView message) override;
+
+    VerificationResult tryVerifyMessage(ByteView signature, ByteView message) override;
+
 private:
     /**
      * Internal class for applying the PIMPL design pattern
@@ -491,8 +560,12 @@ public:
 
     std::vector<uint8_t> signDigest(const std::vector<uint8_t>& messageDigest) override;
 
+    std::vector<uint8_t> signDigest(ByteView messageDigest) override;
+
     std::vector<uint8_t> signMessage(const std::vector<uint8_t>& message) override;
 
+    std::vector<uint8_t> signMessage(ByteView message) override;
+
 private:
     /**
      * Internal class for applying the PIMPL design pattern
@@ -613,9 +686,17 @@ public:
     void verifyDigest(const std::vector<uint8_t>& signature,
                       const std::vector<uint8_t>& digest) override;
 
+    void verifyDigest(ByteView signature, ByteView digest) override;
+
+    VerificationResult tryVerifyDigest(ByteView signature, ByteView digest) override;
+
     void verifyMessage(const std::vector<uint8_t>& signature,
                        const std::vector<uint8_t>& message) override;
 
+    void verifyMessage(ByteView signature, ByteView message) override;
+
+    VerificationResult tryVerifyMessage(ByteView signature, ByteView message) override;
+
 private:
     /**
      * Internal class for applying the PIMPL design pattern
@@ -661,6 +742,8 @@ public:
 
     std::vector<uint8_t> signMessage(const std::vector<uint8_t>& message) override;
 
+    std::vector<uint8_t> signMessage(ByteView message) override;
+
 private:
     /**
      * Internal class for applying the PIMPL design pattern
@@ -714,6 +797,10 @@ public:
     void verifyMessage(const std::vector<uint8_t>& signature,
                        const std::vector<uint8_t>& message) override;
 
+    void verifyMessage(ByteView signature, ByteView message) override;
+
+    VerificationResult tryVerifyMessage(ByteView signature, ByteView message) override;
+
 private:
     /**
      * Internal class for applying the PIMPL design pattern
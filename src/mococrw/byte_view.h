@@ -0,0 +1,102 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace mococrw
+{
+/**
+ * @brief Non-owning read-only view of a contiguous byte range
+ *
+ * A C++14 replacement for std::span<const uint8_t>. It is implicitly created from
+ * std::vector<uint8_t>, std::string and std::array<uint8_t, N>, or explicitly from a pointer and a
+ * length, e.g. for memory mapped files or network buffers. Functions taking a ByteView read the
+ * bytes in place instead of requiring a copy into a std::vector.
+ *
+ * The referenced memory must stay valid as long as the view is used.
+ */
+class ByteView
+{
+public:
+    constexpr ByteView() noexcept : _data{nullptr}, _size{0} {}
+
+    /*
+     * This and the std::string constructor are templates, so that a literal 0 (a null pointer
+     * constant) can't select them. Otherwise braced lists like update({0x00, 0x10}) would be
+     * ambiguous between the std::vector and the ByteView overloads.
+     */
+    template <class T,
+              std::enable_if_t<std::is_same<std::remove_const_t<T>, uint8_t>::value, int> = 0>
+    constexpr ByteView(T *data, size_t size) noexcept : _data{data}, _size{size}
+    {
+    }
+
+    ByteView(const std::vector<uint8_t> &data) noexcept : _data{data.data()}, _size{data.size()}
+    {
+    }
+
+    template <class S, std::enable_if_t<std::is_same<S, std::string>::value, int> = 0>
+    ByteView(const S &data) noexcept
+            : _data{reinterpret_cast<const uint8_t *>(data.data())}, _size{data.size()}
+    {
+    }
+
+    template <size_t N>
+    constexpr ByteView(const std::array<uint8_t, N> &data) noexcept
+            : _data{data.data()}, _size{N}
+    {
+    }
+
+    constexpr const uint8_t *data() const noexcept { return _data; }
+    constexpr size_t size() const noexcept { return _size; }
+    constexpr bool empty() const noexcept { return _size == 0; }
+
+    constexpr const uint8_t *begin() const noexcept { return _data; }
+    constexpr const uint8_t *end() const noexcept { return _data + _size; }
+
+    constexpr const uint8_t &operator[](size_t index) const { return _data[index]; }
+
+    /**
+     * @return a view of \c length bytes starting at \c offset. The range is clamped to the
+     *         bounds of this view.
+     */
+    constexpr ByteView subview(size_t offset, size_t length = SIZE_MAX) const noexcept
+    {
+        return offset >= _size ? ByteView{_data + _size, 0}
+                               : ByteView{_data + offset,
+                                          length < _size - offset ? length : _size - offset};
+    }
+
+    /**
+     * @return a copy of the referenced bytes
+     */
+    std::vector<uint8_t> toVector() const { return std::vector<uint8_t>(begin(), end()); }
+
+private:
+    const uint8_t *_data;
+    size_t _size;
+};
+
+}  // namespace mococrw
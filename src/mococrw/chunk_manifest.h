@@ -0,0 +1,227 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#pragma once
+#include <string>
+#include <vector>
+
+#include "mococrw/asymmetric_crypto_ctx.h"
+#include "mococrw/openssl_wrap.h"
+
+namespace mococrw
+{
+/**
+ * @brief Verifiable manifest of a large artifact split into fixed-size chunks
+ *
+ * The artifact is split into chunks of getChunkSize() bytes (the last chunk may be shorter).
+ * Every chunk is hashed and the chunk hashes are arranged in a binary Merkle tree. Leaves are
+ * computed as H(0x00 || chunk), inner nodes as H(0x01 || left || right). A node without a
+ * sibling is promoted to the next level unchanged. An empty artifact consists of a single empty
+ * chunk.
+ *
+ * The root hash together with the digest type, the chunk size and the total size (the manifest
+ * header) is signed with any MessageSignatureCtx. A receiver which has verified the signature of
+ * a manifest can verify every chunk or byte range on its own, so the artifact can be consumed
+ * and verified while it is streamed instead of hashing the whole file first.
+ *
+ * Chunks are hashed in parallel when a manifest is created.
+ *
+ * @code
+ *   auto manifest = ChunkManifest::fromFile("update.img", DigestTypes::SHA256);
+ *   auto signature = manifest.sign(signatureCtx);
+ *   auto serializedManifest = manifest.serialize();
+ *
+ *   // receiver
+ *   auto manifest = ChunkManifest::deserialize(serializedManifest);
+ *   manifest.verifySignature(verificationCtx, signature);
+ *   manifest.verifyRange(offset, data, length);
+ * @endcode
+ */
+class ChunkManifest
+{
+public:
+    /**
+     * Default chunk size (1 MiB)
+     */
+    static const size_t DefaultChunkSize;
+
+    /**
+     * @brief Create a manifest of an in-memory artifact
+     *
+     * @param data the artifact
+     * @param length length of the artifact in bytes
+     * @param digestType the hash function used for the chunks and the Merkle tree
+     * @param chunkSize the size of the chunks in bytes
+     * @param numberOfThreads number of threads used for hashing. 0 selects the number of
+     *                        hardware threads
+     * @throws MoCOCrWException if chunkSize is 0 or digestType is not supported
+     */
+    static ChunkManifest fromBuffer(const uint8_t *data,
+                                    size_t length,
+                                    openssl::DigestTypes digestType,
+                                    size_t chunkSize = DefaultChunkSize,
+                                    unsigned int numberOfThreads = 0);
+
+    static ChunkManifest fromBuffer(const std::vector<uint8_t> &data,
+                                    openssl::DigestTypes digestType,
+                                    size_t chunkSize = DefaultChunkSize,
+                                    unsigned int numberOfThreads = 0);
+
+    /**
+     * @brief Create a manifest of a file
+     *
+     * Every worker thread reads the chunks it hashes on its own, so the file is neither loaded
+     * into memory as a whole nor read serially.
+     *
+     * @throws MoCOCrWException if the file can't be read, if chunkSize is 0 or digestType is not
+     *                          supported
+     */
+    static ChunkManifest fromFile(const std::string &filename,
+                                  openssl::DigestTypes digestType,
+                                  size_t chunkSize = DefaultChunkSize,
+                                  unsigned int numberOfThreads = 0);
+
+    /**
+     * @brief Parse a manifest created by serialize()
+     *
+     * The Merkle tree is rebuilt from the contained chunk hashes and compared with the contained
+     * root hash. Hence, a manifest whose signature was verified with verifySignature() also
+     * authenticates all chunk hashes.
+     *
+     * @throws MoCOCrWException if the manifest is malformed or inconsistent
+     */
+    static ChunkManifest deserialize(const std::vector<uint8_t> &serializedManifest);
+
+    /**
+     * @brief Serialize the manifest (header, root hash and all chunk hashes)
+     */
+    std::vector<uint8_t> serialize() const;
+
+    /**
+     * @brief The data covered by the signature: the header and the root hash
+     */
+    std::vector<uint8_t> getSignedData() const;
+
+    /**
+     * @brief Sign the manifest
+     *
+     * @param signatureCtx any message signature context, e.g. ECDSASignaturePrivateKeyCtx
+     * @return the signature over getSignedData()
+     */
+    std::vector<uint8_t> sign(MessageSignatureCtx &signatureCtx) const;
+
+    /**
+     * @brief Verify the signature of the manifest
+     *
+     * @throws MoCOCrWException if the signature is invalid
+     */
+    void verifySignature(MessageVerificationCtx &verificationCtx,
+                         const std::vector<uint8_t> &signature) const;
+
+    /**
+     * @brief Verify a single chunk
+     *
+     * @param chunkIndex the index of the chunk
+     * @param data the content of the chunk
+     * @param length the length of the chunk. Must be getChunkLength(chunkIndex)
+     * @throws MoCOCrWException if the index is out of range or the chunk doesn't match
+     */
+    void verifyChunk(size_t chunkIndex, const uint8_t *data, size_t length) const;
+    void verifyChunk(size_t chunkIndex, const std::vector<uint8_t> &data) const;
+
+    /**
+     * @brief Verify a byte range of the artifact
+     *
+     * The range must cover complete chunks, i.e. offset must be a multiple of the chunk size and
+     * the range must end at a chunk boundary or at the end of the artifact. Use
+     * getChunkIndex() and getChunkOffset() to extend an arbitrary range accordingly.
+     *
+     * @param offset the offset of the range within the artifact
+     * @param data the content of the range
+     * @param length the length of the range
+     * @param numberOfThreads number of threads used for hashing. 0 selects the number of
+     *                        hardware threads
+     * @throws MoCOCrWException if the range is not chunk aligned, exceeds the artifact or any of
+     *                          the covered chunks doesn't match
+     */
+    void verifyRange(uint64_t offset,
+                     const uint8_t *data,
+                     size_t length,
+                     unsigned int numberOfThreads = 0) const;
+
+    /**
+     * @brief Get the Merkle inclusion proof of a chunk
+     *
+     * The proof consists of the sibling hashes on the path from the leaf to the root. Together
+     * with verifyInclusion() it allows verifying a chunk against a signed root without
+     * transferring all chunk hashes.
+     */
+    std::vector<std::vector<uint8_t>> getInclusionProof(size_t chunkIndex) const;
+
+    /**
+     * @brief Verify a chunk against a root hash using an inclusion proof
+     *
+     * @param rootHash the (authenticated) root hash
+     * @param digestType the hash function of the manifest
+     * @param numberOfChunks the number of chunks of the manifest
+     * @param chunkIndex the index of the chunk
+     * @param data the content of the chunk
+     * @param length the length of the chunk
+     * @param proof the proof returned by getInclusionProof()
+     * @throws MoCOCrWException if the chunk is not part of the tree
+     */
+    static void verifyInclusion(const std::vector<uint8_t> &rootHash,
+                                openssl::DigestTypes digestType,
+                                size_t numberOfChunks,
+                                size_t chunkIndex,
+                                const uint8_t *data,
+                                size_t length,
+                                const std::vector<std::vector<uint8_t>> &proof);
+
+    openssl::DigestTypes getDigestType() const { return _digestType; }
+    size_t getChunkSize() const { return _chunkSize; }
+    uint64_t getTotalSize() const { return _totalSize; }
+    size_t getNumberOfChunks() const { return _chunkHashes.size(); }
+    const std::vector<uint8_t> &getRootHash() const { return _rootHash; }
+
+    /**
+     * @throws MoCOCrWException if the index is out of range
+     */
+    const std::vector<uint8_t> &getChunkHash(size_t chunkIndex) const;
+
+    /**
+     * @brief The index of the chunk containing the given byte offset
+     */
+    size_t getChunkIndex(uint64_t offset) const;
+    uint64_t getChunkOffset(size_t chunkIndex) const;
+    size_t getChunkLength(size_t chunkIndex) const;
+
+private:
+    ChunkManifest(openssl::DigestTypes digestType,
+                  size_t chunkSize,
+                  uint64_t totalSize,
+                  std::vector<std::vector<uint8_t>> chunkHashes);
+
+    openssl::DigestTypes _digestType;
+    size_t _chunkSize;
+    uint64_t _totalSize;
+    std::vector<std::vector<uint8_t>> _chunkHashes;
+    std::vector<uint8_t> _rootHash;
+};
+
+}  // namespace mococrw
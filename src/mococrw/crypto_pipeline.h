@@ -0,0 +1,168 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "mococrw/hash.h"
+#include "mococrw/mac.h"
+#include "mococrw/symmetric_crypto.h"
+
+namespace mococrw
+{
+/**
+ * @brief Single-pass encryption (or decryption) and hashing of a stream
+ *
+ * Computing a digest of the plaintext in addition to encrypting it usually reads every byte from
+ * memory twice. This stage splits the input into chunks of ChunkSize bytes, which stay in the
+ * CPU cache. Each chunk runs through the cipher, all digests and the optional MAC before the
+ * next chunk is read.
+ *
+ * Each digest and the MAC can be computed over the input or the output of the cipher. For
+ * example, a SHA-256 of the plaintext for deduplication and an HMAC of the ciphertext for
+ * encrypt-then-MAC. The time spent in each part is measured, so the throughput of every part
+ * can be reported.
+ *
+ * The cipher and the MAC are owned by the caller and must outlive the stage. After finish(),
+ * the caller finalizes the MAC and, for authenticated ciphers, retrieves the tag.
+ *
+ * @code
+ * auto encryptor = AESCipherBuilder{mode, keySize, key}.setIV(iv).buildEncryptor();
+ * HMAC hmac{DigestTypes::SHA256, macKey};
+ * CipherDigestStage stage{*encryptor};
+ * stage.addDigest(DigestTypes::SHA256, CipherDigestStage::Tap::Input)
+ *         .setMAC(hmac, CipherDigestStage::Tap::Output);
+ * written += stage.update(chunk, chunkLength, out + written, outCapacity - written);
+ * written += stage.finish(out + written, outCapacity - written);
+ * auto plaintextDigest = stage.digest(DigestTypes::SHA256);
+ * auto mac = hmac.finish();
+ * @endcode
+ */
+class CipherDigestStage
+{
+public:
+    /**
+     * Size of the chunks in which the data is passed through the cipher and the digests.
+     */
+    static const size_t ChunkSize;
+
+    /**
+     * Selects whether a digest or MAC is computed over the input or the output of the cipher.
+     */
+    enum class Tap { Input, Output };
+
+    /**
+     * Amount of data processed by a part of the stage and the time spent on it.
+     */
+    struct Throughput
+    {
+        uint64_t bytes = 0;
+        std::chrono::nanoseconds time{0};
+
+        /**
+         * @return the processed bytes per second, or 0 if nothing was measured yet
+         */
+        double bytesPerSecond() const;
+    };
+
+    /**
+     * @param cipher an encryptor or decryptor which wasn't finished yet
+     */
+    explicit CipherDigestStage(AESCipher &cipher);
+
+    /**
+     * Add a digest to compute over the input or output of the cipher.
+     *
+     * @throws MoCOCrWException if the digest was already added for the same tap, or data was
+     *                          already processed
+     */
+    CipherDigestStage &addDigest(openssl::DigestTypes digestType, Tap tap = Tap::Input);
+
+    /**
+     * Compute a MAC over the input or output of the cipher.
+     *
+     * @throws MoCOCrWException if a MAC was already set, or data was already processed
+     */
+    CipherDigestStage &setMAC(MessageAuthenticationCode &mac, Tap tap = Tap::Output);
+
+    /**
+     * Process the next part of the stream.
+     *
+     * @param out output buffer for the cipher output. May be equal to \c in if the cipher
+     *            supports in-place operation.
+     * @param outCapacity size of \c out. It must be at least
+     *                    AESCipher::getMaxUpdateOutputLength(length).
+     * @return the number of bytes written to \c out
+     * @throws MoCOCrWException if the output buffer is too small or the stage was finished
+     */
+    size_t update(const uint8_t *in, size_t length, uint8_t *out, size_t outCapacity);
+
+    /**
+     * Finish the cipher and pass its remaining output to the output taps.
+     *
+     * @param outCapacity size of \c out. It must be at least
+     *                    AESCipher::getMaxFinishOutputLength().
+     * @return the number of bytes written to \c out
+     */
+    size_t finish(uint8_t *out, size_t outCapacity);
+
+    /**
+     * Get the value of a digest after finish() was called.
+     *
+     * @throws MoCOCrWException if the digest was not added or the stage is not finished
+     */
+    std::vector<uint8_t> digest(openssl::DigestTypes digestType, Tap tap = Tap::Input);
+
+    const Throughput &getCipherThroughput() const { return _cipherThroughput; }
+
+    /**
+     * @throws MoCOCrWException if the digest was not added
+     */
+    const Throughput &getDigestThroughput(openssl::DigestTypes digestType,
+                                          Tap tap = Tap::Input) const;
+
+    /**
+     * @throws MoCOCrWException if no MAC was set
+     */
+    const Throughput &getMACThroughput() const;
+
+private:
+    struct DigestTap
+    {
+        openssl::DigestTypes digestType;
+        Tap tap;
+        Hash hash;
+        Throughput throughput;
+    };
+
+    void _checkConfigurable() const;
+    void _feedTaps(Tap tap, const uint8_t *data, size_t length);
+
+    AESCipher &_cipher;
+    std::vector<DigestTap> _digests;
+    MessageAuthenticationCode *_mac = nullptr;
+    Tap _macTap = Tap::Output;
+    Throughput _cipherThroughput;
+    Throughput _macThroughput;
+    bool _started = false;
+    bool _finished = false;
+};
+
+}  // namespace mococrw
@@ -100,6 +100,13 @@ public:
      */
     void update(const std::vector<uint8_t> &message);
 
+    /**
+     * @brief Encrypt a chunk of data referenced by a ByteView without copying it first.
+     *
+     * @see update(const std::vector<uint8_t>&)
+     */
+    void update(ByteView message);
+
     /**
      * @brief Finalize the encryption.
      *
@@ -205,6 +212,13 @@ public:
      */
     void update(const std::vector<uint8_t> &message);
 
+    /**
+     * @brief Decrypt a chunk of data referenced by a ByteView without copying it first.
+     *
+     * @see update(const std::vector<uint8_t>&)
+     */
+    void update(ByteView message);
+
     /**
      * @brief Finalizes decryption and verifies authenticity
      *
@@ -220,6 +234,22 @@ public:
      */
     std::vector<uint8_t> finish();
 
+    /**
+     * @brief Finalizes decryption and verifies authenticity without throwing on a wrong tag
+     *
+     * Behaves like finish(), but reports a received tag which doesn't match the ciphertext
+     * through the returned status. The plaintext is only released if the tag is valid. The
+     * context is finished afterwards in either case.
+     *
+     * @param plaintext receives the decrypted message if the result is valid, otherwise it is
+     *                  left unchanged
+     * @throws MoCOCrWException when no MAC is set, no ephemeral key is set or finish() was
+     *                          already invoked.
+     * @return VerificationStatus::Valid, VerificationStatus::Mismatch or
+     *         VerificationStatus::InvalidLength if the tag or the ciphertext is too short
+     */
+    VerificationResult tryFinish(std::vector<uint8_t> &plaintext);
+
     /**
      * @brief Set the authentication tag
      *
@@ -339,6 +369,10 @@ public:
                     .buildEncryptor();
         };
     \endcode
+     * Authenticated ciphers (e.g. SymmetricCipherMode::CHACHA20_POLY1305) are supported as
+     * well. Their authentication tag, which must have the default length of 16 bytes, is
+     * appended to the ciphertext and covered by the MAC.
+     *
      * @param func A std::function which will be provided with the symmetric key (of key size
     provided
      * in setSymmetricCipherKeySize) and should return an object implementing the SymmetricCipherI
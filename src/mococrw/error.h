@@ -18,22 +18,51 @@
  */
 #pragma once
 
+#include <memory>
+#include <string>
+#include <type_traits>
+
 #include <boost/current_function.hpp>
 #include <boost/format.hpp>
 
 namespace mococrw
 {
+namespace openssl
+{
+class OpenSSLException;
+}
+
 class MoCOCrWException : public std::exception
 {
 public:
-    template <class StringType>
+    template <class StringType,
+              std::enable_if_t<std::is_constructible<std::string, StringType>::value, int> = 0>
     explicit MoCOCrWException(StringType &&msg) : _msg{std::forward<StringType>(msg)}
     {
     }
-    const char *what() const noexcept override { return _msg.c_str(); }
+
+    /**
+     * Translate an OpenSSLException into a MoCOCrWException.
+     *
+     * The error codes taken from the OpenSSL error queue are kept, they are only formatted
+     * when what() is called. The message is the given prefix followed by the message of the
+     * OpenSSLException.
+     */
+    explicit MoCOCrWException(const openssl::OpenSSLException &cause, std::string prefix = "");
+
+    const char *what() const noexcept override
+    {
+        return _cause ? causeWhat() : _msg.c_str();
+    }
 
 private:
+    /* Shared by all copies of the exception, like the message of the OpenSSLException. */
+    struct Cause;
+
+    const char *causeWhat() const noexcept;
+
     const std::string _msg;
+    std::shared_ptr<Cause> _cause;
 };
 
 #define ERROR_STRING(msg) (boost::format{"%s: %s"} % BOOST_CURRENT_FUNCTION % (msg)).str()
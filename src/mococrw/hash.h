@@ -18,6 +18,9 @@
  */
 #pragma once
 #include <map>
+#include <set>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "mococrw/openssl_wrap.h"
@@ -52,6 +55,22 @@ std::vector<uint8_t> sha3_512(const std::vector<uint8_t> &message);
 std::vector<uint8_t> sha3_512(const std::string &message);
 std::vector<uint8_t> sha3_512(const uint8_t *message, size_t messageLength);
 
+std::vector<uint8_t> blake2b512(const std::vector<uint8_t> &message);
+std::vector<uint8_t> blake2b512(const std::string &message);
+std::vector<uint8_t> blake2b512(const uint8_t *message, size_t messageLength);
+
+std::vector<uint8_t> blake2s256(const std::vector<uint8_t> &message);
+std::vector<uint8_t> blake2s256(const std::string &message);
+std::vector<uint8_t> blake2s256(const uint8_t *message, size_t messageLength);
+
+std::vector<uint8_t> shake128(const std::vector<uint8_t> &message, size_t outputLength);
+std::vector<uint8_t> shake128(const std::string &message, size_t outputLength);
+std::vector<uint8_t> shake128(const uint8_t *message, size_t messageLength, size_t outputLength);
+
+std::vector<uint8_t> shake256(const std::vector<uint8_t> &message, size_t outputLength);
+std::vector<uint8_t> shake256(const std::string &message, size_t outputLength);
+std::vector<uint8_t> shake256(const uint8_t *message, size_t messageLength, size_t outputLength);
+
 class Hash
 {
 public:
@@ -62,6 +81,8 @@ public:
     static Hash sha3_256();
     static Hash sha3_384();
     static Hash sha3_512();
+    static Hash blake2b512();
+    static Hash blake2s256();
     static size_t getDigestSize(openssl::DigestTypes digestType);
     static Hash fromDigestType(const openssl::DigestTypes digestType);
     std::vector<uint8_t> digest();
@@ -77,4 +98,138 @@ private:
     openssl::DigestTypes _digestType;
 };
 
+/**
+ * Extendable-output function (SHAKE128/SHAKE256 as specified in FIPS 202).
+ *
+ * The input is absorbed with update(). Afterwards, an arbitrary amount of output can be
+ * retrieved by one or more calls to squeeze(). Consecutive calls to squeeze() continue the same
+ * output stream, i.e. squeeze(16) followed by squeeze(48) returns the same 64 bytes as a single
+ * squeeze(64).
+ *
+ * The absorbed input is never hashed again. With OpenSSL 3.3 or newer, output is squeezed
+ * incrementally from the absorbed state, so squeezing needs constant memory and the total
+ * amount of output is unlimited.
+ *
+ * Older OpenSSL versions can only produce the output of an XOF in a single call. There, output
+ * is generated from a copy of the absorbed state in geometrically growing blocks, each
+ * starting at the beginning of the output stream. Only the bytes not squeezed yet are kept in
+ * memory, but generating a block temporarily needs memory for all output up to its end. The
+ * total output is therefore limited to MaxOutputLength bytes. This is sufficient for masks and
+ * derived keys, use a stream cipher for longer key streams.
+ *
+ * @code
+ *   auto xof = Shake::shake256();
+ *   xof.update(seed);
+ *   auto mask = xof.squeeze(maskLength);
+ *   auto keyStream = xof.squeeze(keyStreamLength);
+ * @endcode
+ */
+class Shake
+{
+public:
+    /**
+     * Maximum total number of bytes which can be squeezed from one instance
+     */
+    static const size_t MaxOutputLength;
+
+    static Shake shake128();
+    static Shake shake256();
+    static Shake fromXofType(openssl::XofTypes xofType);
+
+    Shake &update(const std::vector<uint8_t> &chunk);
+    Shake &update(const std::string &chunk);
+
+    /**
+     * @throws MoCOCrWException if squeeze() was already called
+     */
+    Shake &update(const uint8_t *chunk, size_t length);
+
+    /**
+     * Retrieve the next length bytes of output.
+     *
+     * @throws MoCOCrWException if more than MaxOutputLength bytes would be squeezed in total
+     */
+    std::vector<uint8_t> squeeze(size_t length);
+
+    /**
+     * Write the next length bytes of output to the given buffer.
+     *
+     * @throws MoCOCrWException if more than MaxOutputLength bytes would be squeezed in total
+     */
+    void squeeze(uint8_t *output, size_t length);
+
+private:
+    Shake(openssl::XofTypes xofType);
+    void _generateOutput(size_t minimumLength);
+
+    openssl::SSL_EVP_MD_CTX_Ptr _absorbCtx;
+    /* Generated output which wasn't squeezed yet, starting at _outputOffset */
+    std::vector<uint8_t> _output;
+    size_t _outputOffset = 0;
+    size_t _generatedLength = 0;
+    size_t _squeezedLength = 0;
+    bool _isSqueezing = false;
+    openssl::XofTypes _xofType;
+};
+
+/**
+ * Computes several digests over the same input in a single pass.
+ *
+ * The input is split into chunks of MultiHash::ChunkSize bytes which are small enough to stay
+ * cache resident. Every chunk is fed to all underlying digest contexts before the next chunk is
+ * touched, so each byte of the input is read from memory (or from disk) only once.
+ *
+ * @code
+ *   auto digests = MultiHash({DigestTypes::SHA256, DigestTypes::SHA3_256})
+ *                          .updateFromFile("artifact.bin")
+ *                          .digest();
+ *   auto sha256Digest = digests.at(DigestTypes::SHA256);
+ * @endcode
+ */
+class MultiHash
+{
+public:
+    /**
+     * Size of the chunks in which the input is fed to the digest contexts.
+     */
+    static const size_t ChunkSize;
+
+    /**
+     * @param digestTypes the digests which shall be computed
+     * @throws MoCOCrWException if digestTypes is empty or contains DigestTypes::NONE
+     */
+    explicit MultiHash(const std::set<openssl::DigestTypes> &digestTypes);
+
+    MultiHash &update(const std::vector<uint8_t> &chunk);
+    MultiHash &update(const std::string &chunk);
+    MultiHash &update(const uint8_t *chunk, size_t length);
+
+    /**
+     * Feed the complete content of a file to all digests.
+     *
+     * The file is read chunk-wise, i.e. it is never loaded into memory as a whole.
+     *
+     * @param filename path of the file to hash
+     * @throws MoCOCrWException if the file can't be opened or read
+     */
+    MultiHash &updateFromFile(const std::string &filename);
+
+    /**
+     * Finalize all digests.
+     *
+     * @return a map from the requested digest types to the respective digest values
+     */
+    std::map<openssl::DigestTypes, std::vector<uint8_t>> digest();
+
+    /**
+     * Finalize a single digest and return its value.
+     *
+     * @throws MoCOCrWException if digestType was not requested on construction
+     */
+    std::vector<uint8_t> digest(openssl::DigestTypes digestType);
+
+private:
+    std::vector<std::pair<openssl::DigestTypes, Hash>> _hashes;
+};
+
 }  // namespace mococrw
@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <memory>
 #include <vector>
+#include "byte_view.h"
 #include "hash.h"
 
 namespace mococrw
@@ -49,6 +50,18 @@ public:
     virtual std::vector<uint8_t> deriveKey(const std::vector<uint8_t> &password,
                                            const size_t outputLength,
                                            const std::vector<uint8_t> &salt) = 0;
+
+    /**
+     * @brief Provides a derived key from a password and a salt referenced by ByteViews.
+     *
+     * PBKDF2 and X963KDF read the inputs in place. The default implementation for other key
+     * derivation functions copies them and calls the std::vector overload.
+     *
+     * @see deriveKey(const std::vector<uint8_t>&, const size_t, const std::vector<uint8_t>&)
+     */
+    virtual std::vector<uint8_t> deriveKey(ByteView password,
+                                           const size_t outputLength,
+                                           ByteView salt);
 };
 
 class PBKDF2 : public KeyDerivationFunction
@@ -73,6 +86,13 @@ public:
                                    const size_t outputLength,
                                    const std::vector<uint8_t> &salt) override;
 
+    /**
+     * @see KeyDerivationFunction::deriveKey(ByteView, const size_t, ByteView)
+     */
+    std::vector<uint8_t> deriveKey(ByteView password,
+                                   const size_t outputLength,
+                                   ByteView salt) override;
+
     /**
      * @brief The move constructor
      * @param other The object to move
@@ -133,6 +153,13 @@ public:
                                    const size_t outputLength,
                                    const std::vector<uint8_t> &salt) override;
 
+    /**
+     * @see KeyDerivationFunction::deriveKey(ByteView, const size_t, ByteView)
+     */
+    std::vector<uint8_t> deriveKey(ByteView password,
+                                   const size_t outputLength,
+                                   ByteView salt) override;
+
     /**
      * @brief The move constructor
      * @param other The object to move
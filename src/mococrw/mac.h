@@ -19,7 +19,9 @@
 #pragma once
 #include <memory>
 #include <vector>
+#include "byte_view.h"
 #include "openssl_wrap.h"
+#include "verification_result.h"
 
 namespace mococrw
 {
@@ -30,6 +32,30 @@ namespace mococrw
 class MessageAuthenticationCode
 {
 public:
+    /**
+     * @brief A message and the key to compute its MAC with (see HMAC::computeBatch())
+     */
+    struct KeyedMessage
+    {
+        ByteView key;
+        ByteView message;
+    };
+
+    /**
+     * @brief A message and its received MAC (see HMAC::verifyBatch())
+     */
+    struct TaggedMessage
+    {
+        ByteView message;
+        ByteView tag;
+    };
+
+    /**
+     * Number of consecutive items a worker of a batched verification processes with one
+     * context, which is reset() between the items.
+     */
+    static const size_t BatchBlockSize;
+
     /**
      * @brief ~MessageAuthenticationCode
      */
@@ -46,6 +72,16 @@ public:
      */
     virtual void update(const std::vector<uint8_t> &message) = 0;
 
+    /**
+     * @brief Adds the message referenced by a ByteView to the MAC
+     *
+     * HMAC and CMAC read the data in place. The default implementation for other implementations
+     * of this interface copies the data and calls update(const std::vector<uint8_t>&).
+     *
+     * @throws MoCOCrWException if this function is invoked after finish was called
+     */
+    virtual void update(ByteView message);
+
     /**
      * @brief Finalize the MAC
      *
@@ -69,6 +105,21 @@ public:
      * @param macValue The value which shall be compared to the calculated value
      */
     virtual void verify(const std::vector<uint8_t> &macValue) = 0;
+
+    /**
+     * @brief Verifies the MAC without throwing on a mismatch
+     *
+     * Behaves like verify(), but reports a wrong MAC through the returned status. Use it where
+     * failed verifications are expected and frequent, e.g. for untrusted network input. HMAC and
+     * CMAC neither throw nor format a message for a failed verification. The default
+     * implementation for other implementations of this interface maps an exception from
+     * verify() to VerificationStatus::Mismatch.
+     *
+     * @param macValue The value which shall be compared to the calculated value
+     * @return VerificationStatus::Valid, VerificationStatus::Mismatch or
+     *         VerificationStatus::InvalidLength if the lengths of the values differ
+     */
+    virtual VerificationResult tryVerify(ByteView macValue);
 };
 
 class HMAC : public MessageAuthenticationCode
@@ -97,6 +148,11 @@ public:
      */
     void update(const std::vector<uint8_t> &message) override;
 
+    /**
+     * @see MessageAuthenticationCode::update(ByteView)
+     */
+    void update(ByteView message) override;
+
     /**
      * @brief Finalize the HMAC
      *
@@ -113,6 +169,63 @@ public:
      */
     void verify(const std::vector<uint8_t> &hmacValue) override;
 
+    /**
+     * @see MessageAuthenticationCode::tryVerify
+     */
+    VerificationResult tryVerify(ByteView hmacValue) override;
+
+    /**
+     * @brief Restart the computation for a new message with the same key
+     *
+     * Discards the data passed to update() and the result of finish(). The key-dependent state
+     * (the inner and outer padded keys) is reused, so a long-lived HMAC can compute one MAC per
+     * message without being constructed again.
+     */
+    void reset();
+
+    /**
+     * @brief Create an independent copy of this HMAC
+     *
+     * The copy has the same key and contains all data passed to update() so far. Copying the
+     * keyed state is cheaper than constructing a new object from the key. It allows to prepare
+     * a HMAC once and clone it per message or thread, or to compute the MAC of several messages
+     * sharing a common prefix.
+     *
+     * @return a HMAC in the same state as this one
+     */
+    HMAC clone() const;
+
+    /**
+     * @brief Compute the HMAC of many messages, each with its own key, on multiple threads
+     *
+     * @param items the keys and messages. The referenced memory must stay valid during the call.
+     * @param numberOfThreads number of threads. 0 selects the number of hardware threads.
+     * @return the MAC of every item, in the order of \c items
+     * @throws MoCOCrWException if the key of an item is empty
+     */
+    static std::vector<std::vector<uint8_t>> computeBatch(
+            mococrw::openssl::DigestTypes hashFunction,
+            const std::vector<KeyedMessage> &items,
+            unsigned int numberOfThreads = 0);
+
+    /**
+     * @brief Verify the HMAC of many messages which share a key on multiple threads
+     *
+     * The key is set up once. Workers copy the keyed context and process BatchBlockSize items
+     * with one copy. A MAC which doesn't match doesn't raise an exception but clears the bit of
+     * its item, so the cost of a failed verification is the same as of a successful one.
+     *
+     * @param items the messages and their received MACs
+     * @param numberOfThreads number of threads. 0 selects the number of hardware threads.
+     * @return one bit per item, in the order of \c items. A bit is set if the MAC of the item
+     *         is valid. The comparison happens in constant time.
+     * @throws MoCOCrWException if the key is invalid
+     */
+    static std::vector<bool> verifyBatch(mococrw::openssl::DigestTypes hashFunction,
+                                         const std::vector<uint8_t> &key,
+                                         const std::vector<TaggedMessage> &items,
+                                         unsigned int numberOfThreads = 0);
+
     /**
      * @brief The move constructor
      * @param other the other HMAC to be moved
@@ -142,6 +255,8 @@ private:
      */
     class Impl;
 
+    explicit HMAC(std::unique_ptr<Impl> impl);
+
     /**
      * @brief Pointer for PIMPL design pattern
      */
@@ -175,6 +290,11 @@ public:
      */
     void update(const std::vector<uint8_t> &message) override;
 
+    /**
+     * @see MessageAuthenticationCode::update(ByteView)
+     */
+    void update(ByteView message) override;
+
     /**
      * @brief Finalize the CMAC
      *
@@ -190,6 +310,63 @@ public:
      */
     void verify(const std::vector<uint8_t> &cmacValue) override;
 
+    /**
+     * @see MessageAuthenticationCode::tryVerify
+     */
+    VerificationResult tryVerify(ByteView cmacValue) override;
+
+    /**
+     * @brief Restart the computation for a new message with the same key
+     *
+     * Discards the data passed to update() and the result of finish(). The key-dependent state
+     * (the cipher key schedule and the CMAC subkeys) is reused, so a long-lived CMAC can compute
+     * one MAC per message without being constructed again.
+     */
+    void reset();
+
+    /**
+     * @brief Create an independent copy of this CMAC
+     *
+     * The copy has the same key and contains all data passed to update() so far. Copying the
+     * keyed state is cheaper than constructing a new object from the key. It allows to prepare
+     * a CMAC once and clone it per message or thread, or to compute the MAC of several messages
+     * sharing a common prefix.
+     *
+     * @return a CMAC in the same state as this one
+     */
+    CMAC clone() const;
+
+    /**
+     * @brief Compute the CMAC of many messages, each with its own key, on multiple threads
+     *
+     * @param items the keys and messages. The referenced memory must stay valid during the call.
+     * @param numberOfThreads number of threads. 0 selects the number of hardware threads.
+     * @return the MAC of every item, in the order of \c items
+     * @throws MoCOCrWException if the size of a key doesn't match cipherType
+     */
+    static std::vector<std::vector<uint8_t>> computeBatch(
+            mococrw::openssl::CmacCipherTypes cipherType,
+            const std::vector<KeyedMessage> &items,
+            unsigned int numberOfThreads = 0);
+
+    /**
+     * @brief Verify the CMAC of many messages which share a key on multiple threads
+     *
+     * The key is set up once. Workers copy the keyed context and process BatchBlockSize items
+     * with one copy. A MAC which doesn't match doesn't raise an exception but clears the bit of
+     * its item, so the cost of a failed verification is the same as of a successful one.
+     *
+     * @param items the messages and their received MACs
+     * @param numberOfThreads number of threads. 0 selects the number of hardware threads.
+     * @return one bit per item, in the order of \c items. A bit is set if the MAC of the item
+     *         is valid. The comparison happens in constant time.
+     * @throws MoCOCrWException if the key is invalid
+     */
+    static std::vector<bool> verifyBatch(mococrw::openssl::CmacCipherTypes cipherType,
+                                         const std::vector<uint8_t> &key,
+                                         const std::vector<TaggedMessage> &items,
+                                         unsigned int numberOfThreads = 0);
+
     /**
      * @brief The move constructor
      * @param other The other CMAC to be moved
@@ -213,6 +390,110 @@ public:
      */
     CMAC &operator=(const CMAC &) = delete;
 
+private:
+    /**
+     * @brief Internal class for applying the PIMPL design pattern
+     */
+    class Impl;
+
+    explicit CMAC(std::unique_ptr<Impl> impl);
+
+    /**
+     * @brief Pointer for PIMPL design pattern
+     */
+    std::unique_ptr<Impl> _impl;
+};
+
+/**
+ * @brief Poly1305 one-time authenticator (RFC 8439)
+ *
+ * Poly1305 is considerably faster than HMAC and CMAC, but its key must only be used for a single
+ * message. Reusing a key for two messages allows an attacker to forge MACs. It is meant for
+ * protocols which derive a fresh key per message, e.g. from a key derivation function or from
+ * the keystream of a cipher.
+ *
+ * For the same reason there is no reset() or clone().
+ */
+class Poly1305 : public MessageAuthenticationCode
+{
+public:
+    /**
+     * The size of a Poly1305 key in bytes
+     */
+    static const size_t KeySize;
+
+    /**
+     * The size of a Poly1305 tag in bytes
+     */
+    static const size_t TagSize;
+
+    /**
+     * @brief Constructor
+     * @param key the one-time key of KeySize bytes
+     * @throws MoCOCrWException if the key doesn't have KeySize bytes
+     */
+    explicit Poly1305(const std::vector<uint8_t> &key);
+
+    /**
+     * @brief destructor
+     */
+    ~Poly1305();
+
+    /**
+     * @see MessageAuthenticationCode::update
+     */
+    void update(const std::vector<uint8_t> &message) override;
+
+    /**
+     * @see MessageAuthenticationCode::update(ByteView)
+     */
+    void update(ByteView message) override;
+
+    /**
+     * @see MessageAuthenticationCode::finish
+     */
+    std::vector<uint8_t> finish() override;
+
+    /**
+     * @brief Finalize the MAC and write the tag into a buffer of the caller
+     *
+     * Avoids the allocation of the returned vector, e.g. when the tag is appended to a frame
+     * which is already allocated.
+     *
+     * @param out buffer for the tag
+     * @param outCapacity size of \c out. It must be at least TagSize.
+     * @return the number of bytes written to \c out
+     * @throws MoCOCrWException if this function or finish() is invoked twice or the buffer is
+     *                          too small
+     */
+    size_t finish(uint8_t *out, size_t outCapacity);
+
+    /**
+     * @see MessageAuthenticationCode::verify
+     */
+    void verify(const std::vector<uint8_t> &tag) override;
+
+    /**
+     * @see MessageAuthenticationCode::tryVerify
+     */
+    VerificationResult tryVerify(ByteView tag) override;
+
+    /**
+     * @brief The move constructor
+     * @param other the other Poly1305 to be moved
+     */
+    Poly1305(Poly1305 &&other);
+
+    /**
+     * @brief The assignment move operator
+     * @param other the other Poly1305 to be assigned
+     * @return the result of the assignment
+     */
+    Poly1305 &operator=(Poly1305 &&other);
+
+    Poly1305(const Poly1305 &other) = delete;
+    Poly1305 &operator=(const Poly1305 &) = delete;
+
 private:
     /**
      * @brief Internal class for applying the PIMPL design pattern
@@ -59,6 +59,40 @@ namespace lib
 class OpenSSLLib
 {
 public:
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    static EVP_MD* SSL_EVP_MD_fetch(OSSL_LIB_CTX* ctx,
+                                    const char* algorithm,
+                                    const char* properties) noexcept;
+    static void SSL_EVP_MD_free(EVP_MD* md) noexcept;
+    static const char* SSL_EVP_MD_get0_name(const EVP_MD* md) noexcept;
+    static EVP_CIPHER* SSL_EVP_CIPHER_fetch(OSSL_LIB_CTX* ctx,
+                                            const char* algorithm,
+                                            const char* properties) noexcept;
+    static void SSL_EVP_CIPHER_free(EVP_CIPHER* cipher) noexcept;
+    static const char* SSL_EVP_CIPHER_get0_name(const EVP_CIPHER* cipher) noexcept;
+#endif
+    static int SSL_EVP_DigestSignFinal(EVP_MD_CTX* ctx,
+                                       unsigned char* sig,
+                                       size_t* siglen) noexcept;
+    static EVP_PKEY* SSL_EVP_PKEY_new_raw_private_key(int type,
+                                                      ENGINE* e,
+                                                      const unsigned char* priv,
+                                                      size_t len) noexcept;
+    static void SSL_ERR_clear_error() noexcept;
+    static int SSL_ERR_set_mark() noexcept;
+    static int SSL_ERR_pop_to_mark() noexcept;
+    static int SSL_HMAC_CTX_copy(HMAC_CTX* dctx, HMAC_CTX* sctx) noexcept;
+    static int SSL_EVP_CIPHER_CTX_copy(EVP_CIPHER_CTX* out, const EVP_CIPHER_CTX* in) noexcept;
+    static int SSL_EVP_CIPHER_CTX_block_size(const EVP_CIPHER_CTX* ctx) noexcept;
+    static const EVP_MD* SSL_EVP_blake2b512() noexcept;
+    static const EVP_MD* SSL_EVP_blake2s256() noexcept;
+    static const EVP_MD* SSL_EVP_shake128() noexcept;
+    static const EVP_MD* SSL_EVP_shake256() noexcept;
+    static int SSL_EVP_DigestFinalXOF(EVP_MD_CTX* ctx, unsigned char* md, size_t len) noexcept;
+#if OPENSSL_VERSION_NUMBER >= 0x30300000L
+    static int SSL_EVP_DigestSqueeze(EVP_MD_CTX* ctx, unsigned char* out, size_t outlen) noexcept;
+#endif
+    static int SSL_EVP_MD_CTX_copy_ex(EVP_MD_CTX* out, const EVP_MD_CTX* in) noexcept;
     static int SSL_ENGINE_free(ENGINE* e) noexcept;
     static int SSL_ENGINE_finish(ENGINE* e) noexcept;
     static ENGINE* SSL_ENGINE_by_id(const char* id) noexcept;
@@ -206,6 +240,7 @@ public:
 
     /* Error handling */
     static char* SSL_ERR_error_string(unsigned long error, char* buf) noexcept;
+    static void SSL_ERR_error_string_n(unsigned long error, char* buf, size_t len) noexcept;
     static unsigned long SSL_ERR_get_error() noexcept;
 
     /* BIO Stuff */
@@ -22,6 +22,9 @@
 #include <ctime>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
 #include <vector>
 #include "boost/format.hpp"
 
@@ -42,9 +45,17 @@ enum class DigestTypes {
     SHA3_256,
     SHA3_384,
     SHA3_512,
+    BLAKE2b_512,
+    BLAKE2s_256,
     NONE = std::numeric_limits<int>::max()
 };
 
+/**
+ * Enum for the extendable-output functions (XOFs) that can be used
+ * for variable-length output computations.
+ */
+enum class XofTypes { SHAKE128, SHAKE256 };
+
 /**
  * @brief Enum for the cipher types that can be used for CMAC computations
  */
@@ -56,6 +67,7 @@ enum class CmacCipherTypes {
 namespace openssl
 {
 using DigestTypes = mococrw::DigestTypes;
+using XofTypes = mococrw::XofTypes;
 using CmacCipherTypes = mococrw::CmacCipherTypes;
 
 /**
@@ -118,23 +130,55 @@ struct SSLFree
 class OpenSSLException final : public std::exception
 {
 public:
-    template <class StringType>
-    explicit OpenSSLException(StringType&& message) : _message{std::forward<StringType>(message)}
+    /**
+     * Maximum number of error codes taken from the OpenSSL error queue. This is the size of the
+     * queue of OpenSSL (ERR_NUM_ERRORS).
+     */
+    static const size_t MaxErrorCodes;
+
+    template <class StringType,
+              std::enable_if_t<std::is_constructible<std::string, StringType>::value, int> = 0>
+    explicit OpenSSLException(StringType&& message) : _message{std::make_shared<Message>()}
     {
+        _message->text = std::forward<StringType>(message);
     }
 
     /**
-     * Generate an exception with the defalt OpenSSL error-string
-     * as message.
+     * Generate an exception from the errors in the OpenSSL error queue.
      *
+     * The queue is emptied and only the numeric error codes are kept. Many of these exceptions
+     * are caught and translated, so the message is formatted when what() is called the first
+     * time.
      */
-    OpenSSLException() : _message{generateOpenSSLErrorString()} {}
+    OpenSSLException()
+            : _errorCodes{takeOpenSSLErrorCodes()}, _message{std::make_shared<Message>()}
+    {
+    }
 
-    const char* what() const noexcept override { return _message.c_str(); }
+    /**
+     * @return the description of all errors of the OpenSSL error queue, the oldest first.
+     *         The message is formatted once on the first call, also if the exception and its
+     *         copies are used from several threads.
+     */
+    const char* what() const noexcept override;
+
+    /**
+     * @return the codes of the errors taken from the OpenSSL error queue, the oldest first.
+     *         Empty if the exception was created with a message.
+     */
+    const std::vector<unsigned long>& getErrorCodes() const noexcept { return _errorCodes; }
 
 private:
-    static std::string generateOpenSSLErrorString();
-    std::string _message;
+    /* Shared by all copies of the exception, so that copying stays cheap and non-throwing. */
+    struct Message
+    {
+        std::once_flag formatted;
+        std::string text;
+    };
+
+    static std::vector<unsigned long> takeOpenSSLErrorCodes();
+    std::vector<unsigned long> _errorCodes;
+    std::shared_ptr<Message> _message;
 };
 
 /*
@@ -259,6 +303,25 @@ void _EVP_DigestInit_ex(EVP_MD_CTX* ctx, const EVP_MD* type, ENGINE* impl);
  */
 void _EVP_MD_CTX_init(EVP_MD_CTX* ctx);
 
+/*
+ * Retrieve len bytes of output of the extendable-output function in ctx and place them in md.
+ * The context can't be updated afterwards.
+ */
+void _EVP_DigestFinalXOF(EVP_MD_CTX* ctx, unsigned char* md, size_t len);
+
+#if OPENSSL_VERSION_NUMBER >= 0x30300000L
+/*
+ * Retrieve the next outlen bytes of output of the extendable-output function in ctx. Can be
+ * called repeatedly, the context can't be updated afterwards.
+ */
+void _EVP_DigestSqueeze(EVP_MD_CTX* ctx, unsigned char* out, size_t outlen);
+#endif
+
+/*
+ * Copy the complete state of the digest context in to out.
+ */
+void _EVP_MD_CTX_copy_ex(EVP_MD_CTX* out, const EVP_MD_CTX* in);
+
 /**
  * Create a new EVP_PKEY instance.
  *
@@ -266,6 +329,15 @@ void _EVP_MD_CTX_init(EVP_MD_CTX* ctx);
  */
 SSL_EVP_PKEY_Ptr _EVP_PKEY_new();
 
+/**
+ * Create an EVP_PKEY of the given type from a raw private key, e.g. a Poly1305 key.
+ *
+ * @throw OpenSSLException if the key type doesn't support raw keys or the key is invalid.
+ */
+SSL_EVP_PKEY_Ptr _EVP_PKEY_new_raw_private_key(int type,
+                                               const unsigned char* key,
+                                               size_t keyLength);
+
 /**
  * Create a new X509_REQ instance.
  *
@@ -635,6 +707,36 @@ void _X509_REQ_sign_ctx(X509_REQ* req, EVP_MD_CTX* ctx);
  */
 const EVP_MD* _getMDPtrFromDigestType(DigestTypes type);
 
+/**
+ * Get the message digest descriptor for an extendable-output function.
+ *
+ * @throw std::runtime_error if the XOF type is unknown
+ */
+const EVP_MD* _getMDPtrFromXofType(XofTypes type);
+
+/**
+ * Get the explicitly fetched implementation of a digest.
+ *
+ * With OpenSSL 3, passing a legacy object like EVP_sha256() to EVP_DigestInit_ex() and similar
+ * functions fetches the implementation from the provider on every call, which takes a global
+ * lock. The implementations are therefore fetched once per algorithm and library context and
+ * kept until the process exits. With OpenSSL 1.1.1, \c md is returned unchanged.
+ *
+ * _getMDPtrFromDigestType() and _getMDPtrFromXofType() already return fetched digests.
+ *
+ * @param md a legacy digest object, e.g. EVP_sha256()
+ * @return the fetched digest, or \c md if it can't be fetched
+ */
+const EVP_MD* _fetchCachedMD(const EVP_MD* md);
+
+/**
+ * Get the explicitly fetched implementation of a cipher (@see _fetchCachedMD).
+ *
+ * @param cipher a legacy cipher object, e.g. EVP_aes_256_gcm()
+ * @return the fetched cipher, or \c cipher if it can't be fetched
+ */
+const EVP_CIPHER* _fetchCachedCipher(const EVP_CIPHER* cipher);
+
 /**
  * Create an MD_CTX object.
  *
@@ -790,6 +892,21 @@ void _X509_VERIFY_PARAM_set_flags(X509_VERIFY_PARAM* param, unsigned long flags)
  */
 void _X509_verify_cert(X509_STORE_CTX* ctx);
 
+/**
+ * Verify an X509 certificate with the given certification context without throwing if the
+ * verification fails.
+ *
+ * @param ctx The context to verify
+ *
+ * @return X509_V_OK if the certificate is valid, otherwise the verification error of the context
+ */
+int _X509_tryVerifyCert(X509_STORE_CTX* ctx);
+
+/**
+ * Get the description of an X509 verification error code.
+ */
+std::string _X509_verify_cert_error_string(long error);
+
 /**
  * Wrapper to create openssl objects
  *
@@ -986,6 +1103,14 @@ SSL_EVP_CIPHER_CTX_Ptr _EVP_CIPHER_CTX_new();
  */
 void _EVP_CIPHER_CTX_reset(EVP_CIPHER_CTX* ctx);
 
+/**
+ * Copy the complete state of a cipher context, including the expanded key.
+ *
+ * @param out initialized destination context
+ * @param in source context
+ */
+void _EVP_CIPHER_CTX_copy(EVP_CIPHER_CTX* out, const EVP_CIPHER_CTX* in);
+
 /**
  * Allows various cipher specific parameters to be determined and set
  */
@@ -1060,6 +1185,16 @@ int _EVP_CIPHER_CTX_key_length(const EVP_CIPHER_CTX* ctx);
  */
 int _EVP_CIPHER_CTX_iv_length(const EVP_CIPHER_CTX* ctx);
 
+/**
+ * Get the block size of a cipher.
+ *
+ * Stream ciphers and stream modes such as CTR and GCM have a block size of 1.
+ *
+ * @param ctx cipher context
+ * @return block size of the cipher in bytes.
+ */
+int _EVP_CIPHER_CTX_block_size(const EVP_CIPHER_CTX* ctx);
+
 /**
  * Enables or disables padding.
  *
@@ -1257,6 +1392,20 @@ void _EVP_PKEY_verify(EVP_PKEY_CTX* ctx,
                       const unsigned char* tbs,
                       size_t tbslen);
 
+/**
+ * Performs a signature verification without throwing if the signature is invalid.
+ *
+ * OpenSSL reports a malformed signature as an error. Errors of the verification are therefore
+ * treated as an invalid signature and removed from the error queue.
+ *
+ * @return true if the signature is valid
+ */
+bool _EVP_PKEY_tryVerify(EVP_PKEY_CTX* ctx,
+                         const unsigned char* sig,
+                         size_t siglen,
+                         const unsigned char* tbs,
+                         size_t tbslen);
+
 /**
  * Initialize the MD_CTX for signing, using a given digest-type and a given
  * public key.
@@ -1286,6 +1435,21 @@ void _EVP_DigestSign(EVP_MD_CTX* ctx,
                      const unsigned char* message,
                      size_t messageLength);
 
+/**
+ * Finish a streaming signature or MAC whose data was passed with _EVP_DigestUpdate.
+ *
+ * @param ctx The context used for signing.
+ * @param signatureBuffer The buffer to write the signature to. If it is nullptr, only the
+ *                        maximum length is written to signatureBufferLength.
+ * @param signatureBufferLength The capacity of signatureBuffer on input, the length of the
+ *                              signature on output.
+ *
+ * @throw OpenSSLException if an error occurs in the underlying OpenSSL function.
+ */
+void _EVP_DigestSignFinal(EVP_MD_CTX* ctx,
+                          unsigned char* signatureBuffer,
+                          size_t* signatureBufferLength);
+
 /**
  * Initialize the MD_CTX for verification, using a given digest-type and a given
  * public key.
@@ -1314,6 +1478,19 @@ void _EVP_DigestVerify(EVP_MD_CTX* ctx,
                        size_t signatureLength,
                        const unsigned char* message,
                        size_t messageLength);
+
+/**
+ * Like _EVP_DigestVerify, but an invalid or malformed signature is reported by the return value
+ * instead of an exception (@see _EVP_PKEY_tryVerify).
+ *
+ * @return true if the signature is valid
+ */
+bool _EVP_DigestTryVerify(EVP_MD_CTX* ctx,
+                          const unsigned char* signature,
+                          size_t signatureLength,
+                          const unsigned char* message,
+                          size_t messageLength);
+
 /**
  * Sets the RSA padding
  */
@@ -1432,17 +1609,39 @@ void _PKCS5_PBKDF2_HMAC(const std::vector<uint8_t> pass,
                         int iter,
                         const EVP_MD* digest,
                         std::vector<uint8_t>& out);
+void _PKCS5_PBKDF2_HMAC(const uint8_t* pass,
+                        size_t passLength,
+                        const uint8_t* salt,
+                        size_t saltLength,
+                        int iter,
+                        const EVP_MD* digest,
+                        std::vector<uint8_t>& out);
 
 void _ECDH_KDF_X9_63(std::vector<uint8_t>& out,
                      const std::vector<uint8_t>& Z,
                      const std::vector<uint8_t>& sinfo,
                      const EVP_MD* md);
+void _ECDH_KDF_X9_63(std::vector<uint8_t>& out,
+                     const uint8_t* Z,
+                     size_t ZLength,
+                     const uint8_t* sinfo,
+                     size_t sinfoLength,
+                     const EVP_MD* md);
 
 /* HMAC */
 void _HMAC_Init_ex(HMAC_CTX* ctx, const std::vector<uint8_t>& key, const EVP_MD* md, ENGINE* impl);
+void _HMAC_Init_ex(
+        HMAC_CTX* ctx, const uint8_t* key, size_t keyLength, const EVP_MD* md, ENGINE* impl);
 std::vector<uint8_t> _HMAC_Final(HMAC_CTX* ctx);
 void _HMAC_Update(HMAC_CTX* ctx, const std::vector<uint8_t>& data);
+void _HMAC_Update(HMAC_CTX* ctx, const uint8_t* data, size_t length);
 SSL_HMAC_CTX_Ptr _HMAC_CTX_new(void);
+/**
+ * Restarts the MAC computation with the key and digest of the last initialization. The
+ * key-dependent inner and outer pads are not recomputed.
+ */
+void _HMAC_reinit(HMAC_CTX* ctx);
+SSL_HMAC_CTX_Ptr _HMAC_CTX_copy(HMAC_CTX* ctx);
 
 /* CMAC */
 SSL_CMAC_CTX_Ptr _CMAC_CTX_new(void);
@@ -1450,8 +1649,20 @@ void _CMAC_Init(CMAC_CTX* ctx,
                 const std::vector<uint8_t>& key,
                 const EVP_CIPHER* cipher,
                 ENGINE* impl);
+void _CMAC_Init(CMAC_CTX* ctx,
+                const uint8_t* key,
+                size_t keyLength,
+                const EVP_CIPHER* cipher,
+                ENGINE* impl);
 void _CMAC_Update(CMAC_CTX* ctx, const std::vector<uint8_t>& data);
+void _CMAC_Update(CMAC_CTX* ctx, const uint8_t* data, size_t length);
 std::vector<uint8_t> _CMAC_Final(CMAC_CTX* ctx);
+/**
+ * Restarts the MAC computation with the key and cipher of the last initialization. The
+ * key schedule and subkeys are not recomputed.
+ */
+void _CMAC_reinit(CMAC_CTX* ctx);
+SSL_CMAC_CTX_Ptr _CMAC_CTX_copy(const CMAC_CTX* ctx);
 const EVP_CIPHER* _getCipherPtrFromCmacCipherType(CmacCipherTypes cipherType);
 
 SSL_EC_KEY_Ptr _EC_KEY_oct2key(int nid, const std::vector<uint8_t>& buf);
@@ -0,0 +1,114 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace mococrw
+{
+namespace detail
+{
+/**
+ * Determine the number of worker threads to use for the given amount of work items.
+ *
+ * A requested thread count of 0 selects the number of hardware threads. The result is never
+ * larger than the number of work items and never smaller than 1.
+ */
+inline unsigned int resolveThreadCount(unsigned int requestedThreads, size_t workItems)
+{
+    unsigned int threads = requestedThreads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (workItems < threads) {
+        threads = static_cast<unsigned int>(std::max<size_t>(1, workItems));
+    }
+    return threads;
+}
+
+/**
+ * Invoke func(i) for every i in [0, count) on up to numberOfThreads threads.
+ *
+ * Work items are handed out dynamically, so differently expensive items are balanced across the
+ * workers. The calling thread takes part in the processing. If any invocation throws, the
+ * remaining items are skipped and the first exception is rethrown in the calling thread once
+ * all workers have stopped.
+ */
+template <class Func>
+void parallelFor(size_t count, unsigned int numberOfThreads, Func &&func)
+{
+    auto threads = resolveThreadCount(numberOfThreads, count);
+    if (threads == 1) {
+        for (size_t i = 0; i < count; i++) {
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> nextItem{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        while (!failed.load(std::memory_order_relaxed)) {
+            size_t item = nextItem.fetch_add(1, std::memory_order_relaxed);
+            if (item >= count) {
+                return;
+            }
+            try {
+                func(item);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned int i = 0; i < threads - 1; i++) {
+        try {
+            workers.emplace_back(worker);
+        } catch (const std::system_error &) {
+            /* Continue with the threads we already have; the calling thread works as well. */
+            break;
+        }
+    }
+    worker();
+    for (auto &thread : workers) {
+        thread.join();
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+}  // namespace detail
+}  // namespace mococrw
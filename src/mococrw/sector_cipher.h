@@ -0,0 +1,128 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "mococrw/openssl_wrap.h"
+#include "mococrw/symmetric_crypto.h"
+
+namespace mococrw
+{
+/**
+ * @brief AES-XTS encryption of sector-addressed storage (IEEE 1619)
+ *
+ * Every sector is encrypted independently with a tweak derived from its index, so single
+ * sectors can be read and rewritten without touching their neighbours and without storing IVs
+ * or tags. The sector index is encoded as a 128 bit little endian tweak as defined in IEEE 1619.
+ *
+ * XTS provides confidentiality only. It does not detect modified or replayed sectors.
+ *
+ * All methods are const and may be called concurrently. The input and output buffers may be
+ * identical for in-place processing of e.g. page-aligned I/O buffers.
+ *
+ * @code
+ *   AESXTSSectorCipher cipher{SymmetricCipherKeySize::S_256, key, 4096};
+ *   cipher.encryptSectors(firstSector, buffer, bufferLength, buffer);
+ * @endcode
+ */
+class AESXTSSectorCipher
+{
+public:
+    /**
+     * Default sector size (4 KiB)
+     */
+    static const size_t DefaultSectorSize;
+
+    /**
+     * Maximum sector size (16 MiB), the largest data unit allowed by IEEE 1619
+     */
+    static const size_t MaxSectorSize;
+
+    /**
+     * @param keySize S_128 for XTS-AES-128 (256 bit key) or S_256 for XTS-AES-256 (512 bit key)
+     * @param key the XTS key consisting of the data key and the tweak key. Both halves must
+     *            differ.
+     * @param sectorSize the size of a sector in bytes. Must be at least one AES block (16 bytes)
+     *                   and at most MaxSectorSize.
+     * @throws MoCOCrWException if the key or sector size is invalid
+     */
+    AESXTSSectorCipher(SymmetricCipherKeySize keySize,
+                       const std::vector<uint8_t> &key,
+                       size_t sectorSize = DefaultSectorSize);
+
+    /**
+     * @brief Encrypt a single sector
+     *
+     * @param sectorIndex the index of the sector
+     * @param in the plaintext of the sector (getSectorSize() bytes)
+     * @param out output buffer of getSectorSize() bytes. May be equal to \c in.
+     */
+    void encryptSector(uint64_t sectorIndex, const uint8_t *in, uint8_t *out) const;
+
+    /**
+     * @brief Decrypt a single sector
+     *
+     * @sa encryptSector()
+     */
+    void decryptSector(uint64_t sectorIndex, const uint8_t *in, uint8_t *out) const;
+
+    /**
+     * @brief Encrypt consecutive sectors on multiple threads
+     *
+     * @param firstSectorIndex the index of the first sector in \c in
+     * @param in the plaintext of the sectors
+     * @param length the length of \c in. Must be a multiple of getSectorSize().
+     * @param out output buffer of \c length bytes. May be equal to \c in.
+     * @param numberOfThreads number of threads. 0 selects the number of hardware threads.
+     * @throws MoCOCrWException if the length is not a multiple of the sector size
+     */
+    void encryptSectors(uint64_t firstSectorIndex,
+                        const uint8_t *in,
+                        size_t length,
+                        uint8_t *out,
+                        unsigned int numberOfThreads = 0) const;
+
+    /**
+     * @brief Decrypt consecutive sectors on multiple threads
+     *
+     * @sa encryptSectors()
+     */
+    void decryptSectors(uint64_t firstSectorIndex,
+                        const uint8_t *in,
+                        size_t length,
+                        uint8_t *out,
+                        unsigned int numberOfThreads = 0) const;
+
+    size_t getSectorSize() const { return _sectorSize; }
+
+private:
+    void _processSectors(bool encrypt,
+                         uint64_t firstSectorIndex,
+                         const uint8_t *in,
+                         size_t length,
+                         uint8_t *out,
+                         unsigned int numberOfThreads) const;
+
+    size_t _sectorSize;
+    openssl::SSL_EVP_CIPHER_CTX_Ptr _encryptionCtx;
+    openssl::SSL_EVP_CIPHER_CTX_Ptr _decryptionCtx;
+};
+
+}  // namespace mococrw
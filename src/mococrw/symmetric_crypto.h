@@ -19,18 +19,28 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <vector>
 
+#include "byte_view.h"
 #include "openssl_wrap.h"
+#include "symmetric_memory.h"
 
 namespace mococrw
 {
 /**
  * SymmetricCipherMode defines symmetric cipher modes supported by the library.
+ *
+ * GCM, CBC and CTR are AES modes. CHACHA20_POLY1305 (RFC 8439) is an authenticated cipher which
+ * is considerably faster than AES-GCM on CPUs without AES instructions. It only supports
+ * SymmetricCipherKeySize::S_256 and 96 bit nonces and is created with the same builders as the
+ * AES modes.
  */
-enum class SymmetricCipherMode { GCM, CBC, CTR };
+enum class SymmetricCipherMode { GCM, CBC, CTR, CHACHA20_POLY1305 };
 
 /**
  * Supported key lengths for symmetric cipher
@@ -49,6 +59,13 @@ enum class SymmetricCipherPadding { NO, PKCS };
  */
 size_t getSymmetricCipherKeySize(SymmetricCipherKeySize keySize);
 
+/**
+ * Factory for the memory strategy in which a cipher buffers its output until it is read.
+ *
+ * @sa AESCipherBuilder::setMemoryStrategy()
+ */
+using CipherMemoryStrategyFactory = std::function<std::unique_ptr<CipherMemoryStrategyI>()>;
+
 /**
  * Abstract interface for symmetric encryption and decryption.
  *
@@ -93,13 +110,22 @@ public:
      */
     virtual void update(const std::vector<uint8_t> &message) = 0;
 
+    /**
+     * Decrypt or encrypt a chunk of data referenced by a ByteView.
+     *
+     * The ciphers of MoCOCrW read the data in place. The default implementation for other
+     * implementations of this interface copies the data and calls
+     * update(const std::vector<uint8_t>&).
+     */
+    virtual void update(ByteView message);
+
     /**
      * Read a portion of encrypted/decrypted data from cipher buffer.
      *
      * Depending on the (internal) memory strategy and the size of read chunk, performance of this
-     * method will vary. The current version uses queue of vectors as internal buffer. Therefore,
+     * method will vary. By default, a queue of vectors is used as internal buffer. Therefore,
      * alternating update() and read() of data blocks of the same size (or readAll()) are zero-copy
-     * operations.
+     * operations. See AESCipherBuilder::setMemoryStrategy() for alternatives.
      *
      * @param length size of the requested chunk of data.
      * @return processed chunk of \c length or smaller.
@@ -197,9 +223,19 @@ public:
      * @param associatedData chunk of data to associate/verify.
      */
     virtual void addAssociatedData(const std::vector<uint8_t> &associatedData) = 0;
+
+    /**
+     * Add associated data referenced by a ByteView.
+     *
+     * The default implementation copies the data and calls
+     * addAssociatedData(const std::vector<uint8_t>&).
+     */
+    virtual void addAssociatedData(ByteView associatedData);
 };
 
 class AESCipherBuilder;
+class AESKey;
+struct AEADRecord;
 
 /**
  * AES cipher
@@ -213,13 +249,76 @@ public:
 
     // Implementation of SymmetricCipherI
     void update(const std::vector<uint8_t> &message) override;
+    void update(ByteView message) override;
     std::vector<uint8_t> read(size_t length) override;
     std::vector<uint8_t> readAll() override;
     std::vector<uint8_t> finish() override;
     std::vector<uint8_t> getIV() const override;
 
+    /**
+     * Encrypt or decrypt as much of a chunk of data as the memory strategy can take.
+     *
+     * In contrast to update(), this method never fails because the memory strategy signals
+     * backpressure (see BoundedMemoryStrategy). Instead, only a prefix of the message is processed
+     * and the caller has to pass the remainder again after reading processed data with
+     * read()/readAll(). With unbounded memory strategies, the whole message is always accepted.
+     *
+     * @param message chunk of data to encrypt/decrypt.
+     * @throws MoCOCrWException if finish() was already called
+     * @return the number of bytes of \c message which were processed
+     */
+    size_t tryUpdate(const std::vector<uint8_t> &message);
+    size_t tryUpdate(const uint8_t *message, size_t length);
+
+    /**
+     * Encrypt or decrypt a chunk of data directly into caller-provided memory.
+     *
+     * In contrast to update(const std::vector<uint8_t>&), the processed data is not placed in the
+     * internal buffer, so this method doesn't allocate any memory. For CTR and GCM the output may
+     * be written in place, i.e. \c out may be equal to \c in (partially overlapping buffers are
+     * not allowed).
+     *
+     * @note Don't mix this method with update(const std::vector<uint8_t>&) unless all data of the
+     * internal buffer was consumed with read()/readAll().
+     *
+     * @param in the data to encrypt/decrypt
+     * @param length length of the data in bytes
+     * @param out buffer receiving the processed data
+     * @param outCapacity size of \c out. Must be at least getMaxUpdateOutputLength(length)
+     * @throws MoCOCrWException if the output buffer is too small or finish() was already called
+     * @return the number of bytes written to \c out
+     */
+    size_t update(const uint8_t *in, size_t length, uint8_t *out, size_t outCapacity);
+
+    /**
+     * Finalize encryption/decryption writing any remaining data to caller-provided memory.
+     *
+     * This is the counterpart of update(const uint8_t*, size_t, uint8_t*, size_t). It does not
+     * return data left in the internal buffer.
+     *
+     * @param out buffer receiving the remaining processed data (e.g. the last padded block in CBC
+     *            mode)
+     * @param outCapacity size of \c out. Must be at least getMaxFinishOutputLength()
+     * @throws MoCOCrWException if the output buffer is too small, finish() was already called or
+     *         auth tag validation fails on decryption.
+     * @return the number of bytes written to \c out
+     */
+    size_t finish(uint8_t *out, size_t outCapacity);
+
+    /**
+     * Get the size of the output buffer required for processing \c length bytes with
+     * update(const uint8_t*, size_t, uint8_t*, size_t).
+     */
+    size_t getMaxUpdateOutputLength(size_t length) const;
+
+    /**
+     * Get the size of the output buffer required by finish(uint8_t*, size_t).
+     */
+    size_t getMaxFinishOutputLength() const;
+
 protected:
     friend AESCipherBuilder;
+    friend AESKey;
 
     enum class Operation { Encryption, Decryption };
 
@@ -228,6 +327,13 @@ protected:
               SymmetricCipherPadding padding,
               const std::vector<uint8_t> &secretKey,
               const std::vector<uint8_t> &iv,
+              Operation operation,
+              std::unique_ptr<CipherMemoryStrategyI> memoryStrategy = nullptr);
+
+    AESCipher(SymmetricCipherMode mode,
+              const EVP_CIPHER_CTX *keyCtx,
+              SymmetricCipherPadding padding,
+              const std::vector<uint8_t> &iv,
               Operation operation);
 
     class Impl;
@@ -248,9 +354,11 @@ public:
     std::vector<uint8_t> getAuthTag() const override;
     void setAuthTag(const std::vector<uint8_t> &tag) override;
     void addAssociatedData(const std::vector<uint8_t> &associatedData) override;
+    void addAssociatedData(ByteView associatedData) override;
 
 private:
     friend AESCipherBuilder;
+    friend AESKey;
 
     AuthenticatedAESCipher(SymmetricCipherMode mode,
                            SymmetricCipherKeySize keySize,
@@ -258,6 +366,13 @@ private:
                            const std::vector<uint8_t> &secretKey,
                            const std::vector<uint8_t> &iv,
                            size_t authTagLength,
+                           AESCipher::Operation operation,
+                           std::unique_ptr<CipherMemoryStrategyI> memoryStrategy = nullptr);
+
+    AuthenticatedAESCipher(SymmetricCipherMode mode,
+                           const EVP_CIPHER_CTX *keyCtx,
+                           const std::vector<uint8_t> &iv,
+                           size_t authTagLength,
                            AESCipher::Operation operation);
 };
 
@@ -307,8 +422,8 @@ public:
      * When creating a cipher, this method can be used to provide the IV. If a cipher is created for
      * decryption, calling this method is mandatory. If the cipher is created for encryption,
      * a random IV of the default IV length as used in TLS (128 bit for AES-CBC and AES-CTR, 96 bit
-     * for AES-GCM) is generated by the builder by default. Users can still can override the default
-     * IV with their own values.
+     * for AES-GCM and ChaCha20-Poly1305) is generated by the builder by default. Users can still
+     * can override the default IV with their own values.
      *
      * @note If you set a custom IV for encryption, make sure that it is supported by the type of
      * cipher you are building. Also, use cryptographically secure IVs using
@@ -346,6 +461,29 @@ public:
      */
     AESCipherBuilder &setAuthTagLength(size_t length);
 
+    /**
+     * Set the memory strategy of the created ciphers.
+     *
+     * The memory strategy buffers the output of SymmetricCipherI::update() until it is consumed
+     * with read()/readAll(). By default, a QueueOfVectorsMemoryStrategy is used which is optimal
+     * if the data is read in the same chunks in which it was written. If the output is consumed in
+     * many small reads, RingBufferMemoryStrategy is the better choice.
+     *
+     * @code
+     * auto decryptor = AESCipherBuilder{SymmetricCipherMode::CTR, SymmetricCipherKeySize::S_256,
+     *                                   secretKey}
+     *                          .setIV(iv)
+     *                          .setMemoryStrategy([]() {
+     *                              return std::make_unique<RingBufferMemoryStrategy>();
+     *                          })
+     *                          .buildDecryptor();
+     * @endcode
+     *
+     * @param factory called once for every cipher created by this builder.
+     * @return builder instance
+     */
+    AESCipherBuilder &setMemoryStrategy(CipherMemoryStrategyFactory factory);
+
     /**
      * Create cipher for encryption.
      *
@@ -363,7 +501,8 @@ public:
     /**
      * Create authenticated cipher for encryption.
      *
-     * This method must be called to build authenticated cipher such as SymmetricCipherMode::GCM.
+     * This method must be called to build authenticated cipher such as SymmetricCipherMode::GCM
+     * or SymmetricCipherMode::CHACHA20_POLY1305.
      *
      * @return encryptor
      */
@@ -372,7 +511,8 @@ public:
     /**
      * Create authenticated cipher for decryption.
      *
-     * This method must be called to build authenticated cipher such as SymmetricCipherMode::GCM.
+     * This method must be called to build authenticated cipher such as SymmetricCipherMode::GCM
+     * or SymmetricCipherMode::CHACHA20_POLY1305.
      *
      * @return decryptor
      */
@@ -387,8 +527,479 @@ private:
     SymmetricCipherPadding _padding = SymmetricCipherPadding::PKCS;
     std::vector<uint8_t> _secretKey;
     size_t _authTagLength = DefaultAuthTagLength;
+    CipherMemoryStrategyFactory _memoryStrategyFactory;
+
+    std::unique_ptr<CipherMemoryStrategyI> _createMemoryStrategy() const;
+};
+
+/**
+ * AES key with a pre-computed key schedule.
+ *
+ * AESCipherBuilder expands the secret key for every cipher it builds. When many short messages
+ * are processed with the same key, this key setup dominates the cost. An AESKey expands the key
+ * once and creates ciphers which only need a new IV.
+ *
+ * The create*() methods don't modify the key and may be called concurrently. Nevertheless, a
+ * cheap copy for every worker thread can be created with clone().
+ *
+ * @code
+ * AESKey key{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, secretKey};
+ * for (auto &message : messages) {
+ *     auto encryptor = key.createAuthenticatedEncryptor(nextIV());
+ *     ...
+ * }
+ * @endcode
+ *
+ * @note The caller is responsible for never reusing an IV with the same key.
+ */
+class AESKey
+{
+public:
+    /**
+     * Default length of the authentication tag in bytes (128 bit).
+     */
+    static const size_t DefaultAuthTagLength;
+
+    /**
+     * Expand the secret key.
+     *
+     * @param mode cipher mode of operation.
+     * @param keySize key size of AES cipher (128 or 256 bits)
+     * @param secretKey secret key. Size of the key must match \c keySize.
+     * @throws MoCOCrWException if the size of the key is invalid
+     */
+    AESKey(SymmetricCipherMode mode,
+           SymmetricCipherKeySize keySize,
+           const std::vector<uint8_t> &secretKey);
+
+    /**
+     * Copying an AESKey copies the expanded key. It is not expanded again.
+     */
+    AESKey(const AESKey &other);
+    AESKey &operator=(const AESKey &other);
+    AESKey(AESKey &&other);
+    AESKey &operator=(AESKey &&other);
+
+    /**
+     * Destructor, the expanded key is cleansed by OpenSSL.
+     */
+    ~AESKey();
+
+    /**
+     * Create an independent copy of the key, e.g. for use in another thread.
+     */
+    AESKey clone() const;
+
+    SymmetricCipherMode getMode() const { return _mode; }
+    SymmetricCipherKeySize getKeySize() const { return _keySize; }
+
+    /**
+     * Create cipher for encryption.
+     *
+     * @param iv the IV of the message. Use a fresh IV for every message.
+     * @param padding type of padding.
+     * @throws MoCOCrWException if the mode is an authenticated mode or the IV is invalid
+     */
+    std::unique_ptr<AESCipher> createEncryptor(
+            const std::vector<uint8_t> &iv,
+            SymmetricCipherPadding padding = SymmetricCipherPadding::PKCS) const;
+
+    /**
+     * Create cipher for decryption.
+     *
+     * @throws MoCOCrWException if the mode is an authenticated mode or the IV is invalid
+     */
+    std::unique_ptr<AESCipher> createDecryptor(
+            const std::vector<uint8_t> &iv,
+            SymmetricCipherPadding padding = SymmetricCipherPadding::PKCS) const;
+
+    /**
+     * Create authenticated cipher for encryption.
+     *
+     * @param iv the IV of the message. Use a fresh IV for every message.
+     * @param authTagLength length of the authentication tag in bytes.
+     * @throws MoCOCrWException if the mode is not an authenticated mode or the IV is invalid
+     */
+    std::unique_ptr<AuthenticatedAESCipher> createAuthenticatedEncryptor(
+            const std::vector<uint8_t> &iv, size_t authTagLength = DefaultAuthTagLength) const;
+
+    /**
+     * Create authenticated cipher for decryption.
+     *
+     * @throws MoCOCrWException if the mode is not an authenticated mode or the IV is invalid
+     */
+    std::unique_ptr<AuthenticatedAESCipher> createAuthenticatedDecryptor(
+            const std::vector<uint8_t> &iv) const;
+
+    /**
+     * Encrypt a complete message on multiple threads (AES-CTR only).
+     *
+     * The message is split into segments of BulkSegmentSize bytes. Every segment is encrypted
+     * independently with the counter block of its first AES block. The result is byte-identical
+     * to the output of an encryptor created with createEncryptor(iv).
+     *
+     * @param iv the initial counter block
+     * @param in the plaintext
+     * @param length length of the plaintext
+     * @param out output buffer of at least \c length bytes. May be equal to \c in.
+     * @param outCapacity size of the output buffer
+     * @param numberOfThreads number of threads. 0 selects the number of hardware threads.
+     * @return the number of bytes written
+     * @throws MoCOCrWException if the mode is not CTR or a parameter is invalid
+     */
+    size_t bulkEncrypt(const std::vector<uint8_t> &iv,
+                       const uint8_t *in,
+                       size_t length,
+                       uint8_t *out,
+                       size_t outCapacity,
+                       unsigned int numberOfThreads = 0) const;
+
+    std::vector<uint8_t> bulkEncrypt(const std::vector<uint8_t> &iv,
+                                     const std::vector<uint8_t> &plaintext,
+                                     unsigned int numberOfThreads = 0) const;
+
+    /**
+     * Decrypt a complete message on multiple threads (AES-CTR and AES-CBC).
+     *
+     * The message is split into segments of BulkSegmentSize bytes. For CTR, every segment starts
+     * with its own counter block. For CBC, the IV of a segment is the last ciphertext block of
+     * the preceding segment. The padding is removed from the last segment only. The result is
+     * byte-identical to the output of a decryptor created with createDecryptor(iv, padding).
+     *
+     * @param iv the IV (CBC) or initial counter block (CTR)
+     * @param in the ciphertext. For CBC, its length must be a multiple of the block size.
+     * @param length length of the ciphertext
+     * @param out output buffer of at least \c length bytes. May be equal to \c in.
+     * @param outCapacity size of the output buffer
+     * @param padding type of padding (CBC only).
+     * @param numberOfThreads number of threads. 0 selects the number of hardware threads.
+     * @return the length of the plaintext
+     * @throws MoCOCrWException if the mode is authenticated, a parameter is invalid or the
+     *                          padding is invalid
+     */
+    size_t bulkDecrypt(const std::vector<uint8_t> &iv,
+                       const uint8_t *in,
+                       size_t length,
+                       uint8_t *out,
+                       size_t outCapacity,
+                       SymmetricCipherPadding padding = SymmetricCipherPadding::PKCS,
+                       unsigned int numberOfThreads = 0) const;
+
+    std::vector<uint8_t> bulkDecrypt(
+            const std::vector<uint8_t> &iv,
+            const std::vector<uint8_t> &ciphertext,
+            SymmetricCipherPadding padding = SymmetricCipherPadding::PKCS,
+            unsigned int numberOfThreads = 0) const;
+
+    /**
+     * Size of the segments processed by one worker in bulkEncrypt() and bulkDecrypt() (1 MiB).
+     */
+    static const size_t BulkSegmentSize;
+
+private:
+    friend class SeekableCTRDecryptor;
+    friend size_t aeadSeal(const AESKey &key,
+                           const uint8_t *nonce,
+                           size_t nonceLength,
+                           const uint8_t *associatedData,
+                           size_t associatedDataLength,
+                           const uint8_t *plaintext,
+                           size_t plaintextLength,
+                           uint8_t *out,
+                           size_t outCapacity,
+                           size_t authTagLength);
+    friend std::vector<size_t> aeadSealBatch(const AESKey &key,
+                                             const std::vector<AEADRecord> &records,
+                                             uint8_t *out,
+                                             size_t outCapacity,
+                                             size_t authTagLength,
+                                             unsigned int numberOfThreads);
+    friend size_t aeadOpen(const AESKey &key,
+                           const uint8_t *nonce,
+                           size_t nonceLength,
+                           const uint8_t *associatedData,
+                           size_t associatedDataLength,
+                           const uint8_t *sealed,
+                           size_t sealedLength,
+                           uint8_t *out,
+                           size_t outCapacity,
+                           size_t authTagLength);
+
+    SymmetricCipherMode _mode;
+    SymmetricCipherKeySize _keySize;
+    openssl::SSL_EVP_CIPHER_CTX_Ptr _encryptionCtx;
+    openssl::SSL_EVP_CIPHER_CTX_Ptr _decryptionCtx;
+
+    const EVP_CIPHER_CTX *_getEncryptionCtx() const;
+    const EVP_CIPHER_CTX *_getDecryptionCtx() const;
+    void _checkBulkParameters(const std::vector<uint8_t> &iv,
+                              size_t length,
+                              size_t outCapacity) const;
+};
+
+/**
+ * Random access decryption of AES-CTR ciphertexts.
+ *
+ * In CTR mode the key stream of every byte only depends on the key, the initial counter block
+ * and the position of the byte. Instead of decrypting everything in front of a record, the
+ * counter block of the requested position is computed directly and only the requested range is
+ * decrypted.
+ *
+ * decrypt() doesn't modify the object. Ranges can be read concurrently from multiple threads
+ * with the same instance.
+ *
+ * @code
+ * SeekableCTRDecryptor decryptor{key, iv};
+ * auto record = decryptor.decrypt(recordOffset, ciphertextOfRecord);
+ * @endcode
+ */
+class SeekableCTRDecryptor
+{
+public:
+    /**
+     * @param key the key. Its mode must be SymmetricCipherMode::CTR.
+     * @param iv the initial counter block of the message (16 bytes)
+     * @throws MoCOCrWException if the mode of the key is not CTR or the IV is invalid
+     */
+    SeekableCTRDecryptor(const AESKey &key, const std::vector<uint8_t> &iv);
+
+    /**
+     * Decrypt a range of the ciphertext.
+     *
+     * @param offset the position of the first byte of the range within the message
+     * @param in the ciphertext of the range
+     * @param length the length of the range
+     * @param out output buffer of at least \c length bytes. May be equal to \c in.
+     */
+    void decrypt(uint64_t offset, const uint8_t *in, size_t length, uint8_t *out) const;
+
+    std::vector<uint8_t> decrypt(uint64_t offset, const std::vector<uint8_t> &ciphertext) const;
+
+private:
+    AESKey _key;
+    std::vector<uint8_t> _iv;
+};
+
+/**
+ * Deterministic nonces for AES-GCM and ChaCha20-Poly1305 (NIST SP 800-38D, section 8.2.1).
+ *
+ * A 96 bit nonce consists of a 32 bit fixed field followed by a 64 bit big endian invocation
+ * counter. Creating a nonce only increments an atomic counter. There is no call into the random
+ * number generator, so it is cheaper than utility::cryptoRandomBytes() on the encryption hot
+ * path. One instance can be shared by all threads encrypting with the same key.
+ *
+ * Nonces are only unique as long as every key is used with a single sequencer, or with
+ * sequencers that have different fixed fields (e.g. one per device). The sequencer can't be
+ * copied because a copy would repeat the nonces. If a key outlives the process, the invocation
+ * count must be persisted and passed as initialInvocationCount on the next start.
+ *
+ * @code
+ * GCMNonceSequencer nonces{fixedField};
+ * auto encryptor = key.createAuthenticatedEncryptor(nonces.next());
+ * @endcode
+ */
+class GCMNonceSequencer
+{
+public:
+    static const size_t NonceLength;
+    static const size_t FixedFieldLength;
+
+    /**
+     * @param fixedField identifies the context (e.g. the device) which encrypts with the key.
+     *                   Must be FixedFieldLength (4) bytes long.
+     * @param initialInvocationCount the counter value of the first nonce
+     * @param invocationLimit the maximum number of nonces that may be created with the key.
+     *                        next() throws once the counter reached the limit.
+     * @throws MoCOCrWException if the fixed field has the wrong length
+     */
+    explicit GCMNonceSequencer(const std::vector<uint8_t> &fixedField,
+                               uint64_t initialInvocationCount = 0,
+                               uint64_t invocationLimit = std::numeric_limits<uint64_t>::max());
+
+    GCMNonceSequencer(const GCMNonceSequencer &) = delete;
+    GCMNonceSequencer &operator=(const GCMNonceSequencer &) = delete;
+
+    /**
+     * Create the next nonce.
+     *
+     * @param nonce output buffer of NonceLength (12) bytes
+     * @throws MoCOCrWException if the invocation limit is reached
+     */
+    void next(uint8_t *nonce);
+
+    /**
+     * @sa next(uint8_t*)
+     */
+    std::vector<uint8_t> next();
+
+    /**
+     * @return the number of nonces created so far, including initialInvocationCount
+     */
+    uint64_t getInvocationCount() const;
+
+    uint64_t getInvocationLimit() const { return _invocationLimit; }
+
+private:
+    uint8_t _fixedField[4];
+    std::atomic<uint64_t> _invocationCount;
+    const uint64_t _invocationLimit;
+};
+
+/**
+ * Encrypt and authenticate a message in one call.
+ *
+ * This is a shortcut for small messages which avoids creating an AuthenticatedAESCipher and its
+ * memory strategy. The result is allocated in a single buffer containing the ciphertext followed
+ * by the authentication tag.
+ *
+ * @code
+ * AESKey key{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, secretKey};
+ * auto sealed = aeadSeal(key, nonce, associatedData, plaintext);
+ * auto plaintext = aeadOpen(key, nonce, associatedData, sealed);
+ * @endcode
+ *
+ * @param key the key. Its mode must be an authenticated cipher mode.
+ * @param nonce the IV of the message. Never reuse a nonce with the same key.
+ * @param associatedData data which is authenticated but not encrypted. May be empty.
+ * @param plaintext the message
+ * @param authTagLength length of the appended authentication tag in bytes.
+ * @return ciphertext || tag
+ * @throws MoCOCrWException if the mode is not an authenticated mode or a parameter is invalid
+ */
+std::vector<uint8_t> aeadSeal(const AESKey &key,
+                              const std::vector<uint8_t> &nonce,
+                              const std::vector<uint8_t> &associatedData,
+                              const std::vector<uint8_t> &plaintext,
+                              size_t authTagLength = AESKey::DefaultAuthTagLength);
+
+/**
+ * Encrypt and authenticate a message into a caller provided buffer.
+ *
+ * No output buffer is allocated, only the cipher context of the call. \c out may alias
+ * \c plaintext for in-place encryption.
+ *
+ * @param out the output buffer. It must hold at least plaintextLength + authTagLength bytes.
+ * @return the number of bytes written (plaintextLength + authTagLength)
+ * @throws MoCOCrWException if the output buffer is too small
+ * @sa aeadSeal(const AESKey&, const std::vector<uint8_t>&, const std::vector<uint8_t>&,
+ *              const std::vector<uint8_t>&, size_t)
+ */
+size_t aeadSeal(const AESKey &key,
+                const uint8_t *nonce,
+                size_t nonceLength,
+                const uint8_t *associatedData,
+                size_t associatedDataLength,
+                const uint8_t *plaintext,
+                size_t plaintextLength,
+                uint8_t *out,
+                size_t outCapacity,
+                size_t authTagLength = AESKey::DefaultAuthTagLength);
+
+/**
+ * Verify and decrypt a message created by aeadSeal().
+ *
+ * @param sealed ciphertext || tag
+ * @param authTagLength length of the authentication tag at the end of \c sealed.
+ * @return the plaintext
+ * @throws MoCOCrWException if the message can't be authenticated. No plaintext is released in
+ *                          this case.
+ */
+std::vector<uint8_t> aeadOpen(const AESKey &key,
+                              const std::vector<uint8_t> &nonce,
+                              const std::vector<uint8_t> &associatedData,
+                              const std::vector<uint8_t> &sealed,
+                              size_t authTagLength = AESKey::DefaultAuthTagLength);
+
+/**
+ * Verify and decrypt a message into a caller provided buffer.
+ *
+ * No output buffer is allocated, only the cipher context of the call. \c out may alias \c sealed
+ * for in-place decryption. If authentication fails, the output buffer is cleansed before the
+ * exception is thrown.
+ *
+ * @param out the output buffer. It must hold at least sealedLength - authTagLength bytes.
+ * @return the length of the plaintext
+ * @throws MoCOCrWException if the output buffer is too small or authentication fails
+ */
+size_t aeadOpen(const AESKey &key,
+                const uint8_t *nonce,
+                size_t nonceLength,
+                const uint8_t *associatedData,
+                size_t associatedDataLength,
+                const uint8_t *sealed,
+                size_t sealedLength,
+                uint8_t *out,
+                size_t outCapacity,
+                size_t authTagLength = AESKey::DefaultAuthTagLength);
+
+/**
+ * A message for aeadSealBatch(). The referenced memory must stay valid during the call.
+ */
+struct AEADRecord
+{
+    const uint8_t *nonce;
+    size_t nonceLength;
+    const uint8_t *associatedData;
+    size_t associatedDataLength;
+    const uint8_t *plaintext;
+    size_t plaintextLength;
+};
+
+/**
+ * The result of aeadSealBatch(): all sealed records in one buffer.
+ *
+ * Record i (ciphertext || tag) occupies arena[offsets[i], offsets[i + 1]).
+ */
+struct AEADBatch
+{
+    std::vector<uint8_t> arena;
+    std::vector<size_t> offsets;
+
+    size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    const uint8_t *data(size_t index) const { return arena.data() + offsets.at(index); }
+    size_t length(size_t index) const { return offsets.at(index + 1) - offsets.at(index); }
 };
 
+/**
+ * Get the buffer size required by aeadSealBatch() for the given records.
+ */
+size_t aeadSealBatchLength(const std::vector<AEADRecord> &records,
+                           size_t authTagLength = AESKey::DefaultAuthTagLength);
+
+/**
+ * Encrypt and authenticate many independent messages with one key.
+ *
+ * All records are sealed like aeadSeal() does and written back to back into the caller provided
+ * buffer. The key is not expanded again and every worker allocates a single cipher context which
+ * it reuses for all records it processes. Each record can be opened with aeadOpen().
+ *
+ * @param key the key. Its mode must be an authenticated cipher mode.
+ * @param records the messages. Every record must have its own nonce.
+ * @param out output buffer of at least aeadSealBatchLength() bytes
+ * @param outCapacity size of the output buffer
+ * @param authTagLength length of the authentication tags in bytes.
+ * @param numberOfThreads number of threads. 0 selects the number of hardware threads.
+ * @return the offset table. Record i occupies out[offsets[i], offsets[i + 1]).
+ * @throws MoCOCrWException if the buffer is too small or a record is invalid
+ */
+std::vector<size_t> aeadSealBatch(const AESKey &key,
+                                  const std::vector<AEADRecord> &records,
+                                  uint8_t *out,
+                                  size_t outCapacity,
+                                  size_t authTagLength = AESKey::DefaultAuthTagLength,
+                                  unsigned int numberOfThreads = 0);
+
+/**
+ * Encrypt and authenticate many independent messages into a newly allocated arena.
+ *
+ * @sa aeadSealBatch(const AESKey&, const std::vector<AEADRecord>&, uint8_t*, size_t, size_t,
+ *                   unsigned int)
+ */
+AEADBatch aeadSealBatch(const AESKey &key,
+                        const std::vector<AEADRecord> &records,
+                        size_t authTagLength = AESKey::DefaultAuthTagLength,
+                        unsigned int numberOfThreads = 0);
+
 /**
  * Check if given symmetric cipher mode is an authenticated cipher.
  *
@@ -19,8 +19,10 @@
 
 #pragma once
 
+#include <limits>
 #include <memory>
 #include <queue>
+#include <string>
 #include <vector>
 
 namespace mococrw
@@ -33,6 +35,14 @@ public:
     virtual void write(std::vector<uint8_t> block) = 0;
     virtual std::vector<uint8_t> read(size_t blockSize) = 0;
     virtual std::vector<uint8_t> readAll() = 0;
+
+    /**
+     * Number of bytes which can be written before the strategy signals backpressure.
+     *
+     * Ciphers don't write more output than this in update(). Strategies without a limit return
+     * the maximum value of size_t.
+     */
+    virtual size_t availableCapacity() const { return std::numeric_limits<size_t>::max(); }
 };
 
 class QueueOfVectorsMemoryStrategy : public CipherMemoryStrategyI
@@ -49,4 +59,134 @@ private:
     size_t _totalBytesStored = 0;
 };
 
+/**
+ * Memory strategy storing all data in a single contiguous ring buffer.
+ *
+ * The buffer grows geometrically when more data is written than it can hold and is never shrunk.
+ * Reads copy the requested data (at most two memcpy operations) and advance the read cursor, so
+ * the cost of read() is proportional to the amount of data read, regardless of how the data was
+ * written. This makes many small reads over large chunks of data cheap. In contrast to
+ * QueueOfVectorsMemoryStrategy, readAll() always copies.
+ */
+class RingBufferMemoryStrategy : public CipherMemoryStrategyI
+{
+public:
+    /**
+     * @param initialCapacity number of bytes the buffer can hold before it has to grow
+     */
+    explicit RingBufferMemoryStrategy(size_t initialCapacity = 0);
+
+    void write(std::vector<uint8_t> chunk) override;
+    std::vector<uint8_t> read(size_t chunkSize) override;
+    std::vector<uint8_t> readAll() override;
+
+    /**
+     * Number of bytes stored in the buffer
+     */
+    size_t size() const { return _size; }
+
+    /**
+     * Number of bytes the buffer can hold without growing
+     */
+    size_t capacity() const { return _buffer.size(); }
+
+private:
+    void _reserve(size_t requiredCapacity);
+
+    std::vector<uint8_t> _buffer;
+    size_t _head = 0;
+    size_t _size = 0;
+};
+
+/**
+ * Memory strategy which keeps at most a configurable amount of data (the high-water mark) in
+ * memory, so the memory consumption of a cipher stays flat when its output is consumed slower
+ * than it is produced.
+ *
+ * What happens when the high-water mark is reached depends on the overflow policy:
+ *
+ * - OverflowPolicy::Backpressure: availableCapacity() reports how much more data may be buffered.
+ *   AESCipher::update() throws without consuming any input if its output doesn't fit anymore,
+ *   AESCipher::tryUpdate() consumes only as much input as fits and reports the number of
+ *   accepted bytes. The caller has to read() before it can continue. Only the output of
+ *   finish() (at most one block) may exceed the high-water mark.
+ * - OverflowPolicy::SpillToFile: data exceeding the high-water mark is written to a temporary
+ *   file. Data is read back from the file in chunks of at most the high-water mark.
+ *
+ * The spilled data of a decryptor is plaintext. It is therefore encrypted with AES-256-CTR under
+ * a random key which only exists in memory, so neither the file nor the blocks it leaves on the
+ * storage device expose the data. The key is replaced whenever the file was drained. The file
+ * is not authenticated, it only provides confidentiality against readers of the storage.
+ *
+ * The file is created with mkstemp() (mode 0600) in the spill directory and unlinked right away,
+ * so it is only reachable through the descriptor and its space is released when the strategy is
+ * destroyed or the process dies. Until then the file only shrinks when all spilled data was read
+ * back: as long as the consumer stays behind, it grows by everything written to it.
+ */
+class BoundedMemoryStrategy : public CipherMemoryStrategyI
+{
+public:
+    enum class OverflowPolicy { Backpressure, SpillToFile };
+
+    /**
+     * @param highWaterMark maximum number of bytes held in memory
+     * @param policy behavior when the high-water mark is reached
+     * @param spillDirectory directory in which the temporary file is created (SpillToFile only)
+     * @throws MoCOCrWException if highWaterMark is 0
+     */
+    BoundedMemoryStrategy(size_t highWaterMark,
+                          OverflowPolicy policy,
+                          std::string spillDirectory = "/tmp");
+    ~BoundedMemoryStrategy();
+
+    BoundedMemoryStrategy(const BoundedMemoryStrategy &) = delete;
+    BoundedMemoryStrategy &operator=(const BoundedMemoryStrategy &) = delete;
+
+    /**
+     * @throws MoCOCrWException if the data can't be written to the temporary file. Data may have
+     *         been lost then, so all following calls of write() and read() throw, too.
+     */
+    void write(std::vector<uint8_t> chunk) override;
+
+    /**
+     * @throws MoCOCrWException if the data can't be read from the temporary file or a write to it
+     *         failed before
+     */
+    std::vector<uint8_t> read(size_t chunkSize) override;
+
+    /**
+     * @note With OverflowPolicy::SpillToFile, this loads all spilled data into memory.
+     */
+    std::vector<uint8_t> readAll() override;
+
+    size_t availableCapacity() const override;
+
+    /**
+     * Total number of bytes stored (in memory and spilled to the file)
+     */
+    size_t size() const { return _memory.size() + _spilledSize; }
+
+    /**
+     * Number of bytes currently held in the temporary file
+     */
+    size_t spilledSize() const { return _spilledSize; }
+
+private:
+    class SpillCipher;
+
+    void _checkNotFailed() const;
+    void _spill(const uint8_t *data, size_t length);
+    void _refillFromFile();
+
+    size_t _highWaterMark;
+    OverflowPolicy _policy;
+    std::string _spillDirectory;
+    RingBufferMemoryStrategy _memory;
+    std::unique_ptr<SpillCipher> _spillCipher;
+    int _spillFd = -1;
+    size_t _spillReadOffset = 0;
+    size_t _spilledSize = 0;
+    bool _failed = false;
+};
+
 }  // namespace mococrw
@@ -43,8 +43,46 @@ std::string toHex(const std::vector<uint8_t>& data);
  */
 std::vector<uint8_t> fromHex(const std::string& hexData);
 
+/**
+ * @brief Returns cryptographically strong random bytes
+ *
+ * The bytes are taken from RandomPool.
+ *
+ * @throws OpenSSLException if the random number generator fails
+ */
 std::vector<uint8_t> cryptoRandomBytes(size_t length);
 
+/**
+ * @brief Buffered access to OpenSSL's random number generator
+ *
+ * Every thread keeps a buffer of random bytes which is refilled from OpenSSL's DRBG in blocks
+ * of BlockSize bytes. Small requests like nonces and IVs are served from this buffer without
+ * locking and without calling into OpenSSL. Requests of at least BlockSize bytes are passed
+ * to OpenSSL directly. Reseeding is done by OpenSSL's DRBG according to its reseed policy.
+ *
+ * Served bytes are removed from the buffer and the buffer is cleansed when its thread exits.
+ * After fork() the buffer of the child is discarded, so parent and child never use the same
+ * random bytes. Use discardBuffer() to drop buffered bytes at other points where the state of
+ * the process may have been duplicated (e.g. after a VM snapshot was restored).
+ */
+class RandomPool
+{
+public:
+    static const size_t BlockSize;
+
+    /**
+     * Fill a buffer with cryptographically strong random bytes. Never allocates memory.
+     *
+     * @throws OpenSSLException if the random number generator fails
+     */
+    static void fill(uint8_t* buffer, size_t length);
+
+    /**
+     * Cleanse and drop the random bytes buffered for the calling thread.
+     */
+    static void discardBuffer();
+};
+
 template <typename T>
 void vectorCleanse(std::vector<T>& vec)
 {
@@ -0,0 +1,88 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#pragma once
+
+#include <string>
+
+namespace mococrw
+{
+/**
+ * @brief Outcome of a verification
+ */
+enum class VerificationStatus {
+    Valid,
+    /** The MAC or signature doesn't match the data */
+    Mismatch,
+    /** The MAC, signature or digest doesn't have the expected length */
+    InvalidLength,
+    /** The certificate can't be verified. The detail code is the OpenSSL X509_V_ERR_* value. */
+    CertificateInvalid,
+};
+
+/**
+ * @brief Result of the non-throwing tryVerify functions
+ *
+ * The throwing verify functions build an error message for every failed verification. When most
+ * verifications fail, e.g. under attack, formatting these messages and unwinding the stack
+ * dominates the cost of a verification. A VerificationResult only stores the status and a
+ * numeric detail code. The message is formatted when getMessage() is called.
+ *
+ * @code
+ * auto result = hmac.tryVerify(receivedMac);
+ * if (!result) {
+ *     log(result.getMessage());
+ * }
+ * @endcode
+ */
+class VerificationResult
+{
+public:
+    explicit VerificationResult(VerificationStatus status, long detailCode = 0) noexcept
+            : _status{status}, _detailCode{detailCode}
+    {
+    }
+
+    static VerificationResult valid() noexcept
+    {
+        return VerificationResult{VerificationStatus::Valid};
+    }
+
+    VerificationStatus getStatus() const noexcept { return _status; }
+
+    bool isValid() const noexcept { return _status == VerificationStatus::Valid; }
+
+    explicit operator bool() const noexcept { return isValid(); }
+
+    /**
+     * @return additional information about the failure, depending on the status. 0 if there is
+     *         none.
+     */
+    long getDetailCode() const noexcept { return _detailCode; }
+
+    /**
+     * @return a human readable description of the result
+     */
+    std::string getMessage() const;
+
+private:
+    VerificationStatus _status;
+    long _detailCode;
+};
+
+}  // namespace mococrw
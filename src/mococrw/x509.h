@@ -27,6 +27,7 @@
 #include "distinguished_name.h"
 #include "key.h"
 #include "openssl_wrap.h"
+#include "verification_result.h"
 
 namespace mococrw
 {
@@ -328,6 +329,25 @@ public:
      */
     void verify(const VerificationContext& ctx) const;
 
+    /**
+     * @brief Verify the validity of a certificate without throwing if it is invalid
+     *
+     * Performs the same checks as verify(const VerificationContext&). A certificate which is not
+     * valid is reported by VerificationStatus::CertificateInvalid. The detail code of the result
+     * is the X509_V_ERR_* code of OpenSSL, e.g. X509_V_ERR_CERT_HAS_EXPIRED.
+     *
+     * @throw MoCOCrWException if the context is not valid (see VerificationContext::validityCheck)
+     */
+    VerificationResult tryVerify(const VerificationContext& ctx) const;
+
+    /**
+     * @brief Verify the validity of a certificate without throwing if it is invalid
+     *
+     * @see verify(const std::vector<X509Certificate>&, const std::vector<X509Certificate>&)
+     */
+    VerificationResult tryVerify(const std::vector<X509Certificate>& trustStore,
+                                 const std::vector<X509Certificate>& intermediateCAs) const;
+
     /**
      * Create a new X509 certificate from an existing openssl certificate.
      * @param ptr a unique pointer to the existing openssl certificate.
@@ -151,6 +151,11 @@ char* OpenSSLLib::SSL_ERR_error_string(unsigned long error, char* buf) noexcept
     return ERR_error_string(error, buf);
 }
 
+void OpenSSLLib::SSL_ERR_error_string_n(unsigned long error, char* buf, size_t len) noexcept
+{
+    ERR_error_string_n(error, buf, len);
+}
+
 unsigned long OpenSSLLib::SSL_ERR_get_error() noexcept { return ERR_get_error(); }
 
 X509_NAME* OpenSSLLib::SSL_X509_NAME_new() noexcept { return X509_NAME_new(); }
@@ -1021,6 +1026,91 @@ int OpenSSLLib::SSL_ENGINE_init(ENGINE* e) noexcept { return ENGINE_init(e); }
 ENGINE* OpenSSLLib::SSL_ENGINE_by_id(const char* id) noexcept { return ENGINE_by_id(id); }
 int OpenSSLLib::SSL_ENGINE_finish(ENGINE* e) noexcept { return ENGINE_finish(e); }
 int OpenSSLLib::SSL_ENGINE_free(ENGINE* e) noexcept { return ENGINE_free(e); }
+const EVP_MD* OpenSSLLib::SSL_EVP_shake128() noexcept
+{
+    return EVP_shake128();
+}
+const EVP_MD* OpenSSLLib::SSL_EVP_shake256() noexcept
+{
+    return EVP_shake256();
+}
+int OpenSSLLib::SSL_EVP_DigestFinalXOF(EVP_MD_CTX* ctx, unsigned char* md, size_t len) noexcept
+{
+    return EVP_DigestFinalXOF(ctx, md, len);
+}
+#if OPENSSL_VERSION_NUMBER >= 0x30300000L
+int OpenSSLLib::SSL_EVP_DigestSqueeze(EVP_MD_CTX* ctx, unsigned char* out, size_t outlen) noexcept
+{
+    return EVP_DigestSqueeze(ctx, out, outlen);
+}
+#endif
+int OpenSSLLib::SSL_EVP_MD_CTX_copy_ex(EVP_MD_CTX* out, const EVP_MD_CTX* in) noexcept
+{
+    return EVP_MD_CTX_copy_ex(out, in);
+}
+const EVP_MD* OpenSSLLib::SSL_EVP_blake2b512() noexcept
+{
+    return EVP_blake2b512();
+}
+const EVP_MD* OpenSSLLib::SSL_EVP_blake2s256() noexcept
+{
+    return EVP_blake2s256();
+}
+int OpenSSLLib::SSL_EVP_CIPHER_CTX_block_size(const EVP_CIPHER_CTX* ctx) noexcept
+{
+    return EVP_CIPHER_CTX_block_size(ctx);
+}
+int OpenSSLLib::SSL_EVP_CIPHER_CTX_copy(EVP_CIPHER_CTX* out, const EVP_CIPHER_CTX* in) noexcept
+{
+    return EVP_CIPHER_CTX_copy(out, in);
+}
+int OpenSSLLib::SSL_HMAC_CTX_copy(HMAC_CTX* dctx, HMAC_CTX* sctx) noexcept
+{
+    return HMAC_CTX_copy(dctx, sctx);
+}
+void OpenSSLLib::SSL_ERR_clear_error() noexcept
+{
+    ERR_clear_error();
+}
+int OpenSSLLib::SSL_ERR_set_mark() noexcept { return ERR_set_mark(); }
+int OpenSSLLib::SSL_ERR_pop_to_mark() noexcept { return ERR_pop_to_mark(); }
+EVP_PKEY* OpenSSLLib::SSL_EVP_PKEY_new_raw_private_key(int type,
+                                                       ENGINE* e,
+                                                       const unsigned char* priv,
+                                                       size_t len) noexcept
+{
+    return EVP_PKEY_new_raw_private_key(type, e, priv, len);
+}
+int OpenSSLLib::SSL_EVP_DigestSignFinal(EVP_MD_CTX* ctx,
+                                        unsigned char* sig,
+                                        size_t* siglen) noexcept
+{
+    return EVP_DigestSignFinal(ctx, sig, siglen);
+}
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+EVP_MD* OpenSSLLib::SSL_EVP_MD_fetch(OSSL_LIB_CTX* ctx,
+                                     const char* algorithm,
+                                     const char* properties) noexcept
+{
+    return EVP_MD_fetch(ctx, algorithm, properties);
+}
+void OpenSSLLib::SSL_EVP_MD_free(EVP_MD* md) noexcept { EVP_MD_free(md); }
+const char* OpenSSLLib::SSL_EVP_MD_get0_name(const EVP_MD* md) noexcept
+{
+    return EVP_MD_get0_name(md);
+}
+EVP_CIPHER* OpenSSLLib::SSL_EVP_CIPHER_fetch(OSSL_LIB_CTX* ctx,
+                                             const char* algorithm,
+                                             const char* properties) noexcept
+{
+    return EVP_CIPHER_fetch(ctx, algorithm, properties);
+}
+void OpenSSLLib::SSL_EVP_CIPHER_free(EVP_CIPHER* cipher) noexcept { EVP_CIPHER_free(cipher); }
+const char* OpenSSLLib::SSL_EVP_CIPHER_get0_name(const EVP_CIPHER* cipher) noexcept
+{
+    return EVP_CIPHER_get0_name(cipher);
+}
+#endif
 }  // namespace lib
 }  // namespace openssl
 }  // namespace mococrw
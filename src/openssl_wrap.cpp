@@ -29,6 +29,8 @@
 #include <cstddef> /* this has to come before cppc (bug in boost) */
 #include <exception>
 #include <limits>
+#include <map>
+#include <mutex>
 
 #include <cppc/checkcall.hpp>
 
@@ -41,14 +43,85 @@ namespace mococrw
 {
 namespace openssl
 {
-std::string OpenSSLException::generateOpenSSLErrorString()
+const size_t OpenSSLException::MaxErrorCodes = ERR_NUM_ERRORS;
+
+std::vector<unsigned long> OpenSSLException::takeOpenSSLErrorCodes()
+{
+    std::vector<unsigned long> errorCodes;
+    while (errorCodes.size() < MaxErrorCodes) {
+        auto error = lib::OpenSSLLib::SSL_ERR_get_error();
+        if (error == 0) {
+            break;
+        }
+        errorCodes.push_back(error);
+    }
+    /* A failed call may not have queued an error. Report it as error 0, as OpenSSL does. */
+    if (errorCodes.empty()) {
+        errorCodes.push_back(0);
+    }
+    return errorCodes;
+}
+
+const char *OpenSSLException::what() const noexcept
+{
+    if (_errorCodes.empty()) {
+        return _message->text.c_str();
+    }
+    try {
+        std::call_once(_message->formatted, [this]() {
+            std::string message;
+            for (auto error : _errorCodes) {
+                if (!message.empty()) {
+                    message += "; ";
+                }
+                /* ERR_error_string would use a static buffer, which isn't thread safe */
+                char buf[256] = {};
+                lib::OpenSSLLib::SSL_ERR_error_string_n(error, buf, sizeof(buf));
+                auto formatter = boost::format("%s: %d");
+                formatter % buf % error;
+                message += formatter.str();
+            }
+            _message->text = std::move(message);
+        });
+    } catch (const std::exception &) {
+        /* The once_flag is not set if formatting failed, a later call tries again. */
+        return "OpenSSL error";
+    }
+    return _message->text.c_str();
+}
+
+}  // namespace openssl
+
+struct MoCOCrWException::Cause
+{
+    explicit Cause(const openssl::OpenSSLException &cause) : exception{cause} {}
+
+    openssl::OpenSSLException exception;
+    std::once_flag formatted;
+    std::string text;
+};
+
+MoCOCrWException::MoCOCrWException(const openssl::OpenSSLException &cause, std::string prefix)
+        : _msg{std::move(prefix)}, _cause{std::make_shared<Cause>(cause)}
 {
-    auto error = lib::OpenSSLLib::SSL_ERR_get_error();
-    auto formatter = boost::format("%s: %d");
-    formatter % lib::OpenSSLLib::SSL_ERR_error_string(error, nullptr) % error;
-    return formatter.str();
 }
 
+const char *MoCOCrWException::causeWhat() const noexcept
+{
+    if (_msg.empty()) {
+        return _cause->exception.what();
+    }
+    try {
+        std::call_once(_cause->formatted,
+                       [this]() { _cause->text = _msg + _cause->exception.what(); });
+    } catch (const std::exception &) {
+        return _cause->exception.what();
+    }
+    return _cause->text.c_str();
+}
+
+namespace openssl
+{
 /**
  * This struct is used by CWrap to
  * determine how to react to an error
@@ -164,6 +237,18 @@ SSL_EVP_PKEY_Ptr _EVP_PKEY_new()
     return SSL_EVP_PKEY_Ptr{OpensslCallPtr::callChecked(lib::OpenSSLLib::SSL_EVP_PKEY_new)};
 }
 
+SSL_EVP_PKEY_Ptr _EVP_PKEY_new_raw_private_key(int type,
+                                               const unsigned char *key,
+                                               size_t keyLength)
+{
+    return SSL_EVP_PKEY_Ptr{
+            OpensslCallPtr::callChecked(lib::OpenSSLLib::SSL_EVP_PKEY_new_raw_private_key,
+                                        type,
+                                        nullptr,
+                                        key,
+                                        keyLength)};
+}
+
 SSL_X509_REQ_Ptr _X509_REQ_new()
 {
     return SSL_X509_REQ_Ptr{OpensslCallPtr::callChecked(lib::OpenSSLLib::SSL_X509_REQ_new)};
@@ -184,6 +269,23 @@ void _EVP_DigestInit_ex(EVP_MD_CTX *ctx, const EVP_MD *type, ENGINE *impl)
     OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_EVP_DigestInit_ex, ctx, type, impl);
 }
 
+void _EVP_DigestFinalXOF(EVP_MD_CTX *ctx, unsigned char *md, size_t len)
+{
+    OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_EVP_DigestFinalXOF, ctx, md, len);
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x30300000L
+void _EVP_DigestSqueeze(EVP_MD_CTX *ctx, unsigned char *out, size_t outlen)
+{
+    OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_EVP_DigestSqueeze, ctx, out, outlen);
+}
+#endif
+
+void _EVP_MD_CTX_copy_ex(EVP_MD_CTX *out, const EVP_MD_CTX *in)
+{
+    OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_EVP_MD_CTX_copy_ex, out, in);
+}
+
 void _EVP_MD_CTX_init(EVP_MD_CTX *ctx) { lib::OpenSSLLib::SSL_EVP_MD_CTX_init(ctx); }
 
 /**
@@ -457,26 +559,148 @@ void _X509_REQ_sign_ctx(X509_REQ *req, EVP_MD_CTX *ctx)
     OpensslCallIsPositive::callChecked(lib::OpenSSLLib::SSL_X509_REQ_sign_ctx, req, ctx);
 }
 
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+namespace
+{
+/*
+ * Process-wide cache of explicitly fetched algorithm implementations, keyed by the library
+ * context and the legacy object of the algorithm. The fetched objects are never freed before the
+ * cache is destroyed at exit. Each thread remembers the objects it already looked up, so the
+ * mutex is only locked on the first use of an algorithm in a thread.
+ */
+template <class Algorithm, class AlgorithmPtr>
+class FetchCache
+{
+public:
+    using FetchFunc = Algorithm *(*)(OSSL_LIB_CTX *, const char *, const char *);
+    using NameFunc = const char *(*)(const Algorithm *);
+
+    FetchCache(FetchFunc fetch, NameFunc name) : _fetch{fetch}, _name{name} {}
+
+    const Algorithm *get(OSSL_LIB_CTX *libCtx, const Algorithm *legacy)
+    {
+        using Key = std::pair<OSSL_LIB_CTX *, const Algorithm *>;
+        thread_local std::map<Key, const Algorithm *> threadCache;
+
+        Key key{libCtx, legacy};
+        auto cached = threadCache.find(key);
+        if (cached != threadCache.end()) {
+            return cached->second;
+        }
+
+        const Algorithm *result = legacy;
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            auto &fetched = _fetched[key];
+            if (!fetched) {
+                lib::OpenSSLLib::SSL_ERR_set_mark();
+                fetched.reset(_fetch(libCtx, _name(legacy), nullptr));
+                if (!fetched) {
+                    /*
+                     * Keep using the legacy object, OpenSSL fetches it implicitly then. Only
+                     * the errors of the failed fetch are removed, older errors stay queued.
+                     */
+                    lib::OpenSSLLib::SSL_ERR_pop_to_mark();
+                }
+            }
+            if (fetched) {
+                result = fetched.get();
+            }
+        }
+        threadCache.emplace(key, result);
+        return result;
+    }
+
+private:
+    FetchFunc _fetch;
+    NameFunc _name;
+    std::mutex _mutex;
+    std::map<std::pair<OSSL_LIB_CTX *, const Algorithm *>, AlgorithmPtr> _fetched;
+};
+
+using SSL_EVP_MD_Fetched_Ptr =
+        std::unique_ptr<EVP_MD, SSLDeleter<EVP_MD, lib::OpenSSLLib::SSL_EVP_MD_free>>;
+using SSL_EVP_CIPHER_Fetched_Ptr =
+        std::unique_ptr<EVP_CIPHER, SSLDeleter<EVP_CIPHER, lib::OpenSSLLib::SSL_EVP_CIPHER_free>>;
+
+FetchCache<EVP_MD, SSL_EVP_MD_Fetched_Ptr> &mdFetchCache()
+{
+    static FetchCache<EVP_MD, SSL_EVP_MD_Fetched_Ptr> cache{
+            lib::OpenSSLLib::SSL_EVP_MD_fetch, lib::OpenSSLLib::SSL_EVP_MD_get0_name};
+    return cache;
+}
+
+FetchCache<EVP_CIPHER, SSL_EVP_CIPHER_Fetched_Ptr> &cipherFetchCache()
+{
+    static FetchCache<EVP_CIPHER, SSL_EVP_CIPHER_Fetched_Ptr> cache{
+            lib::OpenSSLLib::SSL_EVP_CIPHER_fetch, lib::OpenSSLLib::SSL_EVP_CIPHER_get0_name};
+    return cache;
+}
+}  // namespace
+
+const EVP_MD *_fetchCachedMD(const EVP_MD *md)
+{
+    /* The library only uses the default library context. */
+    return md ? mdFetchCache().get(nullptr, md) : md;
+}
+
+const EVP_CIPHER *_fetchCachedCipher(const EVP_CIPHER *cipher)
+{
+    return cipher ? cipherFetchCache().get(nullptr, cipher) : cipher;
+}
+#else
+const EVP_MD *_fetchCachedMD(const EVP_MD *md) { return md; }
+
+const EVP_CIPHER *_fetchCachedCipher(const EVP_CIPHER *cipher) { return cipher; }
+#endif
+
 const EVP_MD *_getMDPtrFromDigestType(DigestTypes type)
 {
+    const EVP_MD *md;
     switch (type) {
         case DigestTypes::SHA1:
-            return lib::OpenSSLLib::SSL_EVP_sha1();
+            md = lib::OpenSSLLib::SSL_EVP_sha1();
+            break;
         case DigestTypes::SHA256:
-            return lib::OpenSSLLib::SSL_EVP_sha256();
+            md = lib::OpenSSLLib::SSL_EVP_sha256();
+            break;
         case DigestTypes::SHA384:
-            return lib::OpenSSLLib::SSL_EVP_sha384();
+            md = lib::OpenSSLLib::SSL_EVP_sha384();
+            break;
         case DigestTypes::SHA512:
-            return lib::OpenSSLLib::SSL_EVP_sha512();
+            md = lib::OpenSSLLib::SSL_EVP_sha512();
+            break;
         case DigestTypes::SHA3_256:
-            return lib::OpenSSLLib::SSL_EVP_sha3_256();
+            md = lib::OpenSSLLib::SSL_EVP_sha3_256();
+            break;
         case DigestTypes::SHA3_384:
-            return lib::OpenSSLLib::SSL_EVP_sha3_384();
+            md = lib::OpenSSLLib::SSL_EVP_sha3_384();
+            break;
         case DigestTypes::SHA3_512:
-            return lib::OpenSSLLib::SSL_EVP_sha3_512();
+            md = lib::OpenSSLLib::SSL_EVP_sha3_512();
+            break;
+        case DigestTypes::BLAKE2b_512:
+            md = lib::OpenSSLLib::SSL_EVP_blake2b512();
+            break;
+        case DigestTypes::BLAKE2s_256:
+            md = lib::OpenSSLLib::SSL_EVP_blake2s256();
+            break;
         default:
             throw std::runtime_error("Unknown digest type");
     }
+    return _fetchCachedMD(md);
+}
+
+const EVP_MD *_getMDPtrFromXofType(XofTypes type)
+{
+    switch (type) {
+        case XofTypes::SHAKE128:
+            return _fetchCachedMD(lib::OpenSSLLib::SSL_EVP_shake128());
+        case XofTypes::SHAKE256:
+            return _fetchCachedMD(lib::OpenSSLLib::SSL_EVP_shake256());
+        default:
+            throw std::runtime_error("Unknown XOF type");
+    }
 }
 
 void _EVP_DigestSignInit(EVP_MD_CTX *ctx, DigestTypes type, EVP_PKEY *pkey)
@@ -509,6 +733,16 @@ void _EVP_DigestSign(EVP_MD_CTX *ctx,
                                   messageLength);
 }
 
+void _EVP_DigestSignFinal(EVP_MD_CTX *ctx,
+                          unsigned char *signatureBuffer,
+                          size_t *signatureBufferLength)
+{
+    OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_EVP_DigestSignFinal,
+                                  ctx,
+                                  signatureBuffer,
+                                  signatureBufferLength);
+}
+
 SSL_EVP_MD_CTX_Ptr _EVP_MD_CTX_create()
 {
     return SSL_EVP_MD_CTX_Ptr{OpensslCallPtr::callChecked(lib::OpenSSLLib::SSL_EVP_MD_CTX_create)};
@@ -600,6 +834,23 @@ void _X509_verify_cert(X509_STORE_CTX *ctx)
     }
 }
 
+int _X509_tryVerifyCert(X509_STORE_CTX *ctx)
+{
+    if (lib::OpenSSLLib::SSL_X509_verify_cert(ctx) == 1) {
+        return X509_V_OK;
+    }
+    lib::OpenSSLLib::SSL_ERR_clear_error();
+    int error = lib::OpenSSLLib::SSL_X509_STORE_CTX_get_error(ctx);
+    /* The verification may fail without setting an error of the context, e.g. on memory
+     * allocation failures. Never report such a failure as X509_V_OK. */
+    return error == X509_V_OK ? X509_V_ERR_UNSPECIFIED : error;
+}
+
+std::string _X509_verify_cert_error_string(long error)
+{
+    return lib::OpenSSLLib::SSL_X509_verify_cert_error_string(error);
+}
+
 template <>
 ASN1_INTEGER *createOpenSSLObject<ASN1_INTEGER>()
 {
@@ -950,6 +1201,11 @@ void _EVP_CIPHER_CTX_reset(EVP_CIPHER_CTX *ctx)
     OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_EVP_CIPHER_CTX_reset, ctx);
 }
 
+void _EVP_CIPHER_CTX_copy(EVP_CIPHER_CTX *out, const EVP_CIPHER_CTX *in)
+{
+    OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_EVP_CIPHER_CTX_copy, out, in);
+}
+
 void _EVP_CIPHER_CTX_ctrl(EVP_CIPHER_CTX *ctx, int type, int arg, void *ptr)
 {
     OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_EVP_CIPHER_CTX_ctrl, ctx, type, arg, ptr);
@@ -999,6 +1255,15 @@ int _EVP_CIPHER_CTX_iv_length(const EVP_CIPHER_CTX *ctx)
     return res;
 }
 
+int _EVP_CIPHER_CTX_block_size(const EVP_CIPHER_CTX *ctx)
+{
+    int res = lib::OpenSSLLib::SSL_EVP_CIPHER_CTX_block_size(ctx);
+    if (res <= 0) {
+        throw OpenSSLException{"Could not determine the block size of the cipher."};
+    }
+    return res;
+}
+
 void _EVP_CIPHER_CTX_set_padding(EVP_CIPHER_CTX *ctx, int pad)
 {
     OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_EVP_CIPHER_CTX_set_padding, ctx, pad);
@@ -1221,6 +1486,19 @@ void _EVP_PKEY_verify(EVP_PKEY_CTX *ctx,
             lib::OpenSSLLib::SSL_EVP_PKEY_verify, ctx, sig, siglen, tbs, tbslen);
 }
 
+bool _EVP_PKEY_tryVerify(EVP_PKEY_CTX *ctx,
+                         const unsigned char *sig,
+                         size_t siglen,
+                         const unsigned char *tbs,
+                         size_t tbslen)
+{
+    if (lib::OpenSSLLib::SSL_EVP_PKEY_verify(ctx, sig, siglen, tbs, tbslen) == 1) {
+        return true;
+    }
+    lib::OpenSSLLib::SSL_ERR_clear_error();
+    return false;
+}
+
 void _EVP_DigestVerifyInit(EVP_MD_CTX *ctx, DigestTypes type, EVP_PKEY *pkey)
 {
     const EVP_MD *md;
@@ -1247,6 +1525,20 @@ void _EVP_DigestVerify(EVP_MD_CTX *ctx,
                                   messageLength);
 }
 
+bool _EVP_DigestTryVerify(EVP_MD_CTX *ctx,
+                          const unsigned char *signature,
+                          size_t signatureLength,
+                          const unsigned char *message,
+                          size_t messageLength)
+{
+    if (lib::OpenSSLLib::SSL_EVP_DigestVerify(
+                ctx, signature, signatureLength, message, messageLength) == 1) {
+        return true;
+    }
+    lib::OpenSSLLib::SSL_ERR_clear_error();
+    return false;
+}
+
 void _EVP_PKEY_CTX_set_rsa_padding(EVP_PKEY_CTX *ctx, int pad)
 {
     OpensslCallIsPositive::callChecked(lib::OpenSSLLib::SSL_EVP_PKEY_CTX_set_rsa_padding, ctx, pad);
@@ -1379,12 +1671,23 @@ void _PKCS5_PBKDF2_HMAC(const std::vector<uint8_t> pass,
                         const EVP_MD *digest,
                         std::vector<uint8_t> &out)
 {
-    const char *pass_ = reinterpret_cast<const char *>(pass.data());
+    _PKCS5_PBKDF2_HMAC(pass.data(), pass.size(), salt.data(), salt.size(), iter, digest, out);
+}
+
+void _PKCS5_PBKDF2_HMAC(const uint8_t *pass,
+                        size_t passLength,
+                        const uint8_t *salt,
+                        size_t saltLength,
+                        int iter,
+                        const EVP_MD *digest,
+                        std::vector<uint8_t> &out)
+{
+    const char *pass_ = reinterpret_cast<const char *>(pass);
     OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_PKCS5_PBKDF2_HMAC,
                                   pass_,
-                                  pass.size(),
-                                  salt.data(),
-                                  salt.size(),
+                                  passLength,
+                                  salt,
+                                  saltLength,
                                   iter,
                                   digest,
                                   out.size(),
@@ -1395,30 +1698,58 @@ void _ECDH_KDF_X9_63(std::vector<uint8_t> &out,
                      const std::vector<uint8_t> &Z,
                      const std::vector<uint8_t> &sinfo,
                      const EVP_MD *md)
+{
+    _ECDH_KDF_X9_63(out, Z.data(), Z.size(), sinfo.data(), sinfo.size(), md);
+}
+
+void _ECDH_KDF_X9_63(std::vector<uint8_t> &out,
+                     const uint8_t *Z,
+                     size_t ZLength,
+                     const uint8_t *sinfo,
+                     size_t sinfoLength,
+                     const EVP_MD *md)
 {
     unsigned char *out_ = reinterpret_cast<unsigned char *>(out.data());
-    const unsigned char *Z_ = reinterpret_cast<const unsigned char *>(Z.data());
-    const unsigned char *sinfo_ = reinterpret_cast<const unsigned char *>(sinfo.data());
     OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_ECDH_KDF_X9_63,
                                   out_,
                                   out.size(),
-                                  Z_,
-                                  Z.size(),
-                                  sinfo_,
-                                  sinfo.size(),
+                                  Z,
+                                  ZLength,
+                                  sinfo,
+                                  sinfoLength,
                                   md);
 }
 
 void _HMAC_Init_ex(HMAC_CTX *ctx, const std::vector<uint8_t> &key, const EVP_MD *md, ENGINE *impl)
+{
+    _HMAC_Init_ex(ctx, key.data(), key.size(), md, impl);
+}
+
+void _HMAC_Init_ex(
+        HMAC_CTX *ctx, const uint8_t *key, size_t keyLength, const EVP_MD *md, ENGINE *impl)
 {
     OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_HMAC_Init_ex,
                                   ctx,
-                                  reinterpret_cast<const void *>(key.data()),
-                                  key.size(),
+                                  reinterpret_cast<const void *>(key),
+                                  keyLength,
                                   md,
                                   impl);
 }
 
+void _HMAC_reinit(HMAC_CTX *ctx)
+{
+    /* A NULL key and digest make OpenSSL reuse the prepared inner and outer digest contexts. */
+    OpensslCallIsOne::callChecked(
+            lib::OpenSSLLib::SSL_HMAC_Init_ex, ctx, nullptr, 0, nullptr, nullptr);
+}
+
+SSL_HMAC_CTX_Ptr _HMAC_CTX_copy(HMAC_CTX *ctx)
+{
+    auto copy = _HMAC_CTX_new();
+    OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_HMAC_CTX_copy, copy.get(), ctx);
+    return copy;
+}
+
 std::vector<uint8_t> _HMAC_Final(HMAC_CTX *ctx)
 {
     unsigned int length = EVP_MAX_MD_SIZE;
@@ -1430,7 +1761,12 @@ std::vector<uint8_t> _HMAC_Final(HMAC_CTX *ctx)
 
 void _HMAC_Update(HMAC_CTX *ctx, const std::vector<uint8_t> &data)
 {
-    OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_HMAC_Update, ctx, data.data(), data.size());
+    _HMAC_Update(ctx, data.data(), data.size());
+}
+
+void _HMAC_Update(HMAC_CTX *ctx, const uint8_t *data, size_t length)
+{
+    OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_HMAC_Update, ctx, data, length);
 }
 
 SSL_HMAC_CTX_Ptr _HMAC_CTX_new() { return createManagedOpenSSLObject<SSL_HMAC_CTX_Ptr>(); }
@@ -1442,13 +1778,41 @@ void _CMAC_Init(CMAC_CTX *ctx,
                 const EVP_CIPHER *cipher,
                 ENGINE *impl)
 {
+    _CMAC_Init(ctx, key.data(), key.size(), cipher, impl);
+}
+
+void _CMAC_Init(CMAC_CTX *ctx,
+                const uint8_t *key,
+                size_t keyLength,
+                const EVP_CIPHER *cipher,
+                ENGINE *impl)
+{
+    OpensslCallIsOne::callChecked(
+            lib::OpenSSLLib::SSL_CMAC_Init, ctx, key, keyLength, cipher, impl);
+}
+
+void _CMAC_reinit(CMAC_CTX *ctx)
+{
+    /* Passing no key, cipher and engine restarts the computation with the current key. */
     OpensslCallIsOne::callChecked(
-            lib::OpenSSLLib::SSL_CMAC_Init, ctx, key.data(), key.size(), cipher, impl);
+            lib::OpenSSLLib::SSL_CMAC_Init, ctx, nullptr, 0, nullptr, nullptr);
+}
+
+SSL_CMAC_CTX_Ptr _CMAC_CTX_copy(const CMAC_CTX *ctx)
+{
+    auto copy = _CMAC_CTX_new();
+    OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_CMAC_CTX_copy, copy.get(), ctx);
+    return copy;
 }
 
 void _CMAC_Update(CMAC_CTX *ctx, const std::vector<uint8_t> &data)
 {
-    OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_CMAC_Update, ctx, data.data(), data.size());
+    _CMAC_Update(ctx, data.data(), data.size());
+}
+
+void _CMAC_Update(CMAC_CTX *ctx, const uint8_t *data, size_t length)
+{
+    OpensslCallIsOne::callChecked(lib::OpenSSLLib::SSL_CMAC_Update, ctx, data, length);
 }
 
 std::vector<uint8_t> _CMAC_Final(CMAC_CTX *ctx)
@@ -1465,9 +1829,9 @@ const EVP_CIPHER *_getCipherPtrFromCmacCipherType(CmacCipherTypes cipherType)
 {
     switch (cipherType) {
         case CmacCipherTypes::AES_CBC_128:
-            return lib::OpenSSLLib::SSL_EVP_aes_128_cbc();
+            return _fetchCachedCipher(lib::OpenSSLLib::SSL_EVP_aes_128_cbc());
         case CmacCipherTypes::AES_CBC_256:
-            return lib::OpenSSLLib::SSL_EVP_aes_256_cbc();
+            return _fetchCachedCipher(lib::OpenSSLLib::SSL_EVP_aes_256_cbc());
         default:
             throw std::runtime_error("Unknown cipher type");
     }
@@ -233,7 +233,7 @@ void OAEPPadding::prepareOpenSSLContext(openssl::SSL_EVP_PKEY_CTX_Ptr& ctx) cons
             std::ignore = label_copy.release();
         }
     } catch (const OpenSSLException& e) {
-        throw MoCOCrWException(e.what());
+        throw MoCOCrWException(e);
     }
 }
 
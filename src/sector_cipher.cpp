@@ -0,0 +1,164 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "mococrw/sector_cipher.h"
+
+#include <algorithm>
+
+#include <boost/format.hpp>
+
+#include "mococrw/error.h"
+#include "mococrw/private/parallel.h"
+
+namespace mococrw
+{
+using namespace openssl;
+
+const size_t AESXTSSectorCipher::DefaultSectorSize = 4096;
+/* IEEE 1619 limits a data unit to 2^20 AES blocks. */
+const size_t AESXTSSectorCipher::MaxSectorSize = size_t{1} << 24;
+
+namespace
+{
+const size_t AESBlockSize = 16;
+
+/* Sectors are handed to the workers in groups of about this size to amortize the context
+ * setup. */
+const size_t WorkItemSize = 256 * 1024;
+
+SSL_EVP_CIPHER_CTX_Ptr createKeyedContext(const EVP_CIPHER *cipher,
+                                          const std::vector<uint8_t> &key,
+                                          bool encrypt)
+{
+    auto ctx = _EVP_CIPHER_CTX_new();
+    _EVP_CipherInit_ex(ctx.get(), cipher, nullptr, key.data(), nullptr, encrypt);
+    return ctx;
+}
+
+void setTweak(EVP_CIPHER_CTX *ctx, uint64_t sectorIndex)
+{
+    /* IEEE 1619: the data unit sequence number is encoded little endian. */
+    uint8_t tweak[AESBlockSize] = {};
+    for (size_t i = 0; i < sizeof(sectorIndex); i++) {
+        tweak[i] = static_cast<uint8_t>(sectorIndex >> (8 * i));
+    }
+    _EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, tweak, -1);
+}
+}  // namespace
+
+AESXTSSectorCipher::AESXTSSectorCipher(SymmetricCipherKeySize keySize,
+                                       const std::vector<uint8_t> &key,
+                                       size_t sectorSize)
+        : _sectorSize{sectorSize}
+{
+    const EVP_CIPHER *cipher = nullptr;
+    switch (keySize) {
+        case SymmetricCipherKeySize::S_128:
+            cipher = EVP_aes_128_xts();
+            break;
+        case SymmetricCipherKeySize::S_256:
+            cipher = EVP_aes_256_xts();
+            break;
+        default:
+            throw MoCOCrWException("Not yet implemented key size for AES-XTS.");
+    }
+    cipher = _fetchCachedCipher(cipher);
+
+    size_t expectedKeySize = 2 * getSymmetricCipherKeySize(keySize);
+    if (key.size() != expectedKeySize) {
+        auto formatter = boost::format("Invalid size of Key %d bytes. Must be %d bytes.");
+        formatter % key.size() % expectedKeySize;
+        throw MoCOCrWException(formatter.str());
+    }
+    if (std::equal(key.begin(), key.begin() + key.size() / 2, key.begin() + key.size() / 2)) {
+        throw MoCOCrWException("The data key and the tweak key of AES-XTS must differ.");
+    }
+    if (_sectorSize < AESBlockSize || _sectorSize > MaxSectorSize) {
+        auto formatter = boost::format(
+                "Invalid sector size %d bytes for AES-XTS. Must be between %d and %d bytes.");
+        formatter % _sectorSize % AESBlockSize % MaxSectorSize;
+        throw MoCOCrWException(formatter.str());
+    }
+
+    _encryptionCtx = createKeyedContext(cipher, key, true);
+    _decryptionCtx = createKeyedContext(cipher, key, false);
+}
+
+void AESXTSSectorCipher::encryptSector(uint64_t sectorIndex, const uint8_t *in, uint8_t *out) const
+{
+    _processSectors(true, sectorIndex, in, _sectorSize, out, 1);
+}
+
+void AESXTSSectorCipher::decryptSector(uint64_t sectorIndex, const uint8_t *in, uint8_t *out) const
+{
+    _processSectors(false, sectorIndex, in, _sectorSize, out, 1);
+}
+
+void AESXTSSectorCipher::encryptSectors(uint64_t firstSectorIndex,
+                                        const uint8_t *in,
+                                        size_t length,
+                                        uint8_t *out,
+                                        unsigned int numberOfThreads) const
+{
+    _processSectors(true, firstSectorIndex, in, length, out, numberOfThreads);
+}
+
+void AESXTSSectorCipher::decryptSectors(uint64_t firstSectorIndex,
+                                        const uint8_t *in,
+                                        size_t length,
+                                        uint8_t *out,
+                                        unsigned int numberOfThreads) const
+{
+    _processSectors(false, firstSectorIndex, in, length, out, numberOfThreads);
+}
+
+void AESXTSSectorCipher::_processSectors(bool encrypt,
+                                         uint64_t firstSectorIndex,
+                                         const uint8_t *in,
+                                         size_t length,
+                                         uint8_t *out,
+                                         unsigned int numberOfThreads) const
+{
+    if (length % _sectorSize != 0) {
+        auto formatter = boost::format("Length %d is not a multiple of the sector size %d.");
+        formatter % length % _sectorSize;
+        throw MoCOCrWException(formatter.str());
+    }
+
+    size_t sectors = length / _sectorSize;
+    size_t sectorsPerItem = std::max<size_t>(1, WorkItemSize / _sectorSize);
+    size_t items = (sectors + sectorsPerItem - 1) / sectorsPerItem;
+    const EVP_CIPHER_CTX *keyCtx = encrypt ? _encryptionCtx.get() : _decryptionCtx.get();
+
+    detail::parallelFor(items, numberOfThreads, [&](size_t item) {
+        auto ctx = _EVP_CIPHER_CTX_new();
+        _EVP_CIPHER_CTX_copy(ctx.get(), keyCtx);
+
+        size_t first = item * sectorsPerItem;
+        size_t last = std::min(sectors, first + sectorsPerItem);
+        for (size_t sector = first; sector < last; sector++) {
+            size_t offset = sector * _sectorSize;
+            setTweak(ctx.get(), firstSectorIndex + sector);
+            /* XTS processes a data unit in a single call. */
+            int len = 0;
+            _EVP_CipherUpdate(ctx.get(), out + offset, &len, in + offset, _sectorSize);
+        }
+    });
+}
+
+}  // namespace mococrw
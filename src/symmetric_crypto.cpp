@@ -19,6 +19,8 @@
 
 #include "mococrw/symmetric_memory.h"
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <type_traits>
 
@@ -26,6 +28,7 @@
 
 #include "mococrw/error.h"
 #include "mococrw/openssl_wrap.h"
+#include "mococrw/private/parallel.h"
 #include "mococrw/symmetric_crypto.h"
 #include "mococrw/util.h"
 
@@ -53,6 +56,7 @@ size_t AESCipherBuilder::getDefaultIVLength(SymmetricCipherMode mode)
 {
     switch (mode) {
         case SymmetricCipherMode::GCM:
+        case SymmetricCipherMode::CHACHA20_POLY1305:
             return 12;
         case SymmetricCipherMode::CBC:
         case SymmetricCipherMode::CTR:
@@ -63,6 +67,84 @@ size_t AESCipherBuilder::getDefaultIVLength(SymmetricCipherMode mode)
             std::to_string(static_cast<std::underlying_type_t<decltype(mode)>>(mode)));
 }
 
+namespace
+{
+using EVPCipherConstructor = const EVP_CIPHER *(*)();
+
+const EVP_CIPHER *getEVPCipherForModeAndSize(SymmetricCipherMode mode,
+                                             SymmetricCipherKeySize keySize)
+{
+    EVPCipherConstructor constructor = nullptr;
+
+    switch (mode) {
+        case SymmetricCipherMode::GCM:
+            switch (keySize) {
+                case SymmetricCipherKeySize::S_256:
+                    constructor = EVP_aes_256_gcm;
+                    break;
+                case SymmetricCipherKeySize::S_128:
+                    constructor = EVP_aes_128_gcm;
+                    break;
+                default:
+                    throw MoCOCrWException("Not yet implemented key size for the given mode.");
+            }
+            break;
+        case SymmetricCipherMode::CBC:
+            switch (keySize) {
+                case SymmetricCipherKeySize::S_256:
+                    constructor = EVP_aes_256_cbc;
+                    break;
+                case SymmetricCipherKeySize::S_128:
+                    constructor = EVP_aes_128_cbc;
+                    break;
+                default:
+                    throw MoCOCrWException("Not yet implemented key size for the given mode.");
+            }
+            break;
+        case SymmetricCipherMode::CTR:
+            switch (keySize) {
+                case SymmetricCipherKeySize::S_256:
+                    constructor = EVP_aes_256_ctr;
+                    break;
+                case SymmetricCipherKeySize::S_128:
+                    constructor = EVP_aes_128_ctr;
+                    break;
+                default:
+                    throw MoCOCrWException("Not yet implemented key size for the given mode.");
+            }
+            break;
+        case SymmetricCipherMode::CHACHA20_POLY1305:
+            switch (keySize) {
+                case SymmetricCipherKeySize::S_256:
+                    constructor = EVP_chacha20_poly1305;
+                    break;
+                default:
+                    throw MoCOCrWException("ChaCha20-Poly1305 only supports 256 bit keys.");
+            }
+            break;
+        default:
+            throw MoCOCrWException("Not yet implemented cipher mode.");
+    }
+
+    return _fetchCachedCipher(constructor());
+}
+
+void checkAEADNonceLength(SymmetricCipherMode mode, size_t nonceLength)
+{
+    if (nonceLength == 0) {
+        throw MoCOCrWException(
+                "IV is empty, but authenticated cipher modes do not support empty IVs.");
+    }
+    /* RFC 8439 defines ChaCha20-Poly1305 with a 96 bit nonce only. */
+    const size_t chachaNonceLength = 12;
+    if (mode == SymmetricCipherMode::CHACHA20_POLY1305 && nonceLength != chachaNonceLength) {
+        auto formatter = boost::format("Invalid size of IV %d bytes. Must be %d bytes.");
+        formatter % nonceLength % chachaNonceLength;
+        throw MoCOCrWException(formatter.str());
+    }
+}
+}  // namespace
+
 class AESCipher::Impl
 {
 public:
@@ -72,20 +154,22 @@ public:
          const std::vector<uint8_t> &secretKey,
          const std::vector<uint8_t> &iv,
          Operation operation,
-         std::unique_ptr<CipherMemoryStrategyI> memoryStrategy =
-                 std::make_unique<QueueOfVectorsMemoryStrategy>())
+         std::unique_ptr<CipherMemoryStrategyI> memoryStrategy = nullptr)
             : _mode{mode}
             , _iv{iv}
             , _operation{operation}
             , _bufferStrategy(std::move(memoryStrategy))
     {
+        if (!_bufferStrategy) {
+            _bufferStrategy = std::make_unique<QueueOfVectorsMemoryStrategy>();
+        }
+
         _ctx = _EVP_CIPHER_CTX_new();
 
-        const EVPCipherConstructor evpCipherConstructor =
-                getEVPCipherConstructorForModeAndSize(mode, keySize);
+        const EVP_CIPHER *cipher = getEVPCipherForModeAndSize(mode, keySize);
 
         _EVP_CipherInit_ex(_ctx.get(),
-                           evpCipherConstructor(),
+                           cipher,
                            nullptr,
                            nullptr,
                            nullptr,
@@ -99,69 +183,108 @@ public:
             throw MoCOCrWException(formatter.str());
         }
 
-        // Check IV length and adjust if cipher supports it
-        switch (mode) {
-            case SymmetricCipherMode::GCM: {
-                if (_iv.size() == 0) {
-                    throw MoCOCrWException("IV is empty, but AES-GCM does not support empty IVs.");
-                }
-                _EVP_CIPHER_CTX_ctrl(_ctx.get(), EVP_CTRL_GCM_SET_IVLEN, _iv.size(), nullptr);
-            } break;
-            case SymmetricCipherMode::CTR:
-                //[[fallthrough]];
-            case SymmetricCipherMode::CBC: {
-                size_t expectedIVSize = _EVP_CIPHER_CTX_iv_length(_ctx.get());
-                if (_iv.size() != expectedIVSize) {
-                    auto formatter =
-                            boost::format("Invalid size of IV %d bytes. Must be %d bytes.");
-                    formatter % _iv.size() % expectedIVSize;
-                    throw MoCOCrWException(formatter.str());
-                }
-            } break;
-        }
+        _checkIVLength();
 
         _EVP_CIPHER_CTX_reset(_ctx.get());
 
         _EVP_CipherInit_ex(_ctx.get(),
-                           evpCipherConstructor(),
+                           cipher,
                            nullptr,
                            secretKey.data(),
                            _iv.data(),
                            this->_operation == Operation::Encryption);
 
-        switch (padding) {
-            case SymmetricCipherPadding::PKCS:
-                // OpenSSL uses PKCS padding by default.
-                break;
-            case SymmetricCipherPadding::NO:
-                _EVP_CIPHER_CTX_set_padding(_ctx.get(), 0);
-                break;
-        }
+        _setPadding(padding);
     };
 
-    void update(const std::vector<uint8_t> &message)
+    Impl(SymmetricCipherMode mode,
+         const EVP_CIPHER_CTX *keyCtx,
+         SymmetricCipherPadding padding,
+         const std::vector<uint8_t> &iv,
+         Operation operation,
+         std::unique_ptr<CipherMemoryStrategyI> memoryStrategy = nullptr)
+            : _mode{mode}
+            , _iv{iv}
+            , _operation{operation}
+            , _bufferStrategy(std::move(memoryStrategy))
+    {
+        if (!_bufferStrategy) {
+            _bufferStrategy = std::make_unique<QueueOfVectorsMemoryStrategy>();
+        }
+
+        // The key schedule was already computed for keyCtx. Only the IV has to be set.
+        _ctx = _EVP_CIPHER_CTX_new();
+        _EVP_CIPHER_CTX_copy(_ctx.get(), keyCtx);
+
+        _checkIVLength();
+
+        _EVP_CipherInit_ex(_ctx.get(),
+                           nullptr,
+                           nullptr,
+                           nullptr,
+                           _iv.data(),
+                           this->_operation == Operation::Encryption);
+
+        _setPadding(padding);
+    }
+
+    size_t update(const uint8_t *in, size_t length, uint8_t *out, size_t outCapacity)
+    {
+        if (_isFinished) {
+            throw MoCOCrWException(
+                    "Further calls to update() are not allowed once finish() was called.");
+        }
+
+        if (length >
+            static_cast<size_t>(std::numeric_limits<int>::max() - EVP_MAX_BLOCK_LENGTH)) {
+            throw MoCOCrWException("Message is too big.");
+        }
+
+        if (length == 0) {
+            return 0;
+        }
+
+        if (outCapacity < getMaxUpdateOutputLength(length)) {
+            auto formatter = boost::format(
+                    "Output buffer too small: %d bytes are required but only %d are available.");
+            formatter % getMaxUpdateOutputLength(length) % outCapacity;
+            throw MoCOCrWException(formatter.str());
+        }
+
+        int processedLength = 0;
+        _EVP_CipherUpdate(_ctx.get(), out, &processedLength, in, length);
+        _isUpdated = true;
+
+        return processedLength;
+    }
+
+    void update(const std::vector<uint8_t> &message) { update(message.data(), message.size()); }
+
+    void update(const uint8_t *message, size_t length)
     {
         if (_isFinished) {
             throw MoCOCrWException(
                     "Further calls to update() are not allowed once finish() was called.");
         }
 
-        if (message.size() > static_cast<std::decay_t<decltype(message)>::size_type>(
-                                     std::numeric_limits<int>::max() - EVP_MAX_BLOCK_LENGTH)) {
+        if (length > static_cast<size_t>(std::numeric_limits<int>::max() - EVP_MAX_BLOCK_LENGTH)) {
             throw MoCOCrWException("Message is too big.");
         }
 
-        int processingChunkSize = message.size();
+        int processingChunkSize = length;
         if (processingChunkSize <= 0) {
             return;
         }
+
+        if (_bufferStrategy->availableCapacity() < getMaxUpdateOutputLength(length)) {
+            throw MoCOCrWException(
+                    "The memory strategy can't take the output of update() anymore. Read the "
+                    "processed data first or use tryUpdate().");
+        }
+
         std::vector<uint8_t> processedChunk(processingChunkSize + EVP_MAX_BLOCK_LENGTH);
 
-        _EVP_CipherUpdate(_ctx.get(),
-                          processedChunk.data(),
-                          &processingChunkSize,
-                          message.data(),
-                          message.size());
+        _EVP_CipherUpdate(_ctx.get(), processedChunk.data(), &processingChunkSize, message, length);
 
         if (processingChunkSize > 0) {
             processedChunk.resize(processingChunkSize);
@@ -171,7 +294,25 @@ public:
         _isUpdated = true;
     }
 
-    void addAssociatedData(const std::vector<uint8_t> &associatedData)
+    size_t tryUpdate(const uint8_t *message, size_t length)
+    {
+        if (_isFinished) {
+            throw MoCOCrWException(
+                    "Further calls to update() are not allowed once finish() was called.");
+        }
+
+        size_t capacity = _bufferStrategy->availableCapacity();
+        // A block cipher may emit up to one block in addition to the consumed input.
+        size_t overhead = getMaxUpdateOutputLength(0);
+        if (capacity <= overhead) {
+            return 0;
+        }
+        size_t accepted = std::min(length, capacity - overhead);
+        update(message, accepted);
+        return accepted;
+    }
+
+    void addAssociatedData(const uint8_t *associatedData, size_t length)
     {
         if (_isUpdated) {
             throw MoCOCrWException(
@@ -185,7 +326,7 @@ public:
         }
 
         int len = 0;
-        _EVP_CipherUpdate(_ctx.get(), NULL, &len, associatedData.data(), associatedData.size());
+        _EVP_CipherUpdate(_ctx.get(), NULL, &len, associatedData, length);
     }
 
     std::vector<uint8_t> read(size_t length) { return _bufferStrategy->read(length); }
@@ -193,13 +334,28 @@ public:
     std::vector<uint8_t> readAll() { return _bufferStrategy->readAll(); }
 
     std::vector<uint8_t> finish()
+    {
+        std::vector<uint8_t> processedChunk(EVP_MAX_BLOCK_LENGTH);
+        processedChunk.resize(finish(processedChunk.data(), processedChunk.size()));
+        _bufferStrategy->write(std::move(processedChunk));
+
+        return _bufferStrategy->readAll();
+    }
+
+    size_t finish(uint8_t *out, size_t outCapacity)
     {
         if (_isFinished) {
             throw MoCOCrWException("finish() can't be called twice.");
         }
 
+        if (outCapacity < getMaxFinishOutputLength()) {
+            auto formatter = boost::format(
+                    "Output buffer too small: %d bytes are required but only %d are available.");
+            formatter % getMaxFinishOutputLength() % outCapacity;
+            throw MoCOCrWException(formatter.str());
+        }
+
         int processingChunkSize = 0;
-        std::vector<uint8_t> processedChunk(EVP_MAX_BLOCK_LENGTH);
 
         if (isAuthenticatedCipherMode(_mode) && _operation == Operation::Decryption) {
             if (_authTag.size() == 0) {
@@ -212,7 +368,7 @@ public:
         }
 
         try {
-            _EVP_CipherFinal_ex(_ctx.get(), processedChunk.data(), &processingChunkSize);
+            _EVP_CipherFinal_ex(_ctx.get(), out, &processingChunkSize);
         } catch (const OpenSSLException &e) {
             // OpenSSL does not set any specific error codes which we can use to distinguish
             // authentication failure from other type of errors. Therefore, if there is an error
@@ -227,17 +383,29 @@ public:
             }
         }
 
-        if (_mode == SymmetricCipherMode::GCM && _operation == Operation::Encryption) {
+        if (isAuthenticatedCipherMode(_mode) && _operation == Operation::Encryption) {
             _authTag.resize(_requestedAuthTagLength);
             _EVP_CIPHER_CTX_ctrl(
                     _ctx.get(), EVP_CTRL_GCM_GET_TAG, _requestedAuthTagLength, _authTag.data());
         }
 
-        processedChunk.resize(processingChunkSize);
-        _bufferStrategy->write(std::move(processedChunk));
         _isFinished = true;
 
-        return _bufferStrategy->readAll();
+        return processingChunkSize;
+    }
+
+    size_t getMaxUpdateOutputLength(size_t length) const
+    {
+        size_t blockSize = _EVP_CIPHER_CTX_block_size(_ctx.get());
+        // Block ciphers may emit a previously buffered (partial) block in addition to the input.
+        return blockSize > 1 ? length + blockSize : length;
+    }
+
+    size_t getMaxFinishOutputLength() const
+    {
+        size_t blockSize = _EVP_CIPHER_CTX_block_size(_ctx.get());
+        // Only block ciphers emit data (the last, possibly padded block) on finalization.
+        return blockSize > 1 ? blockSize : 0;
     }
 
     std::vector<uint8_t> getIV() { return _iv; }
@@ -260,55 +428,40 @@ private:
     bool _isFinished = false;
     bool _isUpdated = false;
 
-    using EVPCipherConstructor = const EVP_CIPHER *(*)();
-
-    EVPCipherConstructor getEVPCipherConstructorForModeAndSize(SymmetricCipherMode mode,
-                                                               SymmetricCipherKeySize keySize)
+    void _checkIVLength()
     {
-        EVPCipherConstructor constructor = nullptr;
-
-        switch (mode) {
+        // Check IV length and adjust if cipher supports it
+        switch (_mode) {
             case SymmetricCipherMode::GCM:
-                switch (keySize) {
-                    case SymmetricCipherKeySize::S_256:
-                        constructor = EVP_aes_256_gcm;
-                        break;
-                    case SymmetricCipherKeySize::S_128:
-                        constructor = EVP_aes_128_gcm;
-                        break;
-                    default:
-                        throw MoCOCrWException("Not yet implemented key size for the given mode.");
-                }
-                break;
-            case SymmetricCipherMode::CBC:
-                switch (keySize) {
-                    case SymmetricCipherKeySize::S_256:
-                        constructor = EVP_aes_256_cbc;
-                        break;
-                    case SymmetricCipherKeySize::S_128:
-                        constructor = EVP_aes_128_cbc;
-                        break;
-                    default:
-                        throw MoCOCrWException("Not yet implemented key size for the given mode.");
-                }
-                break;
+                //[[fallthrough]];
+            case SymmetricCipherMode::CHACHA20_POLY1305: {
+                checkAEADNonceLength(_mode, _iv.size());
+                _EVP_CIPHER_CTX_ctrl(_ctx.get(), EVP_CTRL_GCM_SET_IVLEN, _iv.size(), nullptr);
+            } break;
             case SymmetricCipherMode::CTR:
-                switch (keySize) {
-                    case SymmetricCipherKeySize::S_256:
-                        constructor = EVP_aes_256_ctr;
-                        break;
-                    case SymmetricCipherKeySize::S_128:
-                        constructor = EVP_aes_128_ctr;
-                        break;
-                    default:
-                        throw MoCOCrWException("Not yet implemented key size for the given mode.");
+                //[[fallthrough]];
+            case SymmetricCipherMode::CBC: {
+                size_t expectedIVSize = _EVP_CIPHER_CTX_iv_length(_ctx.get());
+                if (_iv.size() != expectedIVSize) {
+                    auto formatter =
+                            boost::format("Invalid size of IV %d bytes. Must be %d bytes.");
+                    formatter % _iv.size() % expectedIVSize;
+                    throw MoCOCrWException(formatter.str());
                 }
-                break;
-            default:
-                throw MoCOCrWException("Not yet implemented cipher mode.");
+            } break;
         }
+    }
 
-        return constructor;
+    void _setPadding(SymmetricCipherPadding padding)
+    {
+        switch (padding) {
+            case SymmetricCipherPadding::PKCS:
+                // OpenSSL uses PKCS padding by default.
+                break;
+            case SymmetricCipherPadding::NO:
+                _EVP_CIPHER_CTX_set_padding(_ctx.get(), 0);
+                break;
+        }
     }
 };
 
@@ -317,15 +470,35 @@ AESCipher::AESCipher(SymmetricCipherMode mode,
                      SymmetricCipherPadding padding,
                      const std::vector<uint8_t> &secretKey,
                      const std::vector<uint8_t> &iv,
+                     Operation operation,
+                     std::unique_ptr<CipherMemoryStrategyI> memoryStrategy)
+{
+    _impl = std::make_unique<AESCipher::Impl>(
+            mode, keySize, padding, secretKey, iv, operation, std::move(memoryStrategy));
+}
+
+AESCipher::AESCipher(SymmetricCipherMode mode,
+                     const EVP_CIPHER_CTX *keyCtx,
+                     SymmetricCipherPadding padding,
+                     const std::vector<uint8_t> &iv,
                      Operation operation)
 {
-    _impl = std::make_unique<AESCipher::Impl>(mode, keySize, padding, secretKey, iv, operation);
+    _impl = std::make_unique<AESCipher::Impl>(mode, keyCtx, padding, iv, operation);
 }
 
 AESCipher::~AESCipher() = default;
 
+void SymmetricCipherI::update(ByteView message) { update(message.toVector()); }
+
+void AuthenticatedEncryptionI::addAssociatedData(ByteView associatedData)
+{
+    addAssociatedData(associatedData.toVector());
+}
+
 void AESCipher::update(const std::vector<uint8_t> &message) { _impl->update(message); }
 
+void AESCipher::update(ByteView message) { _impl->update(message.data(), message.size()); }
+
 std::vector<uint8_t> AESCipher::read(size_t length) { return _impl->read(length); }
 
 std::vector<uint8_t> AESCipher::readAll() { return _impl->readAll(); }
@@ -334,14 +507,53 @@ std::vector<uint8_t> AESCipher::finish() { return _impl->finish(); }
 
 std::vector<uint8_t> AESCipher::getIV() const { return _impl->getIV(); }
 
+size_t AESCipher::tryUpdate(const std::vector<uint8_t> &message)
+{
+    return _impl->tryUpdate(message.data(), message.size());
+}
+
+size_t AESCipher::tryUpdate(const uint8_t *message, size_t length)
+{
+    return _impl->tryUpdate(message, length);
+}
+
+size_t AESCipher::update(const uint8_t *in, size_t length, uint8_t *out, size_t outCapacity)
+{
+    return _impl->update(in, length, out, outCapacity);
+}
+
+size_t AESCipher::finish(uint8_t *out, size_t outCapacity)
+{
+    return _impl->finish(out, outCapacity);
+}
+
+size_t AESCipher::getMaxUpdateOutputLength(size_t length) const
+{
+    return _impl->getMaxUpdateOutputLength(length);
+}
+
+size_t AESCipher::getMaxFinishOutputLength() const { return _impl->getMaxFinishOutputLength(); }
+
+AuthenticatedAESCipher::AuthenticatedAESCipher(
+        SymmetricCipherMode mode,
+        SymmetricCipherKeySize keySize,
+        SymmetricCipherPadding padding,
+        const std::vector<uint8_t> &secretKey,
+        const std::vector<uint8_t> &iv,
+        size_t authTagLength,
+        AESCipher::Operation operation,
+        std::unique_ptr<CipherMemoryStrategyI> memoryStrategy)
+        : AESCipher(mode, keySize, padding, secretKey, iv, operation, std::move(memoryStrategy))
+{
+    _impl->setAuthTagLength(authTagLength);
+}
+
 AuthenticatedAESCipher::AuthenticatedAESCipher(SymmetricCipherMode mode,
-                                               SymmetricCipherKeySize keySize,
-                                               SymmetricCipherPadding padding,
-                                               const std::vector<uint8_t> &secretKey,
+                                               const EVP_CIPHER_CTX *keyCtx,
                                                const std::vector<uint8_t> &iv,
                                                size_t authTagLength,
                                                AESCipher::Operation operation)
-        : AESCipher(mode, keySize, padding, secretKey, iv, operation)
+        : AESCipher(mode, keyCtx, SymmetricCipherPadding::PKCS, iv, operation)
 {
     _impl->setAuthTagLength(authTagLength);
 }
@@ -352,7 +564,12 @@ void AuthenticatedAESCipher::setAuthTag(const std::vector<uint8_t> &tag) { _impl
 
 void AuthenticatedAESCipher::addAssociatedData(const std::vector<uint8_t> &associatedData)
 {
-    _impl->addAssociatedData(associatedData);
+    _impl->addAssociatedData(associatedData.data(), associatedData.size());
+}
+
+void AuthenticatedAESCipher::addAssociatedData(ByteView associatedData)
+{
+    _impl->addAssociatedData(associatedData.data(), associatedData.size());
 }
 
 const size_t AESCipherBuilder::DefaultAuthTagLength = 16;
@@ -384,10 +601,689 @@ AESCipherBuilder &AESCipherBuilder::setAuthTagLength(size_t length)
     return *this;
 }
 
+AESCipherBuilder &AESCipherBuilder::setMemoryStrategy(CipherMemoryStrategyFactory factory)
+{
+    _memoryStrategyFactory = std::move(factory);
+    return *this;
+}
+
+std::unique_ptr<CipherMemoryStrategyI> AESCipherBuilder::_createMemoryStrategy() const
+{
+    if (!_memoryStrategyFactory) {
+        return nullptr;
+    }
+    auto memoryStrategy = _memoryStrategyFactory();
+    if (!memoryStrategy) {
+        throw MoCOCrWException("Memory strategy factory returned no memory strategy.");
+    }
+    return memoryStrategy;
+}
+
+const size_t AESKey::DefaultAuthTagLength = 16;
+
+AESKey::AESKey(SymmetricCipherMode mode,
+               SymmetricCipherKeySize keySize,
+               const std::vector<uint8_t> &secretKey)
+        : _mode{mode}, _keySize{keySize}
+{
+    const EVP_CIPHER *cipher = getEVPCipherForModeAndSize(mode, keySize);
+
+    _encryptionCtx = _EVP_CIPHER_CTX_new();
+    _EVP_CipherInit_ex(_encryptionCtx.get(), cipher, nullptr, nullptr, nullptr, 1);
+
+    size_t expectedKeySize = _EVP_CIPHER_CTX_key_length(_encryptionCtx.get());
+    if (secretKey.size() != expectedKeySize) {
+        auto formatter = boost::format("Invalid size of Key %d bytes. Must be %d bytes.");
+        formatter % secretKey.size() % expectedKeySize;
+        throw MoCOCrWException(formatter.str());
+    }
+
+    // Expand the key once for each direction. AES-CBC decryption uses the inverse key schedule.
+    _EVP_CipherInit_ex(_encryptionCtx.get(), nullptr, nullptr, secretKey.data(), nullptr, 1);
+
+    _decryptionCtx = _EVP_CIPHER_CTX_new();
+    _EVP_CipherInit_ex(_decryptionCtx.get(), cipher, nullptr, secretKey.data(), nullptr, 0);
+}
+
+AESKey::AESKey(const AESKey &other) : _mode{other._mode}, _keySize{other._keySize}
+{
+    _encryptionCtx = _EVP_CIPHER_CTX_new();
+    _EVP_CIPHER_CTX_copy(_encryptionCtx.get(), other._encryptionCtx.get());
+    _decryptionCtx = _EVP_CIPHER_CTX_new();
+    _EVP_CIPHER_CTX_copy(_decryptionCtx.get(), other._decryptionCtx.get());
+}
+
+AESKey &AESKey::operator=(const AESKey &other)
+{
+    if (this != &other) {
+        AESKey copy{other};
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+AESKey::AESKey(AESKey &&other) = default;
+
+AESKey &AESKey::operator=(AESKey &&other) = default;
+
+AESKey::~AESKey() = default;
+
+AESKey AESKey::clone() const { return AESKey{*this}; }
+
+std::unique_ptr<AESCipher> AESKey::createEncryptor(const std::vector<uint8_t> &iv,
+                                                   SymmetricCipherPadding padding) const
+{
+    if (isAuthenticatedCipherMode(_mode)) {
+        throw MoCOCrWException(
+                "Specified cipher supports authenticated encryption."
+                " createAuthenticatedEncryptor() should be used instead.");
+    }
+    auto cipher = new AESCipher{_mode,
+                                _getEncryptionCtx(),
+                                padding,
+                                iv,
+                                AESCipher::Operation::Encryption};
+    return std::unique_ptr<AESCipher>(cipher);
+}
+
+std::unique_ptr<AESCipher> AESKey::createDecryptor(const std::vector<uint8_t> &iv,
+                                                   SymmetricCipherPadding padding) const
+{
+    if (isAuthenticatedCipherMode(_mode)) {
+        throw MoCOCrWException(
+                "Specified cipher supports authenticated encryption."
+                " createAuthenticatedDecryptor() should be used instead.");
+    }
+    auto cipher = new AESCipher{_mode,
+                                _getDecryptionCtx(),
+                                padding,
+                                iv,
+                                AESCipher::Operation::Decryption};
+    return std::unique_ptr<AESCipher>(cipher);
+}
+
+std::unique_ptr<AuthenticatedAESCipher> AESKey::createAuthenticatedEncryptor(
+        const std::vector<uint8_t> &iv, size_t authTagLength) const
+{
+    if (!isAuthenticatedCipherMode(_mode)) {
+        throw MoCOCrWException(
+                "Specified cipher does not support authenticated encryption."
+                " createEncryptor() should be used instead.");
+    }
+    auto cipher = new AuthenticatedAESCipher(_mode,
+                                             _getEncryptionCtx(),
+                                             iv,
+                                             authTagLength,
+                                             AESCipher::Operation::Encryption);
+    return std::unique_ptr<AuthenticatedAESCipher>(cipher);
+}
+
+std::unique_ptr<AuthenticatedAESCipher> AESKey::createAuthenticatedDecryptor(
+        const std::vector<uint8_t> &iv) const
+{
+    if (!isAuthenticatedCipherMode(_mode)) {
+        throw MoCOCrWException(
+                "Specified cipher does not support authenticated encryption."
+                " createDecryptor() should be used instead.");
+    }
+    auto cipher = new AuthenticatedAESCipher(_mode,
+                                             _getDecryptionCtx(),
+                                             iv,
+                                             DefaultAuthTagLength,
+                                             AESCipher::Operation::Decryption);
+    return std::unique_ptr<AuthenticatedAESCipher>(cipher);
+}
+
+const size_t AESKey::BulkSegmentSize = 1024 * 1024;
+
+namespace
+{
+const size_t AESBlockSize = 16;
+
+void checkOutputCapacity(size_t required, size_t outCapacity)
+{
+    if (outCapacity < required) {
+        auto formatter = boost::format(
+                "Output buffer too small: %d bytes are required but only %d are available.");
+        formatter % required % outCapacity;
+        throw MoCOCrWException(formatter.str());
+    }
+}
+
+/**
+ * Compute the counter block of the AES block with the given index.
+ *
+ * OpenSSL increments the whole 128 bit counter block as a big endian number.
+ */
+std::vector<uint8_t> ctrCounterBlockAt(const std::vector<uint8_t> &iv, uint64_t blockIndex)
+{
+    std::vector<uint8_t> counter(iv);
+    unsigned int carry = 0;
+    for (size_t i = counter.size(); i > 0; i--) {
+        unsigned int sum = counter[i - 1] + (blockIndex & 0xff) + carry;
+        counter[i - 1] = static_cast<uint8_t>(sum);
+        carry = sum >> 8;
+        blockIndex >>= 8;
+    }
+    return counter;
+}
+}  // namespace
+
+void AESKey::_checkBulkParameters(const std::vector<uint8_t> &iv,
+                                  size_t length,
+                                  size_t outCapacity) const
+{
+    if (iv.size() != AESBlockSize) {
+        auto formatter = boost::format("Invalid size of IV %d bytes. Must be %d bytes.");
+        formatter % iv.size() % AESBlockSize;
+        throw MoCOCrWException(formatter.str());
+    }
+    checkOutputCapacity(length, outCapacity);
+}
+
+size_t AESKey::bulkEncrypt(const std::vector<uint8_t> &iv,
+                           const uint8_t *in,
+                           size_t length,
+                           uint8_t *out,
+                           size_t outCapacity,
+                           unsigned int numberOfThreads) const
+{
+    if (_mode != SymmetricCipherMode::CTR) {
+        throw MoCOCrWException(
+                "Parallel bulk encryption is only supported for AES-CTR. AES-CBC encryption is "
+                "inherently serial.");
+    }
+    // Encryption and decryption are the same operation in CTR mode.
+    return bulkDecrypt(
+            iv, in, length, out, outCapacity, SymmetricCipherPadding::NO, numberOfThreads);
+}
+
+std::vector<uint8_t> AESKey::bulkEncrypt(const std::vector<uint8_t> &iv,
+                                         const std::vector<uint8_t> &plaintext,
+                                         unsigned int numberOfThreads) const
+{
+    std::vector<uint8_t> ciphertext(plaintext.size());
+    bulkEncrypt(iv,
+                plaintext.data(),
+                plaintext.size(),
+                ciphertext.data(),
+                ciphertext.size(),
+                numberOfThreads);
+    return ciphertext;
+}
+
+size_t AESKey::bulkDecrypt(const std::vector<uint8_t> &iv,
+                           const uint8_t *in,
+                           size_t length,
+                           uint8_t *out,
+                           size_t outCapacity,
+                           SymmetricCipherPadding padding,
+                           unsigned int numberOfThreads) const
+{
+    if (isAuthenticatedCipherMode(_mode)) {
+        throw MoCOCrWException(
+                "Parallel bulk decryption is not supported for authenticated cipher modes.");
+    }
+    _checkBulkParameters(iv, length, outCapacity);
+
+    const bool isCBC = _mode == SymmetricCipherMode::CBC;
+    if (isCBC && length % AESBlockSize != 0) {
+        throw MoCOCrWException("AES-CBC ciphertext length must be a multiple of the block size.");
+    }
+
+    const EVP_CIPHER_CTX *keyCtx = isCBC ? _getDecryptionCtx() : _getEncryptionCtx();
+    size_t segments = std::max<size_t>(1, (length + BulkSegmentSize - 1) / BulkSegmentSize);
+
+    // The IV of every segment is determined up front because in-place decryption overwrites the
+    // ciphertext blocks that CBC chains.
+    std::vector<std::vector<uint8_t>> segmentIVs(segments);
+    for (size_t i = 0; i < segments; i++) {
+        if (!isCBC) {
+            segmentIVs[i] = ctrCounterBlockAt(iv, i * (BulkSegmentSize / AESBlockSize));
+        } else if (i == 0) {
+            segmentIVs[i] = iv;
+        } else {
+            const uint8_t *previousBlock = in + i * BulkSegmentSize - AESBlockSize;
+            segmentIVs[i].assign(previousBlock, previousBlock + AESBlockSize);
+        }
+    }
+
+    size_t lastSegmentLength = 0;
+    detail::parallelFor(segments, numberOfThreads, [&](size_t i) {
+        size_t offset = i * BulkSegmentSize;
+        size_t segmentLength = std::min(BulkSegmentSize, length - offset);
+        bool isLast = i == segments - 1;
+
+        auto ctx = _EVP_CIPHER_CTX_new();
+        _EVP_CIPHER_CTX_copy(ctx.get(), keyCtx);
+        _EVP_CipherInit_ex(ctx.get(), nullptr, nullptr, nullptr, segmentIVs[i].data(), 0);
+        // Only the last segment of a CBC message carries padding.
+        bool removePadding = isCBC && isLast && padding == SymmetricCipherPadding::PKCS;
+        _EVP_CIPHER_CTX_set_padding(ctx.get(), removePadding ? 1 : 0);
+
+        int updateLength = 0;
+        if (segmentLength > 0) {
+            _EVP_CipherUpdate(
+                    ctx.get(), out + offset, &updateLength, in + offset, segmentLength);
+        }
+        int finalLength = 0;
+        try {
+            _EVP_CipherFinal_ex(ctx.get(), out + offset + updateLength, &finalLength);
+        } catch (const OpenSSLException &) {
+            throw MoCOCrWException("Unable to decrypt ciphertext: invalid padding.");
+        }
+
+        if (isLast) {
+            lastSegmentLength = updateLength + finalLength;
+        }
+    });
+
+    return (segments - 1) * BulkSegmentSize + lastSegmentLength;
+}
+
+std::vector<uint8_t> AESKey::bulkDecrypt(const std::vector<uint8_t> &iv,
+                                         const std::vector<uint8_t> &ciphertext,
+                                         SymmetricCipherPadding padding,
+                                         unsigned int numberOfThreads) const
+{
+    std::vector<uint8_t> plaintext(ciphertext.size());
+    plaintext.resize(bulkDecrypt(iv,
+                                 ciphertext.data(),
+                                 ciphertext.size(),
+                                 plaintext.data(),
+                                 plaintext.size(),
+                                 padding,
+                                 numberOfThreads));
+    return plaintext;
+}
+
+SeekableCTRDecryptor::SeekableCTRDecryptor(const AESKey &key, const std::vector<uint8_t> &iv)
+        : _key{key}, _iv{iv}
+{
+    if (_key.getMode() != SymmetricCipherMode::CTR) {
+        throw MoCOCrWException("SeekableCTRDecryptor requires an AES-CTR key.");
+    }
+    if (_iv.size() != AESBlockSize) {
+        auto formatter = boost::format("Invalid size of IV %d bytes. Must be %d bytes.");
+        formatter % _iv.size() % AESBlockSize;
+        throw MoCOCrWException(formatter.str());
+    }
+}
+
+void SeekableCTRDecryptor::decrypt(uint64_t offset,
+                                   const uint8_t *in,
+                                   size_t length,
+                                   uint8_t *out) const
+{
+    if (length == 0) {
+        return;
+    }
+    if (length > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        throw MoCOCrWException("Message is too big.");
+    }
+
+    auto counter = ctrCounterBlockAt(_iv, offset / AESBlockSize);
+    auto ctx = _EVP_CIPHER_CTX_new();
+    _EVP_CIPHER_CTX_copy(ctx.get(), _key._getEncryptionCtx());
+    _EVP_CipherInit_ex(ctx.get(), nullptr, nullptr, nullptr, counter.data(), 0);
+
+    /* Skip the key stream in front of the offset within the first block. */
+    size_t skip = offset % AESBlockSize;
+    if (skip > 0) {
+        uint8_t scratch[AESBlockSize] = {};
+        int len = 0;
+        _EVP_CipherUpdate(ctx.get(), scratch, &len, scratch, skip);
+        /* Encrypting zeros leaves raw key stream in the buffer */
+        OPENSSL_cleanse(scratch, sizeof(scratch));
+    }
+
+    int len = 0;
+    _EVP_CipherUpdate(ctx.get(), out, &len, in, length);
+}
+
+std::vector<uint8_t> SeekableCTRDecryptor::decrypt(uint64_t offset,
+                                                   const std::vector<uint8_t> &ciphertext) const
+{
+    std::vector<uint8_t> plaintext(ciphertext.size());
+    decrypt(offset, ciphertext.data(), ciphertext.size(), plaintext.data());
+    return plaintext;
+}
+
+const size_t GCMNonceSequencer::NonceLength = 12;
+const size_t GCMNonceSequencer::FixedFieldLength = 4;
+
+GCMNonceSequencer::GCMNonceSequencer(const std::vector<uint8_t> &fixedField,
+                                     uint64_t initialInvocationCount,
+                                     uint64_t invocationLimit)
+        : _invocationCount{initialInvocationCount}, _invocationLimit{invocationLimit}
+{
+    if (fixedField.size() != FixedFieldLength) {
+        auto formatter = boost::format("Invalid size of fixed field %d bytes. Must be %d bytes.");
+        formatter % fixedField.size() % FixedFieldLength;
+        throw MoCOCrWException(formatter.str());
+    }
+    std::copy(fixedField.begin(), fixedField.end(), _fixedField);
+}
+
+void GCMNonceSequencer::next(uint8_t *nonce)
+{
+    /* Never increment beyond the limit, so the counter can't wrap around and repeat nonces. */
+    uint64_t invocation = _invocationCount.load(std::memory_order_relaxed);
+    do {
+        if (invocation >= _invocationLimit) {
+            throw MoCOCrWException("Invocation limit of the nonce sequencer is reached.");
+        }
+    } while (!_invocationCount.compare_exchange_weak(invocation,
+                                                     invocation + 1,
+                                                     std::memory_order_relaxed));
+
+    std::copy(_fixedField, _fixedField + FixedFieldLength, nonce);
+    for (size_t i = 0; i < sizeof(invocation); i++) {
+        nonce[NonceLength - 1 - i] = static_cast<uint8_t>(invocation >> (8 * i));
+    }
+}
+
+std::vector<uint8_t> GCMNonceSequencer::next()
+{
+    std::vector<uint8_t> nonce(NonceLength);
+    next(nonce.data());
+    return nonce;
+}
+
+uint64_t GCMNonceSequencer::getInvocationCount() const
+{
+    return _invocationCount.load(std::memory_order_relaxed);
+}
+
+const EVP_CIPHER_CTX *AESKey::_getEncryptionCtx() const
+{
+    if (!_encryptionCtx) {
+        throw MoCOCrWException("AESKey was moved from.");
+    }
+    return _encryptionCtx.get();
+}
+
+const EVP_CIPHER_CTX *AESKey::_getDecryptionCtx() const
+{
+    if (!_decryptionCtx) {
+        throw MoCOCrWException("AESKey was moved from.");
+    }
+    return _decryptionCtx.get();
+}
+
+namespace
+{
+SSL_EVP_CIPHER_CTX_Ptr copyKeyContext(const EVP_CIPHER_CTX *keyCtx)
+{
+    auto ctx = _EVP_CIPHER_CTX_new();
+    _EVP_CIPHER_CTX_copy(ctx.get(), keyCtx);
+    return ctx;
+}
+
+/**
+ * Start a new message on a keyed AEAD context: set the nonce and process the associated data.
+ *
+ * The key schedule of the context is kept, so a context can be reused for many messages.
+ */
+void startAEADMessage(EVP_CIPHER_CTX *ctx,
+                      bool encrypt,
+                      const uint8_t *nonce,
+                      size_t nonceLength,
+                      const uint8_t *associatedData,
+                      size_t associatedDataLength,
+                      size_t messageLength,
+                      size_t authTagLength)
+{
+    if (nonceLength == 0) {
+        throw MoCOCrWException(
+                "IV is empty, but authenticated cipher modes do not support empty IVs.");
+    }
+    if (authTagLength == 0 || authTagLength > EVP_GCM_TLS_TAG_LEN) {
+        throw MoCOCrWException("Invalid length of the authentication tag.");
+    }
+    if (messageLength > static_cast<size_t>(std::numeric_limits<int>::max()) ||
+        associatedDataLength > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        throw MoCOCrWException("Message is too big.");
+    }
+
+    _EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, nonceLength, nullptr);
+    _EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, nonce, encrypt);
+
+    if (associatedDataLength > 0) {
+        int len = 0;
+        _EVP_CipherUpdate(ctx, nullptr, &len, associatedData, associatedDataLength);
+    }
+}
+
+size_t sealMessage(EVP_CIPHER_CTX *ctx,
+                   const uint8_t *nonce,
+                   size_t nonceLength,
+                   const uint8_t *associatedData,
+                   size_t associatedDataLength,
+                   const uint8_t *plaintext,
+                   size_t plaintextLength,
+                   uint8_t *out,
+                   size_t authTagLength)
+{
+    startAEADMessage(ctx,
+                     true,
+                     nonce,
+                     nonceLength,
+                     associatedData,
+                     associatedDataLength,
+                     plaintextLength,
+                     authTagLength);
+
+    int len = 0;
+    if (plaintextLength > 0) {
+        _EVP_CipherUpdate(ctx, out, &len, plaintext, plaintextLength);
+    }
+    int finalLen = 0;
+    _EVP_CipherFinal_ex(ctx, out + len, &finalLen);
+    size_t ciphertextLength = len + finalLen;
+
+    _EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, authTagLength, out + ciphertextLength);
+
+    return ciphertextLength + authTagLength;
+}
+}  // namespace
+
+size_t aeadSeal(const AESKey &key,
+                const uint8_t *nonce,
+                size_t nonceLength,
+                const uint8_t *associatedData,
+                size_t associatedDataLength,
+                const uint8_t *plaintext,
+                size_t plaintextLength,
+                uint8_t *out,
+                size_t outCapacity,
+                size_t authTagLength)
+{
+    if (!isAuthenticatedCipherMode(key.getMode())) {
+        throw MoCOCrWException("aeadSeal() requires an authenticated cipher mode.");
+    }
+    checkAEADNonceLength(key.getMode(), nonceLength);
+    checkOutputCapacity(plaintextLength + authTagLength, outCapacity);
+
+    auto ctx = copyKeyContext(key._getEncryptionCtx());
+    return sealMessage(ctx.get(),
+                       nonce,
+                       nonceLength,
+                       associatedData,
+                       associatedDataLength,
+                       plaintext,
+                       plaintextLength,
+                       out,
+                       authTagLength);
+}
+
+std::vector<uint8_t> aeadSeal(const AESKey &key,
+                              const std::vector<uint8_t> &nonce,
+                              const std::vector<uint8_t> &associatedData,
+                              const std::vector<uint8_t> &plaintext,
+                              size_t authTagLength)
+{
+    std::vector<uint8_t> sealed(plaintext.size() + authTagLength);
+    aeadSeal(key,
+             nonce.data(),
+             nonce.size(),
+             associatedData.data(),
+             associatedData.size(),
+             plaintext.data(),
+             plaintext.size(),
+             sealed.data(),
+             sealed.size(),
+             authTagLength);
+    return sealed;
+}
+
+size_t aeadOpen(const AESKey &key,
+                const uint8_t *nonce,
+                size_t nonceLength,
+                const uint8_t *associatedData,
+                size_t associatedDataLength,
+                const uint8_t *sealed,
+                size_t sealedLength,
+                uint8_t *out,
+                size_t outCapacity,
+                size_t authTagLength)
+{
+    if (!isAuthenticatedCipherMode(key.getMode())) {
+        throw MoCOCrWException("aeadOpen() requires an authenticated cipher mode.");
+    }
+    checkAEADNonceLength(key.getMode(), nonceLength);
+    if (sealedLength < authTagLength) {
+        throw MoCOCrWException("Sealed message is shorter than the authentication tag.");
+    }
+    size_t ciphertextLength = sealedLength - authTagLength;
+    checkOutputCapacity(ciphertextLength, outCapacity);
+
+    auto ctx = copyKeyContext(key._getDecryptionCtx());
+    startAEADMessage(ctx.get(),
+                     false,
+                     nonce,
+                     nonceLength,
+                     associatedData,
+                     associatedDataLength,
+                     ciphertextLength,
+                     authTagLength);
+
+    // The tag must be copied before in-place decryption overwrites the ciphertext.
+    uint8_t tag[EVP_GCM_TLS_TAG_LEN];
+    std::copy(sealed + ciphertextLength, sealed + sealedLength, tag);
+    _EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_TAG, authTagLength, tag);
+
+    int len = 0;
+    if (ciphertextLength > 0) {
+        _EVP_CipherUpdate(ctx.get(), out, &len, sealed, ciphertextLength);
+    }
+    int finalLen = 0;
+    try {
+        _EVP_CipherFinal_ex(ctx.get(), out + len, &finalLen);
+    } catch (const OpenSSLException &) {
+        OPENSSL_cleanse(out, ciphertextLength);
+        throw MoCOCrWException(
+                "Unable to decrypt authenticated ciphertext. Either ciphertext was"
+                " modified or wrong combination of key, iv and authTag was used.");
+    }
+
+    return len + finalLen;
+}
+
+std::vector<uint8_t> aeadOpen(const AESKey &key,
+                              const std::vector<uint8_t> &nonce,
+                              const std::vector<uint8_t> &associatedData,
+                              const std::vector<uint8_t> &sealed,
+                              size_t authTagLength)
+{
+    std::vector<uint8_t> plaintext(sealed.size() > authTagLength ? sealed.size() - authTagLength
+                                                                 : 0);
+    plaintext.resize(aeadOpen(key,
+                              nonce.data(),
+                              nonce.size(),
+                              associatedData.data(),
+                              associatedData.size(),
+                              sealed.data(),
+                              sealed.size(),
+                              plaintext.data(),
+                              plaintext.size(),
+                              authTagLength));
+    return plaintext;
+}
+
+size_t aeadSealBatchLength(const std::vector<AEADRecord> &records, size_t authTagLength)
+{
+    size_t length = 0;
+    for (const auto &record : records) {
+        length += record.plaintextLength + authTagLength;
+    }
+    return length;
+}
+
+std::vector<size_t> aeadSealBatch(const AESKey &key,
+                                  const std::vector<AEADRecord> &records,
+                                  uint8_t *out,
+                                  size_t outCapacity,
+                                  size_t authTagLength,
+                                  unsigned int numberOfThreads)
+{
+    if (!isAuthenticatedCipherMode(key.getMode())) {
+        throw MoCOCrWException("aeadSealBatch() requires an authenticated cipher mode.");
+    }
+
+    std::vector<size_t> offsets(records.size() + 1, 0);
+    for (size_t i = 0; i < records.size(); i++) {
+        checkAEADNonceLength(key.getMode(), records[i].nonceLength);
+        offsets[i + 1] = offsets[i] + records[i].plaintextLength + authTagLength;
+    }
+    checkOutputCapacity(offsets.back(), outCapacity);
+
+    // Records are handed out in groups so that the per-worker context setup is amortized.
+    const size_t recordsPerItem = 64;
+    size_t items = (records.size() + recordsPerItem - 1) / recordsPerItem;
+    const EVP_CIPHER_CTX *keyCtx = key._getEncryptionCtx();
+
+    detail::parallelFor(items, numberOfThreads, [&](size_t item) {
+        auto ctx = copyKeyContext(keyCtx);
+        size_t last = std::min(records.size(), (item + 1) * recordsPerItem);
+        for (size_t i = item * recordsPerItem; i < last; i++) {
+            const auto &record = records[i];
+            sealMessage(ctx.get(),
+                        record.nonce,
+                        record.nonceLength,
+                        record.associatedData,
+                        record.associatedDataLength,
+                        record.plaintext,
+                        record.plaintextLength,
+                        out + offsets[i],
+                        authTagLength);
+        }
+    });
+
+    return offsets;
+}
+
+AEADBatch aeadSealBatch(const AESKey &key,
+                        const std::vector<AEADRecord> &records,
+                        size_t authTagLength,
+                        unsigned int numberOfThreads)
+{
+    AEADBatch batch;
+    batch.arena.resize(aeadSealBatchLength(records, authTagLength));
+    batch.offsets = aeadSealBatch(key,
+                                  records,
+                                  batch.arena.data(),
+                                  batch.arena.size(),
+                                  authTagLength,
+                                  numberOfThreads);
+    return batch;
+}
+
 bool isAuthenticatedCipherMode(SymmetricCipherMode mode)
 {
     switch (mode) {
         case SymmetricCipherMode::GCM:
+        case SymmetricCipherMode::CHACHA20_POLY1305:
             return true;
         case SymmetricCipherMode::CTR:
             //[[fallthrough]];
@@ -417,8 +1313,13 @@ std::unique_ptr<AESCipher> AESCipherBuilder::buildEncryptor()
     }
     const std::vector<uint8_t> &iv = (_iv.size() == 0) ? newIV : _iv;
 
-    auto cipher = new AESCipher{
-            _mode, _keySize, _padding, _secretKey, iv, AESCipher::Operation::Encryption};
+    auto cipher = new AESCipher{_mode,
+                                _keySize,
+                                _padding,
+                                _secretKey,
+                                iv,
+                                AESCipher::Operation::Encryption,
+                                _createMemoryStrategy()};
     return std::unique_ptr<AESCipher>(cipher);
 }
 
@@ -429,8 +1330,13 @@ std::unique_ptr<AESCipher> AESCipherBuilder::buildDecryptor()
                 "Specified cipher supports authenticated encryption."
                 " buildAuthenticatedDecryptor() should be used instead.");
     }
-    auto cipher = new AESCipher{
-            _mode, _keySize, _padding, _secretKey, _iv, AESCipher::Operation::Decryption};
+    auto cipher = new AESCipher{_mode,
+                                _keySize,
+                                _padding,
+                                _secretKey,
+                                _iv,
+                                AESCipher::Operation::Decryption,
+                                _createMemoryStrategy()};
     return std::unique_ptr<AESCipher>(cipher);
 }
 
@@ -456,7 +1362,8 @@ std::unique_ptr<AuthenticatedAESCipher> AESCipherBuilder::buildAuthenticatedEncr
                                              _secretKey,
                                              iv,
                                              _authTagLength,
-                                             AESCipher::Operation::Encryption);
+                                             AESCipher::Operation::Encryption,
+                                             _createMemoryStrategy());
     return std::unique_ptr<AuthenticatedAESCipher>(cipher);
 }
 
@@ -479,7 +1386,8 @@ std::unique_ptr<AuthenticatedAESCipher> AESCipherBuilder::buildAuthenticatedDecr
                                              _secretKey,
                                              _iv,
                                              _authTagLength,
-                                             AESCipher::Operation::Decryption);
+                                             AESCipher::Operation::Decryption,
+                                             _createMemoryStrategy());
     return std::unique_ptr<AuthenticatedAESCipher>(cipher);
 }
 
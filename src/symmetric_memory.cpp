@@ -21,8 +21,19 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cerrno>
+#include <cstring>
 #include <queue>
 
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <openssl/evp.h>
+
+#include "mococrw/error.h"
+#include "mococrw/openssl_wrap.h"
+#include "mococrw/util.h"
+
 namespace mococrw
 {
 void QueueOfVectorsMemoryStrategy::write(std::vector<uint8_t> chunk)
@@ -117,4 +128,268 @@ void QueueOfVectorsMemoryStrategy::_readPartialBlock(size_t requestedSize,
     _totalBytesStored -= std::distance(begin, end);
 }
 
+RingBufferMemoryStrategy::RingBufferMemoryStrategy(size_t initialCapacity)
+        : _buffer(initialCapacity)
+{
+}
+
+void RingBufferMemoryStrategy::write(std::vector<uint8_t> chunk)
+{
+    if (chunk.empty()) {
+        return;
+    }
+    _reserve(_size + chunk.size());
+
+    size_t tail = (_head + _size) % _buffer.size();
+    size_t firstPart = std::min(chunk.size(), _buffer.size() - tail);
+    std::memcpy(_buffer.data() + tail, chunk.data(), firstPart);
+    std::memcpy(_buffer.data(), chunk.data() + firstPart, chunk.size() - firstPart);
+    _size += chunk.size();
+}
+
+std::vector<uint8_t> RingBufferMemoryStrategy::read(size_t chunkSize)
+{
+    size_t length = std::min(chunkSize, _size);
+    std::vector<uint8_t> bufferToReturn(length);
+    if (length == 0) {
+        return bufferToReturn;
+    }
+
+    size_t firstPart = std::min(length, _buffer.size() - _head);
+    std::memcpy(bufferToReturn.data(), _buffer.data() + _head, firstPart);
+    std::memcpy(bufferToReturn.data() + firstPart, _buffer.data(), length - firstPart);
+
+    _size -= length;
+    // Rewind an empty buffer, so subsequent writes and reads don't have to wrap around.
+    _head = (_size == 0) ? 0 : (_head + length) % _buffer.size();
+    return bufferToReturn;
+}
+
+std::vector<uint8_t> RingBufferMemoryStrategy::readAll() { return read(_size); }
+
+void RingBufferMemoryStrategy::_reserve(size_t requiredCapacity)
+{
+    if (requiredCapacity <= _buffer.size()) {
+        return;
+    }
+
+    std::vector<uint8_t> newBuffer(std::max(requiredCapacity, 2 * _buffer.size()));
+    if (_size > 0) {
+        // Linearize the stored data at the beginning of the new buffer.
+        size_t firstPart = std::min(_size, _buffer.size() - _head);
+        std::memcpy(newBuffer.data(), _buffer.data() + _head, firstPart);
+        std::memcpy(newBuffer.data() + firstPart, _buffer.data(), _size - firstPart);
+    }
+    _buffer = std::move(newBuffer);
+    _head = 0;
+}
+
+/* Encrypts the data of the spill file. CTR mode keeps the file size equal to the size of the
+ * data and allows the file to be written and read back sequentially with two independent
+ * contexts, which both start at the beginning of the same key stream. */
+class BoundedMemoryStrategy::SpillCipher
+{
+public:
+    SpillCipher() { rekey(); }
+
+    /* Must be called whenever the file starts over, as the key stream would be reused otherwise. */
+    void rekey()
+    {
+        std::vector<uint8_t> key(32);
+        std::vector<uint8_t> iv(16);
+        utility::Finally keyDeleter([&key]() { utility::vectorCleanse(key); });
+        utility::RandomPool::fill(key.data(), key.size());
+        utility::RandomPool::fill(iv.data(), iv.size());
+
+        const EVP_CIPHER *cipher = openssl::_fetchCachedCipher(EVP_aes_256_ctr());
+        for (auto *ctx : {&_writeCtx, &_readCtx}) {
+            *ctx = openssl::_EVP_CIPHER_CTX_new();
+            openssl::_EVP_CipherInit_ex(ctx->get(), cipher, nullptr, key.data(), iv.data(), 1);
+        }
+    }
+
+    void encrypt(const uint8_t *in, uint8_t *out, size_t length)
+    {
+        _apply(_writeCtx, in, out, length);
+    }
+
+    void decrypt(uint8_t *data, size_t length) { _apply(_readCtx, data, data, length); }
+
+private:
+    static void _apply(openssl::SSL_EVP_CIPHER_CTX_Ptr &ctx,
+                       const uint8_t *in,
+                       uint8_t *out,
+                       size_t length)
+    {
+        while (length > 0) {
+            int part = static_cast<int>(std::min<size_t>(length, 1 << 30));
+            int outLength = part;
+            openssl::_EVP_CipherUpdate(ctx.get(), out, &outLength, in, part);
+            in += part;
+            out += part;
+            length -= part;
+        }
+    }
+
+    openssl::SSL_EVP_CIPHER_CTX_Ptr _writeCtx;
+    openssl::SSL_EVP_CIPHER_CTX_Ptr _readCtx;
+};
+
+BoundedMemoryStrategy::BoundedMemoryStrategy(size_t highWaterMark,
+                                             OverflowPolicy policy,
+                                             std::string spillDirectory)
+        : _highWaterMark(highWaterMark)
+        , _policy(policy)
+        , _spillDirectory(std::move(spillDirectory))
+        , _memory(std::min<size_t>(highWaterMark, 64 * 1024))
+{
+    if (_highWaterMark == 0) {
+        throw MoCOCrWException("The high-water mark must not be 0.");
+    }
+}
+
+BoundedMemoryStrategy::~BoundedMemoryStrategy()
+{
+    if (_spillFd >= 0) {
+        close(_spillFd);
+    }
+}
+
+size_t BoundedMemoryStrategy::availableCapacity() const
+{
+    if (_policy == OverflowPolicy::SpillToFile) {
+        return std::numeric_limits<size_t>::max();
+    }
+    return _memory.size() < _highWaterMark ? _highWaterMark - _memory.size() : 0;
+}
+
+void BoundedMemoryStrategy::write(std::vector<uint8_t> chunk)
+{
+    _checkNotFailed();
+    if (_policy == OverflowPolicy::Backpressure) {
+        // The cipher respects availableCapacity(), only the final block may exceed the limit.
+        _memory.write(std::move(chunk));
+        return;
+    }
+
+    if (_spilledSize > 0) {
+        // Keep the order: everything after the first spilled byte goes to the file, too.
+        _spill(chunk.data(), chunk.size());
+        return;
+    }
+
+    size_t inMemory = std::min(chunk.size(), _highWaterMark - _memory.size());
+    if (inMemory == chunk.size()) {
+        _memory.write(std::move(chunk));
+        return;
+    }
+    _memory.write({chunk.begin(), chunk.begin() + inMemory});
+    _spill(chunk.data() + inMemory, chunk.size() - inMemory);
+}
+
+std::vector<uint8_t> BoundedMemoryStrategy::read(size_t chunkSize)
+{
+    _checkNotFailed();
+    if (_memory.size() == 0 && _spilledSize > 0) {
+        _refillFromFile();
+    }
+    return _memory.read(chunkSize);
+}
+
+std::vector<uint8_t> BoundedMemoryStrategy::readAll()
+{
+    std::vector<uint8_t> bufferToReturn;
+    bufferToReturn.reserve(size());
+    while (size() > 0) {
+        auto chunk = read(size());
+        bufferToReturn.insert(bufferToReturn.end(), chunk.begin(), chunk.end());
+    }
+    return bufferToReturn;
+}
+
+void BoundedMemoryStrategy::_checkNotFailed() const
+{
+    if (_failed) {
+        throw MoCOCrWException("The temporary file could not be written before, data was lost.");
+    }
+}
+
+void BoundedMemoryStrategy::_spill(const uint8_t *data, size_t length)
+{
+    if (_spillFd < 0) {
+        std::string path = _spillDirectory + "/mococrw-spill-XXXXXX";
+        std::vector<char> pathTemplate(path.begin(), path.end());
+        pathTemplate.push_back('\0');
+        _spillFd = mkstemp(pathTemplate.data());
+        if (_spillFd < 0) {
+            throw MoCOCrWException("Could not create temporary file in " + _spillDirectory + ": " +
+                                   std::strerror(errno));
+        }
+        // The file stays accessible through the descriptor only.
+        unlink(pathTemplate.data());
+        _spillCipher = std::make_unique<SpillCipher>();
+    }
+
+    // Encrypt in pieces, so no copy of the whole chunk is needed.
+    std::vector<uint8_t> encrypted(std::min<size_t>(length, 64 * 1024));
+    size_t writeOffset = _spillReadOffset + _spilledSize;
+    while (length > 0) {
+        size_t part = std::min(length, encrypted.size());
+        _spillCipher->encrypt(data, encrypted.data(), part);
+        size_t partWritten = 0;
+        while (partWritten < part) {
+            auto written = pwrite(
+                    _spillFd, encrypted.data() + partWritten, part - partWritten, writeOffset);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                // The spill cipher is already ahead of the file, the stored data is lost.
+                _failed = true;
+                throw MoCOCrWException(std::string("Could not write to temporary file: ") +
+                                       std::strerror(errno));
+            }
+            partWritten += written;
+            writeOffset += written;
+            _spilledSize += written;
+        }
+        data += part;
+        length -= part;
+    }
+    utility::vectorCleanse(encrypted);
+}
+
+void BoundedMemoryStrategy::_refillFromFile()
+{
+    std::vector<uint8_t> chunk(std::min(_spilledSize, _highWaterMark));
+    size_t filled = 0;
+    while (filled < chunk.size()) {
+        auto bytesRead = pread(
+                _spillFd, chunk.data() + filled, chunk.size() - filled, _spillReadOffset + filled);
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesRead <= 0) {
+            throw MoCOCrWException(std::string("Could not read from temporary file: ") +
+                                   (bytesRead < 0 ? std::strerror(errno) : "unexpected EOF"));
+        }
+        filled += bytesRead;
+    }
+
+    _spillCipher->decrypt(chunk.data(), chunk.size());
+    _spillReadOffset += filled;
+    _spilledSize -= filled;
+    if (_spilledSize == 0) {
+        // All spilled data was read back, reuse the file from its beginning with a new key.
+        _spillReadOffset = 0;
+        if (ftruncate(_spillFd, 0) != 0) {
+            _failed = true;
+            throw MoCOCrWException(std::string("Could not truncate temporary file: ") +
+                                   std::strerror(errno));
+        }
+        _spillCipher->rekey();
+    }
+    _memory.write(std::move(chunk));
+}
+
 }  // namespace mococrw
@@ -19,7 +19,13 @@
 
 #include "mococrw/util.h"
 
+#include <pthread.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 
 #include "mococrw/openssl_wrap.h"
@@ -73,9 +79,85 @@ std::vector<uint8_t> fromHex(const std::string &hexData)
 std::vector<uint8_t> cryptoRandomBytes(size_t length)
 {
     std::vector<uint8_t> buffer(length);
-    openssl::_RAND_bytes(buffer.data(), buffer.size());
+    RandomPool::fill(buffer.data(), buffer.size());
+    return buffer;
+}
+
+namespace
+{
+const size_t randomBlockSize = 4096;
+
+/* Incremented in the child process after every fork(). */
+std::atomic<uint64_t> forkGeneration{0};
+
+void onForkInChild() { forkGeneration.fetch_add(1, std::memory_order_relaxed); }
+
+struct ThreadRandomBuffer
+{
+    std::array<uint8_t, randomBlockSize> bytes;
+    /* The unused bytes are bytes[0, available). */
+    size_t available = 0;
+    uint64_t generation = 0;
+
+    ~ThreadRandomBuffer() { discard(); }
+
+    void discard()
+    {
+        OPENSSL_cleanse(bytes.data(), available);
+        available = 0;
+    }
+};
+
+ThreadRandomBuffer &threadRandomBuffer()
+{
+    static const bool forkHandlerRegistered = [] {
+        return pthread_atfork(nullptr, nullptr, onForkInChild) == 0;
+    }();
+    (void)forkHandlerRegistered;
+
+    thread_local ThreadRandomBuffer buffer;
     return buffer;
 }
 
+void randomBytesFromOpenSSL(uint8_t *buffer, size_t length)
+{
+    while (length > 0) {
+        auto chunk = std::min<size_t>(length, std::numeric_limits<int>::max());
+        openssl::_RAND_bytes(buffer, static_cast<int>(chunk));
+        buffer += chunk;
+        length -= chunk;
+    }
+}
+}  // namespace
+
+const size_t RandomPool::BlockSize = randomBlockSize;
+
+void RandomPool::fill(uint8_t *buffer, size_t length)
+{
+    if (length >= BlockSize) {
+        randomBytesFromOpenSSL(buffer, length);
+        return;
+    }
+
+    auto &pool = threadRandomBuffer();
+    auto generation = forkGeneration.load(std::memory_order_relaxed);
+    if (pool.generation != generation) {
+        pool.discard();
+        pool.generation = generation;
+    }
+    if (pool.available < length) {
+        pool.discard();
+        randomBytesFromOpenSSL(pool.bytes.data(), pool.bytes.size());
+        pool.available = pool.bytes.size();
+    }
+
+    pool.available -= length;
+    uint8_t *served = pool.bytes.data() + pool.available;
+    std::copy(served, served + length, buffer);
+    OPENSSL_cleanse(served, length);
+}
+
+void RandomPool::discardBuffer() { threadRandomBuffer().discard(); }
+
 }  // namespace utility
 }  // namespace mococrw
@@ -0,0 +1,40 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "mococrw/verification_result.h"
+#include "mococrw/openssl_wrap.h"
+
+namespace mococrw
+{
+std::string VerificationResult::getMessage() const
+{
+    switch (_status) {
+        case VerificationStatus::Valid:
+            return "Verification succeeded.";
+        case VerificationStatus::Mismatch:
+            return "Verification failed. The value doesn't match the data.";
+        case VerificationStatus::InvalidLength:
+            return "Verification failed. The length of the value is invalid.";
+        case VerificationStatus::CertificateInvalid:
+            return "Certificate verification failed: " +
+                   openssl::_X509_verify_cert_error_string(_detailCode);
+    }
+    return "Verification failed.";
+}
+
+}  // namespace mococrw
@@ -208,7 +208,7 @@ X509Certificate::VerificationContext::setVerificationCheckTime(Asn1Time checkTim
     try {
         _verificationCheckTime = checkTime.toTimeT();
     } catch (const OpenSSLException &e) {
-        throw MoCOCrWException(e.what());
+        throw MoCOCrWException(e);
     }
     return *this;
 }
@@ -221,7 +221,25 @@ void X509Certificate::verify(const std::vector<X509Certificate> &trustStore,
     verify(ctx);
 }
 
+VerificationResult X509Certificate::tryVerify(
+        const std::vector<X509Certificate> &trustStore,
+        const std::vector<X509Certificate> &intermediateCAs) const
+{
+    VerificationContext ctx;
+    ctx.addTrustedCertificates(trustStore).addIntermediateCertificates(intermediateCAs);
+    return tryVerify(ctx);
+}
+
 void X509Certificate::verify(const X509Certificate::VerificationContext &ctx) const
+{
+    auto result = tryVerify(ctx);
+    if (!result) {
+        throw MoCOCrWException(_X509_verify_cert_error_string(result.getDetailCode()));
+    }
+}
+
+VerificationResult X509Certificate::tryVerify(
+        const X509Certificate::VerificationContext &ctx) const
 {
     ctx.validityCheck();
 
@@ -274,11 +292,11 @@ void X509Certificate::verify(const X509Certificate::VerificationContext &ctx) co
         _X509_STORE_CTX_set0_crls(verifyCtx.get(), crlStack.get());
     }
 
-    try {
-        _X509_verify_cert(verifyCtx.get());
-    } catch (const OpenSSLException &error) {
-        throw MoCOCrWException(error.what());
+    int error = _X509_tryVerifyCert(verifyCtx.get());
+    if (error != X509_V_OK) {
+        return VerificationResult{VerificationStatus::CertificateInvalid, error};
     }
+    return VerificationResult::valid();
 }
 
 DistinguishedName X509Certificate::getSubjectDistinguishedName() const
@@ -0,0 +1,35 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace mococrw
+{
+namespace benchmarking
+{
+/**
+ * Number of calls of the global operator new in this process so far.
+ *
+ * Allocations of OpenSSL (malloc) are not counted.
+ */
+uint64_t allocationCount();
+
+}  // namespace benchmarking
+}  // namespace mococrw
@@ -0,0 +1,186 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <benchmark/benchmark.h>
+
+#include "allocation_counter.h"
+#include "mococrw/symmetric_crypto.h"
+
+using namespace mococrw;
+
+namespace
+{
+const std::vector<uint8_t> secretKey(32, 0x42);
+const std::vector<uint8_t> nonce(12, 0x24);
+const std::vector<uint8_t> associatedData(16, 0xaa);
+
+/* Reports the average number of operator new calls per iteration. */
+class AllocationCounter
+{
+public:
+    explicit AllocationCounter(benchmark::State &state)
+            : _state(state), _start(benchmarking::allocationCount())
+    {
+    }
+
+    ~AllocationCounter()
+    {
+        _state.counters["allocations"] =
+                benchmark::Counter(static_cast<double>(benchmarking::allocationCount() - _start),
+                                   benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    benchmark::State &_state;
+    uint64_t _start;
+};
+
+std::vector<uint8_t> sealWithBuilder(const std::vector<uint8_t> &plaintext)
+{
+    auto encryptor =
+            AESCipherBuilder{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, secretKey}
+                    .setIV(nonce)
+                    .buildAuthenticatedEncryptor();
+    encryptor->addAssociatedData(associatedData);
+    encryptor->update(plaintext);
+    auto sealed = encryptor->finish();
+    auto tag = encryptor->getAuthTag();
+    sealed.insert(sealed.end(), tag.begin(), tag.end());
+    return sealed;
+}
+
+void aeadSealBuilder(benchmark::State &state)
+{
+    std::vector<uint8_t> plaintext(state.range(0), 0x5a);
+    AllocationCounter counter{state};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sealWithBuilder(plaintext));
+    }
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+void aeadSealOneShot(benchmark::State &state)
+{
+    std::vector<uint8_t> plaintext(state.range(0), 0x5a);
+    AESKey key{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, secretKey};
+    AllocationCounter counter{state};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(aeadSeal(key, nonce, associatedData, plaintext));
+    }
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+void aeadSealCallerBuffer(benchmark::State &state)
+{
+    std::vector<uint8_t> plaintext(state.range(0), 0x5a);
+    std::vector<uint8_t> out(plaintext.size() + AESKey::DefaultAuthTagLength);
+    AESKey key{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, secretKey};
+    AllocationCounter counter{state};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(aeadSeal(key,
+                                          nonce.data(),
+                                          nonce.size(),
+                                          associatedData.data(),
+                                          associatedData.size(),
+                                          plaintext.data(),
+                                          plaintext.size(),
+                                          out.data(),
+                                          out.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+void aeadOpenBuilder(benchmark::State &state)
+{
+    std::vector<uint8_t> plaintext(state.range(0), 0x5a);
+    auto sealed = sealWithBuilder(plaintext);
+    std::vector<uint8_t> ciphertext(sealed.begin(), sealed.end() - AESKey::DefaultAuthTagLength);
+    std::vector<uint8_t> tag(sealed.end() - AESKey::DefaultAuthTagLength, sealed.end());
+    AllocationCounter counter{state};
+    for (auto _ : state) {
+        auto decryptor =
+                AESCipherBuilder{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, secretKey}
+                        .setIV(nonce)
+                        .buildAuthenticatedDecryptor();
+        decryptor->addAssociatedData(associatedData);
+        decryptor->update(ciphertext);
+        decryptor->setAuthTag(tag);
+        benchmark::DoNotOptimize(decryptor->finish());
+    }
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+void aeadOpenOneShot(benchmark::State &state)
+{
+    std::vector<uint8_t> plaintext(state.range(0), 0x5a);
+    auto sealed = sealWithBuilder(plaintext);
+    AESKey key{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, secretKey};
+    AllocationCounter counter{state};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(aeadOpen(key, nonce, associatedData, sealed));
+    }
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+void aeadSealMode(benchmark::State &state,
+                  SymmetricCipherMode mode,
+                  SymmetricCipherKeySize keySize)
+{
+    std::vector<uint8_t> plaintext(state.range(0), 0x5a);
+    std::vector<uint8_t> out(plaintext.size() + AESKey::DefaultAuthTagLength);
+    std::vector<uint8_t> keyBytes(keySize == SymmetricCipherKeySize::S_128 ? 16 : 32, 0x42);
+    AESKey key{mode, keySize, keyBytes};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(aeadSeal(key,
+                                          nonce.data(),
+                                          nonce.size(),
+                                          associatedData.data(),
+                                          associatedData.size(),
+                                          plaintext.data(),
+                                          plaintext.size(),
+                                          out.data(),
+                                          out.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+}  // namespace
+
+BENCHMARK(aeadSealBuilder)->Arg(16)->Arg(200)->Arg(1024)->Arg(16384);
+BENCHMARK(aeadSealOneShot)->Arg(16)->Arg(200)->Arg(1024)->Arg(16384);
+BENCHMARK(aeadSealCallerBuffer)->Arg(16)->Arg(200)->Arg(1024)->Arg(16384);
+BENCHMARK(aeadOpenBuilder)->Arg(16)->Arg(200)->Arg(1024)->Arg(16384);
+BENCHMARK(aeadOpenOneShot)->Arg(16)->Arg(200)->Arg(1024)->Arg(16384);
+
+BENCHMARK_CAPTURE(aeadSealMode,
+                  AES_128_GCM,
+                  SymmetricCipherMode::GCM,
+                  SymmetricCipherKeySize::S_128)
+        ->RangeMultiplier(16)
+        ->Range(64, 1 << 20);
+BENCHMARK_CAPTURE(aeadSealMode,
+                  AES_256_GCM,
+                  SymmetricCipherMode::GCM,
+                  SymmetricCipherKeySize::S_256)
+        ->RangeMultiplier(16)
+        ->Range(64, 1 << 20);
+BENCHMARK_CAPTURE(aeadSealMode,
+                  CHACHA20_POLY1305,
+                  SymmetricCipherMode::CHACHA20_POLY1305,
+                  SymmetricCipherKeySize::S_256)
+        ->RangeMultiplier(16)
+        ->Range(64, 1 << 20);
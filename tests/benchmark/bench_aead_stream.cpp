@@ -0,0 +1,157 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <benchmark/benchmark.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include "mococrw/aead_stream.h"
+
+using namespace mococrw;
+
+namespace
+{
+const std::vector<uint8_t> masterKey(32, 0x42);
+const size_t streamLength = 16 * 1024 * 1024;
+/* The stream is passed to update() in parts of this size. */
+const size_t partLength = 1024 * 1024;
+
+std::vector<uint8_t> encryptStream(const std::vector<uint8_t> &plaintext,
+                                   SymmetricCipherMode mode,
+                                   size_t segmentSize)
+{
+    AEADStreamEncryptor encryptor{mode, masterKey, segmentSize};
+    std::vector<uint8_t> ciphertext;
+    for (size_t offset = 0; offset < plaintext.size(); offset += partLength) {
+        auto out = encryptor.update(
+                {plaintext.begin() + offset, plaintext.begin() + offset + partLength});
+        ciphertext.insert(ciphertext.end(), out.begin(), out.end());
+    }
+    auto out = encryptor.finish();
+    ciphertext.insert(ciphertext.end(), out.begin(), out.end());
+    return ciphertext;
+}
+
+/* Baseline: the whole stream authenticated with a single GCM tag. */
+void singleTagEncrypt(benchmark::State &state)
+{
+    std::vector<uint8_t> plaintext(streamLength, 0x5a);
+    std::vector<uint8_t> key(masterKey.begin(), masterKey.end());
+    std::vector<uint8_t> iv(12, 0x24);
+    for (auto _ : state) {
+        auto encryptor =
+                AESCipherBuilder{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, key}
+                        .setIV(iv)
+                        .buildAuthenticatedEncryptor();
+        for (size_t offset = 0; offset < plaintext.size(); offset += partLength) {
+            encryptor->update(
+                    {plaintext.begin() + offset, plaintext.begin() + offset + partLength});
+            benchmark::DoNotOptimize(encryptor->read(partLength));
+        }
+        benchmark::DoNotOptimize(encryptor->finish());
+    }
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+void streamEncrypt(benchmark::State &state, SymmetricCipherMode mode)
+{
+    std::vector<uint8_t> plaintext(streamLength, 0x5a);
+    for (auto _ : state) {
+        AEADStreamEncryptor encryptor{mode, masterKey, static_cast<size_t>(state.range(0))};
+        for (size_t offset = 0; offset < plaintext.size(); offset += partLength) {
+            benchmark::DoNotOptimize(encryptor.update(
+                    {plaintext.begin() + offset, plaintext.begin() + offset + partLength}));
+        }
+        benchmark::DoNotOptimize(encryptor.finish());
+    }
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+void streamDecrypt(benchmark::State &state, SymmetricCipherMode mode)
+{
+    std::vector<uint8_t> plaintext(streamLength, 0x5a);
+    auto ciphertext = encryptStream(plaintext, mode, state.range(0));
+    for (auto _ : state) {
+        AEADStreamDecryptor decryptor{masterKey};
+        for (size_t offset = 0; offset < ciphertext.size(); offset += partLength) {
+            size_t end = std::min(offset + partLength, ciphertext.size());
+            benchmark::DoNotOptimize(
+                    decryptor.update({ciphertext.begin() + offset, ciphertext.begin() + end}));
+        }
+        benchmark::DoNotOptimize(decryptor.finish());
+    }
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+std::string createTemporaryFile()
+{
+    char path[] = "/tmp/mococrw-benchmark-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        throw std::runtime_error("Could not create temporary file");
+    }
+    close(fd);
+    return path;
+}
+
+/* Encrypts and decrypts a file through the pipelines. range(0) is the number of worker
+ * threads, 0 selects the number of hardware threads. */
+void filePipeline(benchmark::State &state)
+{
+    auto plaintextFile = createTemporaryFile();
+    auto ciphertextFile = createTemporaryFile();
+    auto decryptedFile = createTemporaryFile();
+    {
+        std::vector<char> plaintext(4 * streamLength, 0x5a);
+        std::ofstream{plaintextFile, std::ios::binary}.write(plaintext.data(), plaintext.size());
+    }
+
+    for (auto _ : state) {
+        AEADStreamEncryptor::encryptFile(SymmetricCipherMode::GCM,
+                                         masterKey,
+                                         plaintextFile,
+                                         ciphertextFile,
+                                         AEADStreamEncryptor::DefaultSegmentSize,
+                                         state.range(0));
+        AEADStreamDecryptor::decryptFile(masterKey, ciphertextFile, decryptedFile, state.range(0));
+    }
+    state.SetBytesProcessed(state.iterations() * 4 * streamLength);
+
+    for (const auto &file : {plaintextFile, ciphertextFile, decryptedFile}) {
+        std::remove(file.c_str());
+    }
+}
+}  // namespace
+
+BENCHMARK(singleTagEncrypt)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(streamEncrypt, AES_256_GCM, SymmetricCipherMode::GCM)
+        ->RangeMultiplier(16)
+        ->Range(4 * 1024, 1024 * 1024)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(streamDecrypt, AES_256_GCM, SymmetricCipherMode::GCM)
+        ->RangeMultiplier(16)
+        ->Range(4 * 1024, 1024 * 1024)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(streamEncrypt, CHACHA20_POLY1305, SymmetricCipherMode::CHACHA20_POLY1305)
+        ->Arg(64 * 1024)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK(filePipeline)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,45 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <benchmark/benchmark.h>
+
+#include "mococrw/hash.h"
+
+using namespace mococrw;
+
+namespace
+{
+void hashBulk(benchmark::State &state, DigestTypes digestType)
+{
+    std::vector<uint8_t> data(state.range(0), 0x5a);
+    for (auto _ : state) {
+        auto digest = Hash::fromDigestType(digestType).update(data).digest();
+        benchmark::DoNotOptimize(digest);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+}  // namespace
+
+#define HASH_BENCHMARK(name, digestType) \
+    BENCHMARK_CAPTURE(hashBulk, name, digestType)->RangeMultiplier(16)->Range(64, 1 << 20)
+
+HASH_BENCHMARK(SHA256, DigestTypes::SHA256);
+HASH_BENCHMARK(SHA512, DigestTypes::SHA512);
+HASH_BENCHMARK(SHA3_256, DigestTypes::SHA3_256);
+HASH_BENCHMARK(BLAKE2b512, DigestTypes::BLAKE2b_512);
+HASH_BENCHMARK(BLAKE2s256, DigestTypes::BLAKE2s_256);
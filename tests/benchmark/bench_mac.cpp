@@ -0,0 +1,87 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <benchmark/benchmark.h>
+
+#include "mococrw/mac.h"
+
+using namespace mococrw;
+
+namespace
+{
+/* Every message is authenticated with a fresh MAC instance, as with a one-time key per frame. */
+template <class CreateMac>
+void macPerMessage(benchmark::State &state, CreateMac createMac)
+{
+    std::vector<uint8_t> message(state.range(0), 0x5a);
+    for (auto _ : state) {
+        auto mac = createMac();
+        mac.update(ByteView{message});
+        benchmark::DoNotOptimize(mac.finish());
+    }
+    state.SetBytesProcessed(state.iterations() * message.size());
+}
+
+void poly1305CallerBuffer(benchmark::State &state)
+{
+    std::vector<uint8_t> message(state.range(0), 0x5a);
+    std::vector<uint8_t> key(Poly1305::KeySize, 0x42);
+    std::vector<uint8_t> tag(Poly1305::TagSize);
+    for (auto _ : state) {
+        Poly1305 mac{key};
+        mac.update(ByteView{message});
+        benchmark::DoNotOptimize(mac.finish(tag.data(), tag.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * message.size());
+}
+
+/* HMAC with a long-lived key, restarted with reset() for every message. */
+void hmacReset(benchmark::State &state)
+{
+    std::vector<uint8_t> message(state.range(0), 0x5a);
+    mococrw::HMAC mac{DigestTypes::SHA256, std::vector<uint8_t>(32, 0x42)};
+    for (auto _ : state) {
+        mac.reset();
+        mac.update(ByteView{message});
+        benchmark::DoNotOptimize(mac.finish());
+    }
+    state.SetBytesProcessed(state.iterations() * message.size());
+}
+
+Poly1305 createPoly1305() { return Poly1305{std::vector<uint8_t>(Poly1305::KeySize, 0x42)}; }
+
+mococrw::HMAC createHmacSha256()
+{
+    return mococrw::HMAC{DigestTypes::SHA256, std::vector<uint8_t>(32, 0x42)};
+}
+
+CMAC createCmacAes128()
+{
+    return CMAC{CmacCipherTypes::AES_CBC_128, std::vector<uint8_t>(16, 0x42)};
+}
+}  // namespace
+
+BENCHMARK_CAPTURE(macPerMessage, Poly1305, createPoly1305)->RangeMultiplier(8)->Range(64, 64 << 10);
+BENCHMARK_CAPTURE(macPerMessage, HMAC_SHA256, createHmacSha256)
+        ->RangeMultiplier(8)
+        ->Range(64, 64 << 10);
+BENCHMARK_CAPTURE(macPerMessage, CMAC_AES128, createCmacAes128)
+        ->RangeMultiplier(8)
+        ->Range(64, 64 << 10);
+BENCHMARK(poly1305CallerBuffer)->RangeMultiplier(8)->Range(64, 64 << 10);
+BENCHMARK(hmacReset)->RangeMultiplier(8)->Range(64, 64 << 10);
@@ -35,6 +35,38 @@ namespace openssl
 class OpenSSLLibMockInterface
 {
 public:
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    virtual EVP_MD* SSL_EVP_MD_fetch(OSSL_LIB_CTX* ctx,
+                                     const char* algorithm,
+                                     const char* properties) = 0;
+    virtual void SSL_EVP_MD_free(EVP_MD* md) = 0;
+    virtual const char* SSL_EVP_MD_get0_name(const EVP_MD* md) = 0;
+    virtual EVP_CIPHER* SSL_EVP_CIPHER_fetch(OSSL_LIB_CTX* ctx,
+                                             const char* algorithm,
+                                             const char* properties) = 0;
+    virtual void SSL_EVP_CIPHER_free(EVP_CIPHER* cipher) = 0;
+    virtual const char* SSL_EVP_CIPHER_get0_name(const EVP_CIPHER* cipher) = 0;
+#endif
+    virtual int SSL_EVP_DigestSignFinal(EVP_MD_CTX* ctx, unsigned char* sig, size_t* siglen) = 0;
+    virtual EVP_PKEY* SSL_EVP_PKEY_new_raw_private_key(int type,
+                                                       ENGINE* e,
+                                                       const unsigned char* priv,
+                                                       size_t len) = 0;
+    virtual void SSL_ERR_clear_error() = 0;
+    virtual int SSL_ERR_set_mark() = 0;
+    virtual int SSL_ERR_pop_to_mark() = 0;
+    virtual int SSL_HMAC_CTX_copy(HMAC_CTX* dctx, HMAC_CTX* sctx) = 0;
+    virtual int SSL_EVP_CIPHER_CTX_copy(EVP_CIPHER_CTX* out, const EVP_CIPHER_CTX* in) = 0;
+    virtual int SSL_EVP_CIPHER_CTX_block_size(const EVP_CIPHER_CTX* ctx) = 0;
+    virtual const EVP_MD* SSL_EVP_blake2b512() = 0;
+    virtual const EVP_MD* SSL_EVP_blake2s256() = 0;
+    virtual const EVP_MD* SSL_EVP_shake128() = 0;
+    virtual const EVP_MD* SSL_EVP_shake256() = 0;
+    virtual int SSL_EVP_DigestFinalXOF(EVP_MD_CTX* ctx, unsigned char* md, size_t len) = 0;
+#if OPENSSL_VERSION_NUMBER >= 0x30300000L
+    virtual int SSL_EVP_DigestSqueeze(EVP_MD_CTX* ctx, unsigned char* out, size_t outlen) = 0;
+#endif
+    virtual int SSL_EVP_MD_CTX_copy_ex(EVP_MD_CTX* out, const EVP_MD_CTX* in) = 0;
     virtual int SSL_ENGINE_free(ENGINE* e) = 0;
     virtual int SSL_ENGINE_finish(ENGINE* e) = 0;
     virtual ENGINE* SSL_ENGINE_by_id(const char* id) = 0;
@@ -199,6 +231,7 @@ public:
 
     /* Error handling */
     virtual char* SSL_ERR_error_string(unsigned long error, char* buf) = 0;
+    virtual void SSL_ERR_error_string_n(unsigned long error, char* buf, size_t len) = 0;
     virtual unsigned long SSL_ERR_get_error() = 0;
 
     /* X509_NAME related things */
@@ -413,6 +446,32 @@ public:
 class OpenSSLLibMock : public OpenSSLLibMockInterface
 {
 public:
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    MOCK_METHOD3(SSL_EVP_MD_fetch, EVP_MD*(OSSL_LIB_CTX*, const char*, const char*));
+    MOCK_METHOD1(SSL_EVP_MD_free, void(EVP_MD*));
+    MOCK_METHOD1(SSL_EVP_MD_get0_name, const char*(const EVP_MD*));
+    MOCK_METHOD3(SSL_EVP_CIPHER_fetch, EVP_CIPHER*(OSSL_LIB_CTX*, const char*, const char*));
+    MOCK_METHOD1(SSL_EVP_CIPHER_free, void(EVP_CIPHER*));
+    MOCK_METHOD1(SSL_EVP_CIPHER_get0_name, const char*(const EVP_CIPHER*));
+#endif
+    MOCK_METHOD3(SSL_EVP_DigestSignFinal, int(EVP_MD_CTX*, unsigned char*, size_t*));
+    MOCK_METHOD4(SSL_EVP_PKEY_new_raw_private_key,
+                 EVP_PKEY*(int, ENGINE*, const unsigned char*, size_t));
+    MOCK_METHOD0(SSL_ERR_clear_error, void());
+    MOCK_METHOD0(SSL_ERR_set_mark, int());
+    MOCK_METHOD0(SSL_ERR_pop_to_mark, int());
+    MOCK_METHOD2(SSL_HMAC_CTX_copy, int(HMAC_CTX*, HMAC_CTX*));
+    MOCK_METHOD2(SSL_EVP_CIPHER_CTX_copy, int(EVP_CIPHER_CTX*, const EVP_CIPHER_CTX*));
+    MOCK_METHOD1(SSL_EVP_CIPHER_CTX_block_size, int(const EVP_CIPHER_CTX*));
+    MOCK_METHOD0(SSL_EVP_blake2b512, const EVP_MD*());
+    MOCK_METHOD0(SSL_EVP_blake2s256, const EVP_MD*());
+    MOCK_METHOD0(SSL_EVP_shake128, const EVP_MD*());
+    MOCK_METHOD0(SSL_EVP_shake256, const EVP_MD*());
+    MOCK_METHOD3(SSL_EVP_DigestFinalXOF, int(EVP_MD_CTX*, unsigned char*, size_t));
+#if OPENSSL_VERSION_NUMBER >= 0x30300000L
+    MOCK_METHOD3(SSL_EVP_DigestSqueeze, int(EVP_MD_CTX*, unsigned char*, size_t));
+#endif
+    MOCK_METHOD2(SSL_EVP_MD_CTX_copy_ex, int(EVP_MD_CTX*, const EVP_MD_CTX*));
     MOCK_METHOD1(SSL_ENGINE_free, int(ENGINE*));
     MOCK_METHOD1(SSL_ENGINE_finish, int(ENGINE*));
     MOCK_METHOD1(SSL_ENGINE_by_id, ENGINE*(const char*));
@@ -556,6 +615,7 @@ public:
 
     MOCK_METHOD0(SSL_ERR_get_error, unsigned long());
     MOCK_METHOD2(SSL_ERR_error_string, char*(unsigned long, char*));
+    MOCK_METHOD3(SSL_ERR_error_string_n, void(unsigned long, char*, size_t));
 
     MOCK_METHOD0(SSL_X509_NAME_new, X509_NAME*());
     MOCK_METHOD1(SSL_X509_NAME_free, void(X509_NAME*));
@@ -0,0 +1,248 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include "mococrw/aead_stream.h"
+#include "mococrw/error.h"
+#include "mococrw/util.h"
+
+using namespace mococrw;
+
+namespace
+{
+std::vector<uint8_t> encrypt(SymmetricCipherMode mode,
+                             const std::vector<uint8_t> &key,
+                             const std::vector<uint8_t> &plaintext,
+                             size_t segmentSize,
+                             size_t updateSize)
+{
+    AEADStreamEncryptor encryptor{mode, key, segmentSize};
+    std::vector<uint8_t> ciphertext;
+    for (size_t offset = 0; offset < plaintext.size(); offset += updateSize) {
+        auto end = plaintext.begin() + std::min(plaintext.size(), offset + updateSize);
+        auto part = encryptor.update(std::vector<uint8_t>(plaintext.begin() + offset, end));
+        ciphertext.insert(ciphertext.end(), part.begin(), part.end());
+    }
+    auto last = encryptor.finish();
+    ciphertext.insert(ciphertext.end(), last.begin(), last.end());
+    return ciphertext;
+}
+
+std::vector<uint8_t> decrypt(const std::vector<uint8_t> &key,
+                             const std::vector<uint8_t> &ciphertext,
+                             size_t updateSize)
+{
+    AEADStreamDecryptor decryptor{key};
+    std::vector<uint8_t> plaintext;
+    for (size_t offset = 0; offset < ciphertext.size(); offset += updateSize) {
+        auto end = ciphertext.begin() + std::min(ciphertext.size(), offset + updateSize);
+        auto part = decryptor.update(std::vector<uint8_t>(ciphertext.begin() + offset, end));
+        plaintext.insert(plaintext.end(), part.begin(), part.end());
+    }
+    auto last = decryptor.finish();
+    plaintext.insert(plaintext.end(), last.begin(), last.end());
+    return plaintext;
+}
+
+void writeFile(const std::string &filename, const std::vector<uint8_t> &data)
+{
+    std::ofstream file(filename, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(data.data()), data.size());
+}
+
+std::vector<uint8_t> readFile(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file),
+                                std::istreambuf_iterator<char>());
+}
+
+bool fileExists(const std::string &filename) { return std::ifstream(filename).good(); }
+}  // namespace
+
+class AEADStreamTest : public ::testing::TestWithParam<SymmetricCipherMode>
+{
+public:
+    void SetUp() override
+    {
+        _key = utility::fromHex("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+        _data.resize(10000);
+        for (size_t i = 0; i < _data.size(); i++) {
+            _data[i] = static_cast<uint8_t>(i * 7 + i / 256);
+        }
+    }
+
+protected:
+    static const size_t _segmentSize = 1000;
+    std::vector<uint8_t> _key;
+    std::vector<uint8_t> _data;
+};
+
+TEST_P(AEADStreamTest, roundTripWithArbitraryUpdateSizes)
+{
+    for (size_t length : {0, 1, 999, 1000, 1001, 3000, 10000}) {
+        std::vector<uint8_t> plaintext(_data.begin(), _data.begin() + length);
+        for (size_t updateSize : {1, 333, 1000, 1016, 20000}) {
+            auto ciphertext = encrypt(GetParam(), _key, plaintext, _segmentSize, updateSize);
+            size_t segments = length == 0 ? 1 : (length - 1) / _segmentSize + 1;
+            EXPECT_EQ(ciphertext.size(),
+                      AEADStreamEncryptor::HeaderLength + length +
+                              segments * AEADStreamEncryptor::TagLength);
+            EXPECT_EQ(decrypt(_key, ciphertext, updateSize), plaintext);
+        }
+    }
+}
+
+TEST_P(AEADStreamTest, releasesAuthenticatedSegmentsBeforeTheEnd)
+{
+    auto ciphertext = encrypt(GetParam(), _key, _data, _segmentSize, _data.size());
+    size_t sealedSegmentSize = _segmentSize + AEADStreamEncryptor::TagLength;
+
+    AEADStreamDecryptor decryptor{_key};
+    /* The only complete segment could be the last one, so it is held back. */
+    auto headerAndOneSegment = AEADStreamEncryptor::HeaderLength + sealedSegmentSize;
+    EXPECT_TRUE(decryptor
+                        .update(std::vector<uint8_t>(ciphertext.begin(),
+                                                     ciphertext.begin() + headerAndOneSegment))
+                        .empty());
+    auto plaintext = decryptor.update(
+            std::vector<uint8_t>(ciphertext.begin() + headerAndOneSegment,
+                                 ciphertext.begin() + headerAndOneSegment + 1));
+    EXPECT_EQ(plaintext, std::vector<uint8_t>(_data.begin(), _data.begin() + _segmentSize));
+}
+
+TEST_P(AEADStreamTest, detectsModification)
+{
+    auto ciphertext = encrypt(GetParam(), _key, _data, _segmentSize, _data.size());
+    size_t sealedSegmentSize = _segmentSize + AEADStreamEncryptor::TagLength;
+
+    auto modified = ciphertext;
+    modified[AEADStreamEncryptor::HeaderLength + 3 * sealedSegmentSize + 5] ^= 1;
+    EXPECT_THROW(decrypt(_key, modified, 4096), MoCOCrWException);
+
+    /* Swap the first two segments. */
+    auto reordered = ciphertext;
+    auto first = reordered.begin() + AEADStreamEncryptor::HeaderLength;
+    std::swap_ranges(first, first + sealedSegmentSize, first + sealedSegmentSize);
+    EXPECT_THROW(decrypt(_key, reordered, 4096), MoCOCrWException);
+
+    /* Truncate at a segment boundary: the new last segment isn't marked as last. */
+    auto truncated = ciphertext;
+    truncated.resize(AEADStreamEncryptor::HeaderLength + 5 * sealedSegmentSize);
+    EXPECT_THROW(decrypt(_key, truncated, 4096), MoCOCrWException);
+
+    /* The header is authenticated as well. */
+    auto modifiedHeader = ciphertext;
+    modifiedHeader[AEADStreamEncryptor::HeaderLength - 1] ^= 1;
+    EXPECT_THROW(decrypt(_key, modifiedHeader, 4096), MoCOCrWException);
+
+    auto wrongKey = _key;
+    wrongKey[0] ^= 1;
+    EXPECT_THROW(decrypt(wrongKey, ciphertext, 4096), MoCOCrWException);
+}
+
+TEST_P(AEADStreamTest, fileRoundTripMatchesStreamingApi)
+{
+    std::string plaintextFile = "aead_stream_test_plaintext.bin";
+    std::string ciphertextFile = "aead_stream_test_ciphertext.bin";
+    std::string decryptedFile = "aead_stream_test_decrypted.bin";
+
+    for (size_t length : {0, 1000, 5555}) {
+        std::vector<uint8_t> plaintext(_data.begin(), _data.begin() + length);
+        writeFile(plaintextFile, plaintext);
+        AEADStreamEncryptor::encryptFile(GetParam(),
+                                         _key,
+                                         plaintextFile,
+                                         ciphertextFile,
+                                         _segmentSize,
+                                         4);
+
+        auto ciphertext = readFile(ciphertextFile);
+        EXPECT_EQ(decrypt(_key, ciphertext, 1234), plaintext);
+
+        AEADStreamDecryptor::decryptFile(_key, ciphertextFile, decryptedFile, 3);
+        EXPECT_EQ(readFile(decryptedFile), plaintext);
+    }
+
+    /* A file which can't be authenticated leaves no output behind. */
+    auto ciphertext = readFile(ciphertextFile);
+    ciphertext.back() ^= 1;
+    writeFile(ciphertextFile, ciphertext);
+    EXPECT_THROW(AEADStreamDecryptor::decryptFile(_key, ciphertextFile, decryptedFile),
+                 MoCOCrWException);
+    EXPECT_FALSE(fileExists(decryptedFile));
+
+    std::remove(plaintextFile.c_str());
+    std::remove(ciphertextFile.c_str());
+}
+
+TEST_P(AEADStreamTest, filePipelineWithManyBatches)
+{
+    std::string plaintextFile = "aead_stream_test_large.bin";
+    std::string ciphertextFile = "aead_stream_test_large.enc";
+    std::string decryptedFile = "aead_stream_test_large.dec";
+
+    /* Larger than the batches handed between the pipeline stages. */
+    std::vector<uint8_t> plaintext(9 * 1024 * 1024 + 17);
+    for (size_t i = 0; i < plaintext.size(); i++) {
+        plaintext[i] = static_cast<uint8_t>(i ^ (i >> 11));
+    }
+    writeFile(plaintextFile, plaintext);
+
+    AEADStreamEncryptor::encryptFile(GetParam(),
+                                     _key,
+                                     plaintextFile,
+                                     ciphertextFile,
+                                     AEADStreamEncryptor::DefaultSegmentSize,
+                                     0);
+    AEADStreamDecryptor::decryptFile(_key, ciphertextFile, decryptedFile, 0);
+    EXPECT_EQ(readFile(decryptedFile), plaintext);
+    EXPECT_EQ(decrypt(_key, readFile(ciphertextFile), 1024 * 1024), plaintext);
+
+    std::remove(plaintextFile.c_str());
+    std::remove(ciphertextFile.c_str());
+    std::remove(decryptedFile.c_str());
+}
+
+INSTANTIATE_TEST_CASE_P(AEADStreamTest,
+                        AEADStreamTest,
+                        testing::Values(SymmetricCipherMode::GCM,
+                                        SymmetricCipherMode::CHACHA20_POLY1305));
+
+TEST(AEADStreamParameterTest, rejectsInvalidParameters)
+{
+    std::vector<uint8_t> key(32, 0x42);
+    EXPECT_THROW(AEADStreamEncryptor(SymmetricCipherMode::CTR, key), MoCOCrWException);
+    EXPECT_THROW(AEADStreamEncryptor(SymmetricCipherMode::GCM, key, 0), MoCOCrWException);
+    EXPECT_THROW(AEADStreamEncryptor(SymmetricCipherMode::GCM, std::vector<uint8_t>(16, 0x42)),
+                 MoCOCrWException);
+    EXPECT_THROW(AEADStreamDecryptor(std::vector<uint8_t>(16, 0x42)), MoCOCrWException);
+
+    AEADStreamDecryptor decryptor{key};
+    decryptor.update(std::vector<uint8_t>(AEADStreamEncryptor::HeaderLength - 1));
+    EXPECT_THROW(decryptor.finish(), MoCOCrWException);
+
+    AEADStreamDecryptor invalidHeader{key};
+    EXPECT_THROW(invalidHeader.update(std::vector<uint8_t>(AEADStreamEncryptor::HeaderLength)),
+                 MoCOCrWException);
+}
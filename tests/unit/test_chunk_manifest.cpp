@@ -0,0 +1,232 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+
+#include "mococrw/asymmetric_crypto_ctx.h"
+#include "mococrw/chunk_manifest.h"
+#include "mococrw/error.h"
+#include "mococrw/key.h"
+#include "mococrw/util.h"
+
+using namespace mococrw;
+using namespace mococrw::openssl;
+using namespace ::testing;
+
+class ChunkManifestTest : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        _data.resize(10000);
+        for (size_t i = 0; i < _data.size(); i++) {
+            _data[i] = static_cast<uint8_t>(i % 251);
+        }
+    }
+
+protected:
+    const size_t _chunkSize = 1024;
+    std::vector<uint8_t> _data;
+};
+
+TEST_F(ChunkManifestTest, rootHashMatchesReferenceValue)
+{
+    auto manifest = ChunkManifest::fromBuffer(_data, DigestTypes::SHA256, _chunkSize);
+
+    EXPECT_EQ(manifest.getNumberOfChunks(), 10u);
+    EXPECT_EQ(manifest.getTotalSize(), _data.size());
+    EXPECT_EQ(manifest.getChunkLength(9), 10000u - 9 * _chunkSize);
+    EXPECT_EQ(utility::toHex(manifest.getRootHash()),
+              "cc8408e3281206a48665636da1efab5880228a6f5d03a3a59ac92f543a33ff0a");
+}
+
+TEST_F(ChunkManifestTest, emptyArtifactHasSingleEmptyChunk)
+{
+    auto manifest = ChunkManifest::fromBuffer(nullptr, 0, DigestTypes::SHA256);
+
+    EXPECT_EQ(manifest.getNumberOfChunks(), 1u);
+    EXPECT_EQ(utility::toHex(manifest.getRootHash()),
+              "6e340b9cffb37a989ca544e6bb780a2c78901d3fb33738768511a30617afa01d");
+    EXPECT_NO_THROW(manifest.verifyRange(0, nullptr, 0));
+}
+
+TEST_F(ChunkManifestTest, parallelAndSerialHashingAreIdentical)
+{
+    for (auto chunkSize : {1, 7, 1024, 4096, 10000, 20000}) {
+        auto serial = ChunkManifest::fromBuffer(_data, DigestTypes::SHA512, chunkSize, 1);
+        auto parallel = ChunkManifest::fromBuffer(_data, DigestTypes::SHA512, chunkSize, 4);
+        EXPECT_EQ(serial.serialize(), parallel.serialize());
+    }
+}
+
+TEST_F(ChunkManifestTest, fromFileMatchesFromBuffer)
+{
+    std::string filename = "chunk_manifest_test.bin";
+    {
+        std::ofstream file(filename, std::ios::binary);
+        file.write(reinterpret_cast<const char *>(_data.data()), _data.size());
+    }
+
+    auto fromFile = ChunkManifest::fromFile(filename, DigestTypes::SHA3_256, _chunkSize, 3);
+    auto fromBuffer = ChunkManifest::fromBuffer(_data, DigestTypes::SHA3_256, _chunkSize);
+    std::remove(filename.c_str());
+
+    EXPECT_EQ(fromFile.serialize(), fromBuffer.serialize());
+    EXPECT_THROW(ChunkManifest::fromFile(filename, DigestTypes::SHA256), MoCOCrWException);
+}
+
+TEST_F(ChunkManifestTest, serializationRoundTrip)
+{
+    auto manifest = ChunkManifest::fromBuffer(_data, DigestTypes::BLAKE2b_512, _chunkSize);
+    auto serialized = manifest.serialize();
+    auto parsed = ChunkManifest::deserialize(serialized);
+
+    EXPECT_EQ(parsed.getDigestType(), DigestTypes::BLAKE2b_512);
+    EXPECT_EQ(parsed.getChunkSize(), _chunkSize);
+    EXPECT_EQ(parsed.getTotalSize(), _data.size());
+    EXPECT_EQ(parsed.getRootHash(), manifest.getRootHash());
+    EXPECT_EQ(parsed.serialize(), serialized);
+}
+
+TEST_F(ChunkManifestTest, deserializeRejectsInconsistentManifests)
+{
+    auto serialized = ChunkManifest::fromBuffer(_data, DigestTypes::SHA256, _chunkSize).serialize();
+
+    auto modifiedChunkHash = serialized;
+    modifiedChunkHash.back() ^= 0x01;
+    EXPECT_THROW(ChunkManifest::deserialize(modifiedChunkHash), MoCOCrWException);
+
+    auto truncated = serialized;
+    truncated.resize(truncated.size() - 1);
+    EXPECT_THROW(ChunkManifest::deserialize(truncated), MoCOCrWException);
+
+    auto badMagic = serialized;
+    badMagic[0] = 'X';
+    EXPECT_THROW(ChunkManifest::deserialize(badMagic), MoCOCrWException);
+
+    EXPECT_THROW(ChunkManifest::deserialize({}), MoCOCrWException);
+}
+
+TEST_F(ChunkManifestTest, deserializeRejectsOverflowingChunkCount)
+{
+    /* A chunk size of 1 and a total size of 2^64-1 let the number of hashes wrap to 0, so a
+     * manifest without any hashes must not be accepted. */
+    auto serialized = ChunkManifest::fromBuffer(_data, DigestTypes::SHA256, _chunkSize).serialize();
+    std::vector<uint8_t> header(serialized.begin(), serialized.begin() + 9);
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        header.push_back(static_cast<uint8_t>(uint64_t{1} >> shift));
+    }
+    for (int i = 0; i < 8; i++) {
+        header.push_back(0xff);
+    }
+    EXPECT_THROW(ChunkManifest::deserialize(header), MoCOCrWException);
+
+    header.insert(header.end(), serialized.begin() + 25, serialized.begin() + 25 + 32);
+    EXPECT_THROW(ChunkManifest::deserialize(header), MoCOCrWException);
+}
+
+TEST_F(ChunkManifestTest, signAndVerify)
+{
+    auto key = AsymmetricKeypair::generateECC();
+    ECDSASignaturePrivateKeyCtx signCtx(key, DigestTypes::SHA256);
+    ECDSASignaturePublicKeyCtx verifyCtx(key, DigestTypes::SHA256);
+
+    auto manifest = ChunkManifest::fromBuffer(_data, DigestTypes::SHA256, _chunkSize);
+    auto signature = manifest.sign(signCtx);
+
+    auto received = ChunkManifest::deserialize(manifest.serialize());
+    EXPECT_NO_THROW(received.verifySignature(verifyCtx, signature));
+
+    auto otherManifest = ChunkManifest::fromBuffer(_data, DigestTypes::SHA256, 2 * _chunkSize);
+    EXPECT_THROW(otherManifest.verifySignature(verifyCtx, signature), MoCOCrWException);
+}
+
+TEST_F(ChunkManifestTest, verifyChunksAndRanges)
+{
+    auto manifest = ChunkManifest::fromBuffer(_data, DigestTypes::SHA256, _chunkSize);
+
+    EXPECT_NO_THROW(manifest.verifyChunk(3, _data.data() + 3 * _chunkSize, _chunkSize));
+    EXPECT_NO_THROW(manifest.verifyChunk(9, _data.data() + 9 * _chunkSize, 10000 - 9 * 1024));
+    EXPECT_NO_THROW(manifest.verifyRange(2 * _chunkSize, _data.data() + 2 * _chunkSize, 4096));
+    EXPECT_NO_THROW(manifest.verifyRange(8 * _chunkSize,
+                                         _data.data() + 8 * _chunkSize,
+                                         _data.size() - 8 * _chunkSize));
+    EXPECT_NO_THROW(manifest.verifyRange(0, _data.data(), _data.size(), 4));
+
+    /* wrong chunk content, index or length */
+    EXPECT_THROW(manifest.verifyChunk(4, _data.data() + 3 * _chunkSize, _chunkSize),
+                 MoCOCrWException);
+    EXPECT_THROW(manifest.verifyChunk(10, _data.data(), _chunkSize), MoCOCrWException);
+    EXPECT_THROW(manifest.verifyChunk(3, _data.data() + 3 * _chunkSize, _chunkSize - 1),
+                 MoCOCrWException);
+
+    /* unaligned ranges and ranges beyond the end */
+    EXPECT_THROW(manifest.verifyRange(1, _data.data() + 1, _chunkSize), MoCOCrWException);
+    EXPECT_THROW(manifest.verifyRange(0, _data.data(), _chunkSize + 1), MoCOCrWException);
+    EXPECT_THROW(manifest.verifyRange(9 * _chunkSize, _data.data() + 9 * _chunkSize, 2048),
+                 MoCOCrWException);
+
+    auto tampered = _data;
+    tampered[5 * _chunkSize + 17] ^= 0x80;
+    EXPECT_THROW(manifest.verifyRange(0, tampered.data(), tampered.size(), 4), MoCOCrWException);
+    EXPECT_NO_THROW(manifest.verifyRange(0, tampered.data(), 5 * _chunkSize));
+}
+
+TEST_F(ChunkManifestTest, inclusionProofs)
+{
+    for (size_t length : {1u, 1024u, 3000u, 10000u}) {
+        auto manifest = ChunkManifest::fromBuffer(_data.data(), length, DigestTypes::SHA256, 1024);
+        for (size_t i = 0; i < manifest.getNumberOfChunks(); i++) {
+            auto proof = manifest.getInclusionProof(i);
+            const uint8_t *chunk = _data.data() + manifest.getChunkOffset(i);
+            EXPECT_NO_THROW(ChunkManifest::verifyInclusion(manifest.getRootHash(),
+                                                           DigestTypes::SHA256,
+                                                           manifest.getNumberOfChunks(),
+                                                           i,
+                                                           chunk,
+                                                           manifest.getChunkLength(i),
+                                                           proof));
+            if (!proof.empty()) {
+                proof.front()[0] ^= 0x01;
+                EXPECT_THROW(ChunkManifest::verifyInclusion(manifest.getRootHash(),
+                                                            DigestTypes::SHA256,
+                                                            manifest.getNumberOfChunks(),
+                                                            i,
+                                                            chunk,
+                                                            manifest.getChunkLength(i),
+                                                            proof),
+                             MoCOCrWException);
+            }
+        }
+    }
+}
+
+TEST_F(ChunkManifestTest, throwsOnInvalidParameters)
+{
+    EXPECT_THROW(ChunkManifest::fromBuffer(_data, DigestTypes::SHA256, 0), MoCOCrWException);
+    EXPECT_THROW(ChunkManifest::fromBuffer(_data, DigestTypes::NONE), MoCOCrWException);
+    EXPECT_THROW(ChunkManifest::fromBuffer(nullptr, 10, DigestTypes::SHA256), MoCOCrWException);
+
+    auto manifest = ChunkManifest::fromBuffer(_data, DigestTypes::SHA256, _chunkSize);
+    EXPECT_THROW(manifest.getChunkHash(10), MoCOCrWException);
+    EXPECT_THROW(manifest.getChunkIndex(_data.size()), MoCOCrWException);
+    EXPECT_THROW(manifest.getInclusionProof(10), MoCOCrWException);
+}
@@ -207,6 +207,40 @@ TEST(CheckControlFlow, UpdateFailesAfterFinish)
     ASSERT_THROW(cmacCalculator.update(utility::fromHex(testdata.message)), MoCOCrWException);
 }
 
+TEST(CheckControlFlow, ResetRestartsWithTheSameKey)
+{
+    auto testdata = prepareTestdataForCmacTests();
+    auto cmacCalculator = CMAC(testdata.at(1).cipherType, utility::fromHex(testdata.at(1).key));
+    cmacCalculator.update(utility::fromHex(testdata.at(0).message));
+    cmacCalculator.reset();
+    cmacCalculator.update(utility::fromHex(testdata.at(1).message));
+    ASSERT_THAT(utility::toHex(cmacCalculator.finish()), Eq(testdata.at(1).expectedCmac));
+
+    /* The key of vectors 0 to 3 is the same */
+    for (size_t i = 0; i < 4; i++) {
+        cmacCalculator.reset();
+        cmacCalculator.update(utility::fromHex(testdata.at(i).message));
+        cmacCalculator.verify(utility::fromHex(testdata.at(i).expectedCmac));
+    }
+}
+
+TEST(CheckControlFlow, CloneCopiesKeyAndState)
+{
+    auto testdata = prepareTestdataForCmacTests().at(2);
+    auto message = utility::fromHex(testdata.message);
+    auto keyed = CMAC(testdata.cipherType, utility::fromHex(testdata.key));
+    keyed.update(std::vector<uint8_t>(message.begin(), message.begin() + 20));
+
+    auto clone = keyed.clone();
+    clone.update(std::vector<uint8_t>(message.begin() + 20, message.end()));
+    ASSERT_THAT(utility::toHex(clone.finish()), Eq(testdata.expectedCmac));
+
+    /* The original is not affected by the clone */
+    keyed.update(std::vector<uint8_t>(message.begin() + 20, message.end()));
+    keyed.verify(utility::fromHex(testdata.expectedCmac));
+    ASSERT_THROW(keyed.clone().update(message), MoCOCrWException);
+}
+
 class VerifyCmac : public testing::Test
 {
 protected:
@@ -238,3 +272,52 @@ TEST_F(VerifyCmac, FailsForTooLongCmac)
 
     EXPECT_THROW(cmacCalculator.verify(tooLongCmac), MoCOCrWException);
 }
+
+TEST_F(VerifyCmac, TryVerifyReportsTheStatus)
+{
+    auto expected = utility::fromHex(testdata.expectedCmac);
+    EXPECT_TRUE(getCmacCalculator().tryVerify(expected).isValid());
+
+    auto wrongCmac = expected;
+    wrongCmac[0] ^= 1;
+    EXPECT_EQ(getCmacCalculator().tryVerify(wrongCmac).getStatus(), VerificationStatus::Mismatch);
+
+    auto tooShortCmac = expected;
+    tooShortCmac.pop_back();
+    EXPECT_EQ(getCmacCalculator().tryVerify(tooShortCmac).getStatus(),
+              VerificationStatus::InvalidLength);
+}
+
+TEST(BatchCmac, MatchesTestVectors)
+{
+    auto testdata = prepareTestdataForCmacTests();
+    std::vector<std::vector<uint8_t>> keys, messages;
+    for (const auto &data : testdata) {
+        keys.push_back(utility::fromHex(data.key));
+        messages.push_back(utility::fromHex(data.message));
+    }
+
+    /* Vectors 0 to 3 use AES-128 with the same key. */
+    std::vector<MessageAuthenticationCode::KeyedMessage> keyedMessages;
+    std::vector<MessageAuthenticationCode::TaggedMessage> taggedMessages;
+    std::vector<std::vector<uint8_t>> expected;
+    for (size_t i = 0; i < 4; i++) {
+        expected.push_back(utility::fromHex(testdata[i].expectedCmac));
+        keyedMessages.push_back({keys[i], messages[i]});
+    }
+    for (size_t i = 0; i < 4; i++) {
+        taggedMessages.push_back({messages[i], expected[i]});
+    }
+    auto wrongTag = expected[0];
+    wrongTag[3] ^= 0x80;
+    taggedMessages.push_back({messages[0], wrongTag});
+
+    auto cipherType = testdata[0].cipherType;
+    EXPECT_EQ(CMAC::computeBatch(cipherType, keyedMessages, 2), expected);
+    EXPECT_EQ(CMAC::verifyBatch(cipherType, keys[0], taggedMessages, 2),
+              std::vector<bool>({true, true, true, true, false}));
+
+    std::vector<uint8_t> invalidKey{1, 2, 3};
+    EXPECT_THROW(CMAC::verifyBatch(cipherType, invalidKey, taggedMessages), MoCOCrWException);
+    EXPECT_THROW(CMAC::computeBatch(cipherType, {{invalidKey, messages[0]}}), MoCOCrWException);
+}
@@ -0,0 +1,154 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "mococrw/crypto_pipeline.h"
+#include "mococrw/error.h"
+#include "mococrw/util.h"
+
+using namespace mococrw;
+
+class CipherDigestStageTest : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        _key = utility::fromHex("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+        _macKey = utility::fromHex("0f0e0d0c0b0a09080706050403020100");
+        _iv = utility::fromHex("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+        _plaintext.resize(100000);
+        for (size_t i = 0; i < _plaintext.size(); i++) {
+            _plaintext[i] = static_cast<uint8_t>(i * 31 + i / 1024);
+        }
+    }
+
+protected:
+    std::unique_ptr<AESCipher> _createEncryptor(SymmetricCipherMode mode)
+    {
+        return AESCipherBuilder{mode, SymmetricCipherKeySize::S_256, _key}
+                .setIV(_iv)
+                .buildEncryptor();
+    }
+
+    std::vector<uint8_t> _key;
+    std::vector<uint8_t> _macKey;
+    std::vector<uint8_t> _iv;
+    std::vector<uint8_t> _plaintext;
+};
+
+TEST_F(CipherDigestStageTest, matchesSeparatePasses)
+{
+    for (auto mode : {SymmetricCipherMode::CTR, SymmetricCipherMode::CBC}) {
+        auto reference = _createEncryptor(mode);
+        reference->update(_plaintext);
+        auto expectedCiphertext = reference->finish();
+        mococrw::HMAC referenceMac{DigestTypes::SHA256, _macKey};
+        referenceMac.update(expectedCiphertext);
+
+        auto encryptor = _createEncryptor(mode);
+        mococrw::HMAC hmac{DigestTypes::SHA256, _macKey};
+        CipherDigestStage stage{*encryptor};
+        stage.addDigest(DigestTypes::SHA256)
+                .addDigest(DigestTypes::SHA3_512)
+                .addDigest(DigestTypes::SHA256, CipherDigestStage::Tap::Output)
+                .setMAC(hmac);
+
+        std::vector<uint8_t> ciphertext(_plaintext.size() + 16);
+        size_t written = 0;
+        /* Uneven parts cross the chunk boundaries of the stage. */
+        for (size_t offset = 0; offset < _plaintext.size(); offset += 30001) {
+            size_t length = std::min<size_t>(30001, _plaintext.size() - offset);
+            written += stage.update(_plaintext.data() + offset,
+                                    length,
+                                    ciphertext.data() + written,
+                                    ciphertext.size() - written);
+        }
+        written += stage.finish(ciphertext.data() + written, ciphertext.size() - written);
+        ciphertext.resize(written);
+
+        EXPECT_EQ(ciphertext, expectedCiphertext);
+        EXPECT_EQ(stage.digest(DigestTypes::SHA256), sha256(_plaintext));
+        EXPECT_EQ(stage.digest(DigestTypes::SHA3_512), sha3_512(_plaintext));
+        EXPECT_EQ(stage.digest(DigestTypes::SHA256, CipherDigestStage::Tap::Output),
+                  sha256(expectedCiphertext));
+        EXPECT_EQ(hmac.finish(), referenceMac.finish());
+    }
+}
+
+TEST_F(CipherDigestStageTest, inPlaceHashesThePlaintext)
+{
+    auto encryptor = _createEncryptor(SymmetricCipherMode::CTR);
+    CipherDigestStage stage{*encryptor};
+    stage.addDigest(DigestTypes::SHA512);
+
+    auto buffer = _plaintext;
+    size_t written = stage.update(buffer.data(), buffer.size(), buffer.data(), buffer.size());
+    written += stage.finish(buffer.data() + written, buffer.size() - written);
+    EXPECT_EQ(written, _plaintext.size());
+    EXPECT_EQ(stage.digest(DigestTypes::SHA512), sha512(_plaintext));
+
+    auto reference = _createEncryptor(SymmetricCipherMode::CTR);
+    reference->update(_plaintext);
+    EXPECT_EQ(buffer, reference->finish());
+}
+
+TEST_F(CipherDigestStageTest, reportsThroughputPerPart)
+{
+    auto encryptor = _createEncryptor(SymmetricCipherMode::CTR);
+    mococrw::HMAC hmac{DigestTypes::SHA512, _macKey};
+    CipherDigestStage stage{*encryptor};
+    stage.addDigest(DigestTypes::SHA256).setMAC(hmac, CipherDigestStage::Tap::Input);
+    EXPECT_EQ(stage.getCipherThroughput().bytesPerSecond(), 0);
+
+    std::vector<uint8_t> out(_plaintext.size());
+    stage.update(_plaintext.data(), _plaintext.size(), out.data(), out.size());
+    stage.finish(out.data(), 0);
+
+    for (const auto *throughput : {&stage.getCipherThroughput(),
+                                   &stage.getDigestThroughput(DigestTypes::SHA256),
+                                   &stage.getMACThroughput()}) {
+        EXPECT_EQ(throughput->bytes, _plaintext.size());
+        EXPECT_GT(throughput->time.count(), 0);
+        EXPECT_GT(throughput->bytesPerSecond(), 0);
+    }
+    EXPECT_THROW(stage.getDigestThroughput(DigestTypes::SHA512), MoCOCrWException);
+}
+
+TEST_F(CipherDigestStageTest, rejectsInvalidUsage)
+{
+    auto encryptor = _createEncryptor(SymmetricCipherMode::CBC);
+    mococrw::HMAC hmac{DigestTypes::SHA256, _macKey};
+    CipherDigestStage stage{*encryptor};
+    stage.addDigest(DigestTypes::SHA256);
+    EXPECT_THROW(stage.addDigest(DigestTypes::SHA256), MoCOCrWException);
+    EXPECT_THROW(stage.getMACThroughput(), MoCOCrWException);
+
+    std::vector<uint8_t> out(_plaintext.size());
+    EXPECT_THROW(stage.update(_plaintext.data(), _plaintext.size(), out.data(), 100),
+                 MoCOCrWException);
+    stage.update(_plaintext.data(), 100, out.data(), out.size());
+    EXPECT_THROW(stage.addDigest(DigestTypes::SHA512), MoCOCrWException);
+    EXPECT_THROW(stage.setMAC(hmac), MoCOCrWException);
+    EXPECT_THROW(stage.digest(DigestTypes::SHA256), MoCOCrWException);
+
+    stage.finish(out.data(), out.size());
+    EXPECT_THROW(stage.update(_plaintext.data(), 100, out.data(), out.size()), MoCOCrWException);
+    EXPECT_THROW(stage.digest(DigestTypes::SHA512), MoCOCrWException);
+}
@@ -106,6 +106,24 @@ TEST_F(ECIESTests, testWithoutSalt)
     EXPECT_EQ(testString, result);
 }
 
+TEST_F(ECIESTests, testWithByteViewUpdates)
+{
+    std::string testString = "Hello World! Hello ByteView!";
+    auto encCtx = encBuilder.buildEncryptionCtx(secp384PublicKey);
+    ByteView plaintext{testString};
+    encCtx->update(plaintext.subview(0, 5));
+    encCtx->update(plaintext.subview(5));
+    auto ciphertext = encCtx->finish();
+
+    auto decCtx = decBuilder.buildDecryptionCtx(secp384Key, encCtx->getEphemeralKey());
+    ByteView view{ciphertext};
+    decCtx->update(view.subview(0, 3));
+    decCtx->update(view.subview(3));
+    decCtx->setMAC(encCtx->getMAC());
+    auto result = decCtx->finish();
+    EXPECT_EQ(std::string(result.begin(), result.end()), testString);
+}
+
 TEST_F(ECIESTests, testWithSalts)
 {
     std::vector<uint8_t> kdfSalt = {'T', 'e', 's', 't', 'K', 'D', 'F'};
@@ -131,6 +149,87 @@ TEST_F(ECIESTests, testWithSalts)
     EXPECT_EQ(testString, result);
 }
 
+TEST_F(ECIESTests, testTryFinishReportsAWrongMac)
+{
+    std::vector<uint8_t> testString = {'H', 'e', 'l', 'l', 'o', ' ', 'W', 'o', 'r', 'l', 'd', '!'};
+    auto encCtx = encBuilder.buildEncryptionCtx(secp384PublicKey);
+    encCtx->update(testString);
+    auto ciphertext = encCtx->finish();
+    auto mac = encCtx->getMAC();
+    auto ephKey = encCtx->getEphemeralKey();
+
+    std::vector<uint8_t> result;
+    auto decCtx = decBuilder.buildDecryptionCtx(secp384Key, ephKey);
+    decCtx->update(ciphertext);
+    decCtx->setMAC(mac);
+    EXPECT_TRUE(decCtx->tryFinish(result));
+    EXPECT_EQ(testString, result);
+    EXPECT_THROW(decCtx->tryFinish(result), MoCOCrWException);
+
+    auto wrongMac = mac;
+    wrongMac[0] ^= 1;
+    result.clear();
+    decCtx = decBuilder.buildDecryptionCtx(secp384Key, ephKey);
+    decCtx->update(ciphertext);
+    decCtx->setMAC(wrongMac);
+    EXPECT_EQ(decCtx->tryFinish(result).getStatus(), VerificationStatus::Mismatch);
+    EXPECT_TRUE(result.empty());
+
+    decCtx = decBuilder.buildDecryptionCtx(secp384Key, ephKey);
+    decCtx->update(ciphertext);
+    EXPECT_THROW(decCtx->tryFinish(result), MoCOCrWException);
+}
+
+TEST_F(ECIESTests, testWithChaCha20Poly1305)
+{
+    const auto chachaMode = SymmetricCipherMode::CHACHA20_POLY1305;
+    const std::vector<uint8_t> zeroIV(AESCipherBuilder::getDefaultIVLength(chachaMode));
+    encBuilder.setSymmetricCipherFactoryFunction(
+            [zeroIV](const std::vector<uint8_t> &key) -> std::unique_ptr<SymmetricCipherI> {
+                return AESCipherBuilder(chachaMode, keySize, key)
+                        .setIV(zeroIV)
+                        .buildAuthenticatedEncryptor();
+            });
+    decBuilder.setSymmetricCipherFactoryFunction(
+            [zeroIV](const std::vector<uint8_t> &key) -> std::unique_ptr<SymmetricCipherI> {
+                return AESCipherBuilder(chachaMode, keySize, key)
+                        .setIV(zeroIV)
+                        .buildAuthenticatedDecryptor();
+            });
+
+    std::vector<uint8_t> testString = {'H', 'e', 'l', 'l', 'o', ' ', 'W', 'o', 'r', 'l', 'd', '!'};
+    auto encCtx = encBuilder.buildEncryptionCtx(secp384PublicKey);
+    encCtx->update(testString);
+    auto ciphertext = encCtx->finish();
+    /* The authentication tag is appended to the ciphertext */
+    EXPECT_EQ(ciphertext.size(), testString.size() + 16);
+    auto mac = encCtx->getMAC();
+    auto ephKey = encCtx->getEphemeralKey();
+
+    /* feed the ciphertext in pieces which split the tag */
+    auto decCtx = decBuilder.buildDecryptionCtx(secp384Key, ephKey);
+    decCtx->update({ciphertext.begin(), ciphertext.begin() + 5});
+    decCtx->update({ciphertext.begin() + 5, ciphertext.end() - 3});
+    decCtx->update({ciphertext.end() - 3, ciphertext.end()});
+    decCtx->setMAC(mac);
+    EXPECT_EQ(decCtx->finish(), testString);
+}
+
+TEST_F(ECIESTests, authenticatedCipherWithShortTagIsRejected)
+{
+    const auto chachaMode = SymmetricCipherMode::CHACHA20_POLY1305;
+    encBuilder.setSymmetricCipherFactoryFunction(
+            [](const std::vector<uint8_t> &key) -> std::unique_ptr<SymmetricCipherI> {
+                return AESCipherBuilder(chachaMode, keySize, key)
+                        .setAuthTagLength(12)
+                        .buildAuthenticatedEncryptor();
+            });
+
+    auto encCtx = encBuilder.buildEncryptionCtx(secp384PublicKey);
+    encCtx->update(std::vector<uint8_t>{'H', 'e', 'l', 'l', 'o'});
+    EXPECT_THROW(encCtx->finish(), MoCOCrWException);
+}
+
 struct testData
 {
     std::string privateKey;
@@ -0,0 +1,134 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <openssl/evp.h>
+
+#include "mococrw/openssl_wrap.h"
+
+using namespace mococrw::openssl;
+
+/*
+ * Test the cache of explicitly fetched digests and ciphers behind _fetchCachedMD() and
+ * _fetchCachedCipher(). The fetched objects are compared with the legacy objects they replace.
+ */
+class FetchCacheTest : public ::testing::Test
+{
+protected:
+    static std::vector<uint8_t> digest(const EVP_MD *md, const std::vector<uint8_t> &message)
+    {
+        std::vector<uint8_t> result(EVP_MAX_MD_SIZE);
+        unsigned int length = 0;
+        auto ctx = EVP_MD_CTX_new();
+        EXPECT_EQ(EVP_DigestInit_ex(ctx, md, nullptr), 1);
+        EXPECT_EQ(EVP_DigestUpdate(ctx, message.data(), message.size()), 1);
+        EXPECT_EQ(EVP_DigestFinal_ex(ctx, result.data(), &length), 1);
+        EVP_MD_CTX_free(ctx);
+        result.resize(length);
+        return result;
+    }
+
+    static std::vector<uint8_t> encrypt(const EVP_CIPHER *cipher,
+                                        const std::vector<uint8_t> &message)
+    {
+        const std::vector<uint8_t> key(32, 0x42);
+        const std::vector<uint8_t> iv(16, 0x17);
+        std::vector<uint8_t> result(message.size() + EVP_MAX_BLOCK_LENGTH);
+        int length = 0;
+        int finalLength = 0;
+        int messageLength = static_cast<int>(message.size());
+        auto ctx = EVP_CIPHER_CTX_new();
+        EXPECT_EQ(EVP_EncryptInit_ex(ctx, cipher, nullptr, key.data(), iv.data()), 1);
+        EXPECT_EQ(EVP_EncryptUpdate(ctx, result.data(), &length, message.data(), messageLength), 1);
+        EXPECT_EQ(EVP_EncryptFinal_ex(ctx, result.data() + length, &finalLength), 1);
+        EVP_CIPHER_CTX_free(ctx);
+        result.resize(length + finalLength);
+        return result;
+    }
+
+    /* More than one block and not a multiple of the block size */
+    const std::vector<uint8_t> _message = std::vector<uint8_t>(100, 0x5a);
+};
+
+TEST_F(FetchCacheTest, repeatedLookupsReturnTheSameObject)
+{
+    auto md = _fetchCachedMD(EVP_sha256());
+    auto cipher = _fetchCachedCipher(EVP_aes_256_cbc());
+    ASSERT_NE(md, nullptr);
+    ASSERT_NE(cipher, nullptr);
+
+    EXPECT_EQ(_fetchCachedMD(EVP_sha256()), md);
+    EXPECT_EQ(_fetchCachedCipher(EVP_aes_256_cbc()), cipher);
+    /* Other algorithms are cached separately */
+    EXPECT_NE(_fetchCachedMD(EVP_sha512()), md);
+    EXPECT_NE(_fetchCachedCipher(EVP_aes_128_cbc()), cipher);
+}
+
+TEST_F(FetchCacheTest, repeatedLookupsReturnTheSameObjectAcrossThreads)
+{
+    auto md = _fetchCachedMD(EVP_sha384());
+    auto cipher = _fetchCachedCipher(EVP_aes_192_cbc());
+
+    std::vector<const EVP_MD *> mds(8);
+    std::vector<const EVP_CIPHER *> ciphers(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < mds.size(); i++) {
+        threads.emplace_back([&mds, &ciphers, i]() {
+            mds[i] = _fetchCachedMD(EVP_sha384());
+            ciphers[i] = _fetchCachedCipher(EVP_aes_192_cbc());
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < mds.size(); i++) {
+        EXPECT_EQ(mds[i], md);
+        EXPECT_EQ(ciphers[i], cipher);
+    }
+}
+
+TEST_F(FetchCacheTest, fetchedObjectsBehaveLikeTheLegacyObjects)
+{
+    EXPECT_EQ(digest(_fetchCachedMD(EVP_sha256()), _message), digest(EVP_sha256(), _message));
+    EXPECT_EQ(digest(_fetchCachedMD(EVP_sha3_512()), _message), digest(EVP_sha3_512(), _message));
+    EXPECT_EQ(encrypt(_fetchCachedCipher(EVP_aes_256_cbc()), _message),
+              encrypt(EVP_aes_256_cbc(), _message));
+    EXPECT_EQ(encrypt(_fetchCachedCipher(EVP_aes_256_ctr()), _message),
+              encrypt(EVP_aes_256_ctr(), _message));
+}
+
+TEST_F(FetchCacheTest, legacyObjectsAreOnlyReplacedOnOpenSSL3)
+{
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    /* The fetched objects belong to a provider, the legacy objects don't */
+    EXPECT_NE(_fetchCachedMD(EVP_sha256()), EVP_sha256());
+    EXPECT_NE(EVP_MD_get0_provider(_fetchCachedMD(EVP_sha256())), nullptr);
+    EXPECT_NE(_fetchCachedCipher(EVP_aes_256_cbc()), EVP_aes_256_cbc());
+    EXPECT_NE(EVP_CIPHER_get0_provider(_fetchCachedCipher(EVP_aes_256_cbc())), nullptr);
+#else
+    EXPECT_EQ(_fetchCachedMD(EVP_sha256()), EVP_sha256());
+    EXPECT_EQ(_fetchCachedCipher(EVP_aes_256_cbc()), EVP_aes_256_cbc());
+#endif
+    EXPECT_EQ(_fetchCachedMD(nullptr), nullptr);
+    EXPECT_EQ(_fetchCachedCipher(nullptr), nullptr);
+}
@@ -19,6 +19,8 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
 #include <functional>
 
 #include "hash.cpp"
@@ -86,6 +88,32 @@ const auto sha3_512_foobar =
         "ff32a30c3af5012ea395827a3e99a13073c3a8d8410a708568ff7e6eb85968fccfebaea039bc21411e9d43fdb9"
         "a851b529b9960ffea8679199781b8f45ca85e2";
 
+const auto blake2b512_emptyString =
+        "786a02f742015903c6c6fd852552d272912f4740e15847618a86e217f71f5419d25e1031afee585313896444"
+        "934eb04b903a685b1448b755d56f701afe9be2ce";
+const auto blake2b512_foo =
+        "ca002330e69d3e6b84a46a56a6533fd79d51d97a3bb7cad6c2ff43b354185d6dc1e723fb3db4ae0737e12037"
+        "8424c714bb982d9dc5bbd7a0ab318240ddd18f8d";
+const auto blake2b512_foobar =
+        "8df31f60d6aeabd01b7dc83f277d0e24cbe104f7290ff89077a7eb58646068edfe1a83022866c46f65fb9161"
+        "2e516e0ecfa5cb25fc16b37d2c8d73732fe74cb2";
+
+const auto blake2s256_emptyString =
+        "69217a3079908094e11121d042354a7c1f55b6482ca1a51e1b250dfd1ed0eef9";
+const auto blake2s256_foo = "08d6cad88075de8f192db097573d0e829411cd91eb6ec65e8fc16c017edfdb74";
+const auto blake2s256_foobar = "03a4921c6b0aa0e5bed57228a3b6fd61bec160d46fa610ce6742dd51ab311f43";
+
+const auto shake128_emptyString_32 =
+        "7f9c2ba4e88f827d616045507605853ed73b8093f6efbc88eb1a6eacfa66ef26";
+const auto shake128_foobar_32 = "a2a5933ad57401cfc082ec7db10c730f484bcc65ac1a4dd6c41277a123e26288";
+
+const auto shake256_emptyString_64 =
+        "46b9dd2b0ba88d13233b3feb743eeb243fcd52ea62b81b82b50c27646ed5762fd75dc4ddd8c0f200cb05019d67"
+        "b592f6fc821c49479ab48640292eacb3b7c4be";
+const auto shake256_foobar_64 =
+        "d9b219853298b92373f90479065636a9d143e024f071ac3f7c84636da948ad69cff430200773b6dd82dead6b5b"
+        "3f0c582f4564d396e09bf1bf6c152aa61fef96";
+
 TEST_F(HashTest, sha1EmptyString)
 {
     EXPECT_THAT(utility::toHex(Hash::sha1().digest()), Eq(sha1_emptyString));
@@ -463,6 +491,28 @@ TEST_F(HashTest, sha3_512StandaloneFunctionStringVersion)
     EXPECT_THAT(utility::toHex(digest), Eq(sha3_512_foo));
 }
 
+TEST_F(HashTest, blake2b512)
+{
+    EXPECT_THAT(utility::toHex(Hash::blake2b512().digest()), Eq(blake2b512_emptyString));
+    EXPECT_THAT(utility::toHex(Hash::blake2b512().update("foo").update("bar").digest()),
+                Eq(blake2b512_foobar));
+    EXPECT_THAT(utility::toHex(blake2b512("foo")), Eq(blake2b512_foo));
+    EXPECT_THAT(Hash::getDigestSize(DigestTypes::BLAKE2b_512), Eq(64u));
+}
+
+TEST_F(HashTest, blake2s256)
+{
+    EXPECT_THAT(utility::toHex(Hash::blake2s256().digest()), Eq(blake2s256_emptyString));
+    EXPECT_THAT(utility::toHex(Hash::fromDigestType(DigestTypes::BLAKE2s_256)
+                                       .update("foo")
+                                       .update("bar")
+                                       .digest()),
+                Eq(blake2s256_foobar));
+    EXPECT_THAT(utility::toHex(blake2s256(reinterpret_cast<const uint8_t*>(&"foo"[0]), 3)),
+                Eq(blake2s256_foo));
+    EXPECT_THAT(Hash::getDigestSize(DigestTypes::BLAKE2s_256), Eq(32u));
+}
+
 TEST_F(HashTest, returnsDigestIfCalledTwice)
 {
     Hash hash = Hash::sha256();
@@ -480,3 +530,127 @@ TEST_F(HashTest, throwsIfCalledUpdateAfterDigest)
 
     EXPECT_THROW({ sha256.update("bar"); }, MoCOCrWException);
 }
+
+TEST_F(HashTest, multiHashMatchesSingleHashes)
+{
+    auto digests = MultiHash({DigestTypes::SHA256, DigestTypes::SHA512, DigestTypes::SHA3_256})
+                           .update("foo")
+                           .update("bar")
+                           .digest();
+    ASSERT_THAT(digests.size(), Eq(3u));
+    EXPECT_THAT(utility::toHex(digests.at(DigestTypes::SHA256)), Eq(sha256_foobar));
+    EXPECT_THAT(utility::toHex(digests.at(DigestTypes::SHA512)), Eq(sha512_foobar));
+    EXPECT_THAT(utility::toHex(digests.at(DigestTypes::SHA3_256)), Eq(sha3_256_foobar));
+}
+
+TEST_F(HashTest, multiHashSplitsLargeInputIntoChunks)
+{
+    std::vector<uint8_t> message(3 * MultiHash::ChunkSize + 17);
+    for (size_t i = 0; i < message.size(); i++) {
+        message[i] = static_cast<uint8_t>(i);
+    }
+
+    MultiHash multiHash({DigestTypes::SHA1, DigestTypes::SHA384});
+    multiHash.update(message);
+
+    EXPECT_THAT(multiHash.digest(DigestTypes::SHA1), Eq(sha1(message)));
+    EXPECT_THAT(multiHash.digest(DigestTypes::SHA384), Eq(sha384(message)));
+}
+
+TEST_F(HashTest, multiHashFromFile)
+{
+    const std::string filename = "multihash_test_input.bin";
+    std::vector<uint8_t> message(2 * MultiHash::ChunkSize + 5, 0x5a);
+    {
+        std::ofstream file{filename, std::ios::binary};
+        file.write(reinterpret_cast<const char*>(message.data()), message.size());
+    }
+
+    auto digests = MultiHash({DigestTypes::SHA256, DigestTypes::SHA3_512})
+                           .updateFromFile(filename)
+                           .digest();
+    std::remove(filename.c_str());
+
+    EXPECT_THAT(digests.at(DigestTypes::SHA256), Eq(sha256(message)));
+    EXPECT_THAT(digests.at(DigestTypes::SHA3_512), Eq(sha3_512(message)));
+}
+
+TEST_F(HashTest, multiHashThrowsOnInvalidUsage)
+{
+    EXPECT_THROW(MultiHash({}), MoCOCrWException);
+    EXPECT_THROW(MultiHash({DigestTypes::NONE}), MoCOCrWException);
+    EXPECT_THROW(MultiHash({DigestTypes::SHA256}).updateFromFile("/does/not/exist"),
+                 MoCOCrWException);
+
+    MultiHash multiHash({DigestTypes::SHA256});
+    EXPECT_THROW(multiHash.digest(DigestTypes::SHA512), MoCOCrWException);
+    multiHash.digest();
+    EXPECT_THROW(multiHash.update("foo"), MoCOCrWException);
+}
+
+TEST_F(HashTest, shakeEmptyString)
+{
+    EXPECT_THAT(utility::toHex(Shake::shake128().squeeze(32)), Eq(shake128_emptyString_32));
+    EXPECT_THAT(utility::toHex(Shake::shake256().squeeze(64)), Eq(shake256_emptyString_64));
+}
+
+TEST_F(HashTest, shakeMultipleUpdatesString)
+{
+    EXPECT_THAT(utility::toHex(Shake::shake128().update("foo").update("bar").squeeze(32)),
+                Eq(shake128_foobar_32));
+    EXPECT_THAT(utility::toHex(Shake::shake256().update("foo").update("bar").squeeze(64)),
+                Eq(shake256_foobar_64));
+}
+
+TEST_F(HashTest, shakeStandaloneFunctions)
+{
+    std::string message = "foobar";
+    std::vector<uint8_t> messageConv(message.begin(), message.end());
+    EXPECT_THAT(utility::toHex(shake128(message, 32)), Eq(shake128_foobar_32));
+    EXPECT_THAT(utility::toHex(shake128(messageConv, 32)), Eq(shake128_foobar_32));
+    EXPECT_THAT(utility::toHex(shake256(messageConv.data(), messageConv.size(), 64)),
+                Eq(shake256_foobar_64));
+}
+
+TEST_F(HashTest, shakeIncrementalSqueezeContinuesOutputStream)
+{
+    auto expected = shake256("foobar", 5000);
+
+    auto xof = Shake::shake256();
+    xof.update("foobar");
+    std::vector<uint8_t> squeezed;
+    for (size_t length : {1, 15, 16, 120, 300, 1024, 3524}) {
+        auto chunk = xof.squeeze(length);
+        ASSERT_THAT(chunk.size(), Eq(length));
+        squeezed.insert(squeezed.end(), chunk.begin(), chunk.end());
+    }
+    EXPECT_THAT(squeezed, Eq(expected));
+}
+
+TEST_F(HashTest, shakeEnforcesMaximumOutputLength)
+{
+    if (Shake::MaxOutputLength == std::numeric_limits<size_t>::max()) {
+        // The output length is unlimited with incremental squeezing.
+        return;
+    }
+    auto xof = Shake::shake128();
+    xof.update("foobar");
+    auto prefix = xof.squeeze(100);
+    EXPECT_THROW(xof.squeeze(Shake::MaxOutputLength), MoCOCrWException);
+
+    // A failed squeeze doesn't consume output.
+    auto rest = xof.squeeze(Shake::MaxOutputLength - 100);
+    rest.insert(rest.begin(), prefix.begin(), prefix.end());
+    EXPECT_THAT(rest, Eq(shake128("foobar", Shake::MaxOutputLength)));
+    EXPECT_THROW(xof.squeeze(1), MoCOCrWException);
+    EXPECT_NO_THROW(xof.squeeze(0));
+}
+
+TEST_F(HashTest, shakeThrowsIfCalledUpdateAfterSqueeze)
+{
+    auto xof = Shake::shake128();
+    xof.update("foo");
+    xof.squeeze(16);
+
+    EXPECT_THROW({ xof.update("bar"); }, MoCOCrWException);
+}
@@ -181,3 +181,143 @@ TEST(HmacTests3, checkConstructor)
     EXPECT_THROW(mococrw::HMAC(openssl::DigestTypes::SHA512, std::vector<uint8_t>()),
                  MoCOCrWException);
 }
+
+TEST(HmacTests3, blake2Digests)
+{
+    auto testData = prepareTestDataForHmacTests().at(0);
+    testHmacSha(openssl::DigestTypes::BLAKE2b_512,
+                testData,
+                "358a6a184924894fc34bee5680eedf57d84a37bb38832f288e3b27dc63a98cc8"
+                "c91e76da476b508bc6b2d408a248857452906e4a20b48c6b4b55d2df0fe1dd24");
+    testHmacSha(openssl::DigestTypes::BLAKE2s_256,
+                testData,
+                "65a8b7c5cc9136d424e82c37e2707e74e913c0655b99c75f40edf387453a3260");
+}
+
+TEST(HmacTests3, byteViewUpdateMatchesVectorUpdate)
+{
+    auto testData = prepareTestDataForHmacTests().at(1);
+    auto key = utility::fromHex(testData.key);
+    auto data = utility::fromHex(testData.data);
+
+    mococrw::HMAC viewHmac{openssl::DigestTypes::SHA256, key};
+    ByteView view{data};
+    viewHmac.update(view.subview(0, 3));
+    viewHmac.update(view.subview(3));
+    EXPECT_EQ(viewHmac.finish(), utility::fromHex(testData.expectedResultSha256));
+
+    /* A std::string is passed without copying into a std::vector first. */
+    std::string text{data.begin(), data.end()};
+    mococrw::HMAC stringHmac{openssl::DigestTypes::SHA256, key};
+    MessageAuthenticationCode &mac = stringHmac;
+    mac.update(ByteView{text});
+    EXPECT_EQ(mac.finish(), utility::fromHex(testData.expectedResultSha256));
+    EXPECT_THROW(mac.update(ByteView{text}), MoCOCrWException);
+
+    /* Braced lists starting with a 0 are not taken for a null pointer and a size. */
+    mococrw::HMAC listHmac{openssl::DigestTypes::SHA256, key};
+    listHmac.update({0x00, 0x10});
+    listHmac.update({0x00});
+    mococrw::HMAC vectorHmac{openssl::DigestTypes::SHA256, key};
+    vectorHmac.update(std::vector<uint8_t>{0x00, 0x10, 0x00});
+    EXPECT_EQ(listHmac.finish(), vectorHmac.finish());
+}
+
+TEST(HmacTests3, resetAndCloneReuseTheKey)
+{
+    auto testData = prepareTestDataForHmacTests().at(1);
+    auto key = utility::fromHex(testData.key);
+    auto data = utility::fromHex(testData.data);
+    auto expected = utility::fromHex(testData.expectedResultSha256);
+
+    mococrw::HMAC keyed{openssl::DigestTypes::SHA256, key};
+    auto clone = keyed.clone();
+    for (int i = 0; i < 3; i++) {
+        keyed.update(std::vector<uint8_t>{'x'});
+        keyed.reset();
+        keyed.update(data);
+        EXPECT_EQ(keyed.finish(), expected);
+        keyed.reset();
+    }
+
+    clone.update(std::vector<uint8_t>(data.begin(), data.begin() + 4));
+    auto secondClone = clone.clone();
+    secondClone.update(std::vector<uint8_t>(data.begin() + 4, data.end()));
+    secondClone.verify(expected);
+    clone.update(std::vector<uint8_t>(data.begin() + 4, data.end()));
+    clone.verify(expected);
+}
+
+TEST(HmacTests3, tryVerifyDoesNotThrowForAWrongMac)
+{
+    auto testData = prepareTestDataForHmacTests().at(1);
+    auto key = utility::fromHex(testData.key);
+    auto data = utility::fromHex(testData.data);
+    auto expected = utility::fromHex(testData.expectedResultSha256);
+
+    mococrw::HMAC hmac{openssl::DigestTypes::SHA256, key};
+    hmac.update(data);
+    EXPECT_TRUE(hmac.tryVerify(expected));
+
+    auto wrongMac = expected;
+    wrongMac.back() ^= 1;
+    auto result = hmac.tryVerify(wrongMac);
+    EXPECT_FALSE(result);
+    EXPECT_EQ(result.getStatus(), VerificationStatus::Mismatch);
+    EXPECT_FALSE(result.getMessage().empty());
+
+    wrongMac.resize(16);
+    EXPECT_EQ(hmac.tryVerify(wrongMac).getStatus(), VerificationStatus::InvalidLength);
+    EXPECT_THROW(hmac.verify(wrongMac), MoCOCrWException);
+}
+
+TEST(HmacTests3, batchComputeAndVerifyMatchSingleMacs)
+{
+    auto testData = prepareTestDataForHmacTests();
+    std::vector<std::vector<uint8_t>> keys, messages;
+    for (const auto &data : testData) {
+        keys.push_back(utility::fromHex(data.key));
+        messages.push_back(utility::fromHex(data.data));
+    }
+
+    std::vector<MessageAuthenticationCode::KeyedMessage> keyedMessages;
+    for (size_t i = 0; i < keys.size(); i++) {
+        keyedMessages.push_back({keys[i], messages[i]});
+    }
+    auto macs = mococrw::HMAC::computeBatch(openssl::DigestTypes::SHA256, keyedMessages, 3);
+    ASSERT_EQ(macs.size(), testData.size());
+    for (size_t i = 0; i < testData.size(); i++) {
+        mococrw::HMAC hmac{openssl::DigestTypes::SHA256, keys[i]};
+        hmac.update(messages[i]);
+        EXPECT_EQ(macs[i], hmac.finish());
+    }
+    EXPECT_THROW(mococrw::HMAC::computeBatch(openssl::DigestTypes::SHA256, {{ByteView{}, {}}}),
+                 MoCOCrWException);
+
+    /* Several blocks with a few invalid MACs in between */
+    size_t count = 3 * MessageAuthenticationCode::BatchBlockSize + 5;
+    std::vector<std::vector<uint8_t>> records(count), tags(count);
+    for (size_t i = 0; i < count; i++) {
+        records[i] = std::vector<uint8_t>(i % 100, static_cast<uint8_t>(i));
+        mococrw::HMAC hmac{openssl::DigestTypes::SHA512, keys[0]};
+        hmac.update(records[i]);
+        tags[i] = hmac.finish();
+    }
+    tags[1][0] ^= 1;
+    tags[70].pop_back();
+    tags[count - 1].clear();
+
+    std::vector<MessageAuthenticationCode::TaggedMessage> taggedMessages;
+    for (size_t i = 0; i < count; i++) {
+        taggedMessages.push_back({records[i], tags[i]});
+    }
+    for (unsigned int threads : {1, 4}) {
+        auto valid = mococrw::HMAC::verifyBatch(
+                openssl::DigestTypes::SHA512, keys[0], taggedMessages, threads);
+        ASSERT_EQ(valid.size(), count);
+        for (size_t i = 0; i < count; i++) {
+            EXPECT_EQ(valid[i], i != 1 && i != 70 && i != count - 1) << i;
+        }
+    }
+    EXPECT_TRUE(mococrw::HMAC::verifyBatch(openssl::DigestTypes::SHA512, keys[0], {}).empty());
+}
@@ -57,6 +57,9 @@ ENGINE* someEnginePtr()
     static char dummyBuf[42] = {};
     return reinterpret_cast<ENGINE*>(&dummyBuf);
 }
+
+/* Let a mocked SSL_ERR_error_string_n write the given text into the buffer of the caller */
+ACTION_P(WriteErrorString, text) { std::strncpy(arg1, text, arg2 - 1); }
 }  // namespace testutils
 
 void HSMTest::SetUp()
@@ -67,8 +70,8 @@ void HSMTest::SetUp()
      */
     openssl::OpenSSLLibMockManager::resetMock();
     ON_CALL(_mock(), SSL_ERR_get_error()).WillByDefault(Return(_defaultErrorCode));
-    ON_CALL(_mock(), SSL_ERR_error_string(_, nullptr))
-            .WillByDefault(Return(const_cast<char*>(_defaultErrorMessage.c_str())));
+    ON_CALL(_mock(), SSL_ERR_error_string_n(_, _, _))
+            .WillByDefault(::testutils::WriteErrorString(_defaultErrorMessage.c_str()));
     // TODO: Get rid of the uninteresting calls by default here somehow...
 }
 
@@ -43,6 +43,9 @@ void testPbkfd2(struct inputData data)
     auto pbkfd2 = PBKDF2(data.hashFunction, data.iterations);
     ASSERT_THAT(utility::toHex(pbkfd2.deriveKey(data.password, data.olen, data.salt)),
                 Eq(data.expectedRestult));
+    ASSERT_THAT(utility::toHex(pbkfd2.deriveKey(
+                        ByteView{data.password}, data.olen, ByteView{data.salt})),
+                Eq(data.expectedRestult));
 }
 
 static std::vector<inputData> prepareTestDataForPbkdf2Tests()
@@ -80,7 +83,22 @@ static std::vector<inputData> prepareTestDataForPbkdf2Tests()
                                      64,
                                      "d197b1b33db0143e018b12f3d1d1479e6cdebdcc97c5c0f87f6902e072f45"
                                      "7b5143f30602641b3d55cd335988cb36b84376060ecd532"
-                                     "e039b742a239434af2d5"}
+                                     "e039b742a239434af2d5"},
+                                    {openssl::DigestTypes::BLAKE2b_512,
+                                     {'p', 'a', 's', 's', 'w', 'o', 'r', 'd'},
+                                     {'s', 'a', 'l', 't'},
+                                     2,
+                                     64,
+                                     "40b77cc2ee4b4c44eeb5babc299be14af5670e39ea3ce14c0fe70e6c99369"
+                                     "886ab4d693bad8bd811ed64c5cf65a4cc5260993e17bbf2"
+                                     "423c77164752fcbf5a60"},
+                                    {openssl::DigestTypes::BLAKE2s_256,
+                                     {'p', 'a', 's', 's', 'w', 'o', 'r', 'd'},
+                                     {'s', 'a', 'l', 't'},
+                                     2,
+                                     32,
+                                     "7b88e65e6e95a118bc995f681a391cbd7b46e0cf9750a81100f613add62d8"
+                                     "4be"}
 
     };
     return testData;
@@ -98,6 +116,10 @@ void testX963kdf(struct inputData data)
     auto x963kdf = X963KDF(data.hashFunction);
     ASSERT_THAT(utility::toHex(x963kdf.deriveKey(data.password, data.olen, data.salt)),
                 Eq(data.expectedRestult));
+    KeyDerivationFunction &kdf = x963kdf;
+    ASSERT_THAT(utility::toHex(
+                        kdf.deriveKey(ByteView{data.password}, data.olen, ByteView{data.salt})),
+                Eq(data.expectedRestult));
 }
 
 static std::vector<inputData> prepareTestDataForX963Tests()
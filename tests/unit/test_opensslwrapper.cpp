@@ -21,7 +21,11 @@
 
 #include <cstring>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "mococrw/asymmetric_crypto_ctx.h"
+#include "mococrw/key.h"
 #include "mococrw/openssl_wrap.h"
 #include "openssl_lib_mock.h"
 
@@ -33,6 +37,7 @@ using ::testing::AnyNumber;
 using ::testing::Mock;
 using ::testing::Return;
 using ::testing::SetArgPointee;
+using ::testing::StrEq;
 
 /**
  * Test the openssl wrapper.
@@ -77,6 +82,16 @@ ENGINE* someEnginePtr()
     static char dummyBuf[42] = {};
     return reinterpret_cast<ENGINE*>(&dummyBuf);
 }
+
+EVP_MD_CTX* someMdCtxPtr()
+{
+    /* Reserve some memory and cast a pointer to that ; pointers will not be dereferenced */
+    static char dummyBuf[42] = {};
+    return reinterpret_cast<EVP_MD_CTX*>(&dummyBuf);
+}
+
+/* Let a mocked SSL_ERR_error_string_n write the given text into the buffer of the caller */
+ACTION_P(WriteErrorString, text) { std::strncpy(arg1, text, arg2 - 1); }
 }  // namespace testutils
 
 void OpenSSLWrapperTest::SetUp()
@@ -87,8 +102,8 @@ void OpenSSLWrapperTest::SetUp()
      */
     OpenSSLLibMockManager::resetMock();
     ON_CALL(_mock(), SSL_ERR_get_error()).WillByDefault(Return(_defaultErrorCode));
-    ON_CALL(_mock(), SSL_ERR_error_string(_, nullptr))
-            .WillByDefault(Return(const_cast<char*>(_defaultErrorMessage.c_str())));
+    ON_CALL(_mock(), SSL_ERR_error_string_n(_, _, _))
+            .WillByDefault(::testutils::WriteErrorString(_defaultErrorMessage.c_str()));
     // TODO: Get rid of the uninteresting calls by default here somehow...
 }
 
@@ -104,8 +119,9 @@ TEST_F(OpenSSLWrapperTest, keyMemoryManagement)
     EXPECT_CALL(_mock(), SSL_EVP_PKEY_new())
             .WillOnce(Return(nullptr)); /* first invocation will throw because allocation "fails"*/
 
-    EXPECT_CALL(_mock(), SSL_ERR_get_error()).WillOnce(Return(_defaultErrorCode));
-    EXPECT_CALL(_mock(), SSL_ERR_error_string(_defaultErrorCode, nullptr));
+    EXPECT_CALL(_mock(), SSL_ERR_get_error())
+            .WillOnce(Return(_defaultErrorCode))
+            .WillOnce(Return(0));
 
     EXPECT_THROW(_EVP_PKEY_new(), OpenSSLException);
 }
@@ -126,13 +142,123 @@ TEST_F(OpenSSLWrapperTest, keyContextMemoryManagement)
     /* Since we wrap in a unique_ptr, expect a call to the "free" function */
     EXPECT_CALL(_mock(), SSL_EVP_PKEY_CTX_free(::testutils::somePkeyCtxPtr()));
 
-    EXPECT_CALL(_mock(), SSL_ERR_get_error()).WillOnce(Return(_defaultErrorCode));
-    EXPECT_CALL(_mock(), SSL_ERR_error_string(_defaultErrorCode, nullptr));
+    EXPECT_CALL(_mock(), SSL_ERR_get_error())
+            .WillOnce(Return(_defaultErrorCode))
+            .WillOnce(Return(0));
 
     EXPECT_THROW(_EVP_PKEY_CTX_new_id(0), OpenSSLException);
     auto key = _EVP_PKEY_CTX_new_id(0);
 }
 
+/*
+ * Test that an OpenSSLException takes all errors from the error queue, but only formats them
+ * when the message is requested.
+ */
+TEST_F(OpenSSLWrapperTest, exceptionTakesTheErrorQueueAndFormatsLazily)
+{
+    EXPECT_CALL(_mock(), SSL_EVP_PKEY_new()).WillOnce(Return(nullptr));
+    EXPECT_CALL(_mock(), SSL_ERR_get_error())
+            .WillOnce(Return(1))
+            .WillOnce(Return(2))
+            .WillOnce(Return(0));
+    EXPECT_CALL(_mock(), SSL_ERR_error_string_n(_, _, _)).Times(0);
+
+    try {
+        _EVP_PKEY_new();
+        FAIL() << "Expected an OpenSSLException";
+    } catch (const OpenSSLException &e) {
+        EXPECT_EQ(e.getErrorCodes(), (std::vector<unsigned long>{1, 2}));
+
+        Mock::VerifyAndClearExpectations(&_mock());
+        EXPECT_CALL(_mock(), SSL_ERR_error_string_n(1, _, _))
+                .WillOnce(::testutils::WriteErrorString("first"));
+        EXPECT_CALL(_mock(), SSL_ERR_error_string_n(2, _, _))
+                .WillOnce(::testutils::WriteErrorString("second"));
+        EXPECT_EQ(std::string{e.what()}, "first: 1; second: 2");
+        /* The message is formatted once */
+        EXPECT_EQ(std::string{e.what()}, "first: 1; second: 2");
+    }
+}
+
+TEST_F(OpenSSLWrapperTest, exceptionMessageIsFormattedOnceAcrossThreads)
+{
+    EXPECT_CALL(_mock(), SSL_ERR_get_error()).WillOnce(Return(1)).WillOnce(Return(0));
+    OpenSSLException exception;
+    EXPECT_CALL(_mock(), SSL_ERR_error_string_n(1, _, _))
+            .WillOnce(::testutils::WriteErrorString("first"));
+
+    std::vector<std::string> messages(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < messages.size(); i++) {
+        /* Every thread uses its own copy, as with rethrown exceptions */
+        threads.emplace_back([&messages, i, exception]() { messages[i] = exception.what(); });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (const auto &message : messages) {
+        EXPECT_EQ(message, "first: 1");
+    }
+}
+
+/*
+ * Test that a failed signature verification translates the OpenSSLException into a
+ * MoCOCrWException without formatting the OpenSSL errors until the message is requested.
+ */
+TEST_F(OpenSSLWrapperTest, failedVerificationFormatsTheMessageLazily)
+{
+    ON_CALL(_mock(), SSL_EVP_PKEY_id(::testutils::somePkeyPtr()))
+            .WillByDefault(Return(EVP_PKEY_ED25519));
+    ON_CALL(_mock(), SSL_EVP_PKEY_type(EVP_PKEY_ED25519)).WillByDefault(Return(EVP_PKEY_ED25519));
+    ON_CALL(_mock(), SSL_EVP_MD_CTX_create()).WillByDefault(Return(::testutils::someMdCtxPtr()));
+    ON_CALL(_mock(), SSL_EVP_DigestVerifyInit(_, _, _, _, _)).WillByDefault(Return(1));
+    EXPECT_CALL(_mock(), SSL_EVP_DigestVerify(_, _, _, _, _)).WillOnce(Return(0));
+    EXPECT_CALL(_mock(), SSL_ERR_get_error()).WillOnce(Return(1)).WillOnce(Return(0));
+    EXPECT_CALL(_mock(), SSL_ERR_error_string_n(_, _, _)).Times(0);
+
+    ::mococrw::EdDSASignaturePublicKeyCtx ctx{::mococrw::AsymmetricPublicKey{
+            SSL_EVP_PKEY_SharedPtr{SSL_EVP_PKEY_Ptr{::testutils::somePkeyPtr()}}}};
+    try {
+        ctx.verifyMessage(std::vector<uint8_t>{1, 2}, std::vector<uint8_t>{3, 4});
+        FAIL() << "Expected a MoCOCrWException";
+    } catch (const ::mococrw::MoCOCrWException &e) {
+        Mock::VerifyAndClearExpectations(&_mock());
+        EXPECT_CALL(_mock(), SSL_ERR_error_string_n(1, _, _))
+                .WillOnce(::testutils::WriteErrorString("bad signature"));
+        EXPECT_EQ(std::string{e.what()},
+                  "Signature validation failed. OpenSSL info: bad signature: 1");
+        /* The message is formatted once */
+        EXPECT_EQ(std::string{e.what()},
+                  "Signature validation failed. OpenSSL info: bad signature: 1");
+    }
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+/*
+ * Test that a digest which can't be fetched falls back to the legacy object and only removes
+ * the errors of the failed fetch from the error queue.
+ */
+TEST_F(OpenSSLWrapperTest, failedFetchKeepsOlderErrors)
+{
+    static char dummyBuf[42] = {};
+    auto legacy = reinterpret_cast<const EVP_MD*>(&dummyBuf);
+
+    ON_CALL(_mock(), SSL_EVP_MD_get0_name(legacy)).WillByDefault(Return("dummy"));
+    {
+        ::testing::InSequence seq;
+        EXPECT_CALL(_mock(), SSL_ERR_set_mark()).WillOnce(Return(1));
+        EXPECT_CALL(_mock(), SSL_EVP_MD_fetch(nullptr, StrEq("dummy"), nullptr))
+                .WillOnce(Return(nullptr));
+        EXPECT_CALL(_mock(), SSL_ERR_pop_to_mark()).WillOnce(Return(1));
+    }
+    EXPECT_CALL(_mock(), SSL_ERR_clear_error()).Times(0);
+
+    EXPECT_EQ(_fetchCachedMD(legacy), legacy);
+    /* The fallback is remembered by the thread */
+    EXPECT_EQ(_fetchCachedMD(legacy), legacy);
+}
+#endif
+
 /**
  * Test that keygen-init throws if the underlying openssl function
  * returns an error.
@@ -0,0 +1,83 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "mococrw/error.h"
+#include "mococrw/mac.h"
+#include "mococrw/util.h"
+
+using namespace mococrw;
+
+class Poly1305Test : public ::testing::Test
+{
+protected:
+    /* RFC 8439, section 2.5.2 */
+    const std::vector<uint8_t> _key = utility::fromHex(
+            "85d6be7857556d337f4452fe42d506a80103808afb0db2fd4abff6af4149f51b");
+    const std::string _message = "Cryptographic Forum Research Group";
+    const std::vector<uint8_t> _expectedTag = utility::fromHex("a8061dc1305136c6c22b8baf0c0127a9");
+};
+
+TEST_F(Poly1305Test, matchesTestVector)
+{
+    Poly1305 poly1305{_key};
+    poly1305.update(ByteView{_message}.subview(0, 10));
+    poly1305.update(ByteView{_message}.subview(10));
+    EXPECT_EQ(poly1305.finish(), _expectedTag);
+    EXPECT_THROW(poly1305.finish(), MoCOCrWException);
+    EXPECT_THROW(poly1305.update(ByteView{_message}), MoCOCrWException);
+}
+
+TEST_F(Poly1305Test, writesTheTagToACallerBuffer)
+{
+    std::vector<uint8_t> frame(4 + Poly1305::TagSize, 0xff);
+    Poly1305 poly1305{_key};
+    poly1305.update(ByteView{_message});
+    EXPECT_THROW(poly1305.finish(frame.data() + 4, Poly1305::TagSize - 1), MoCOCrWException);
+    EXPECT_EQ(poly1305.finish(frame.data() + 4, Poly1305::TagSize), Poly1305::TagSize);
+    EXPECT_EQ(std::vector<uint8_t>(frame.begin() + 4, frame.end()), _expectedTag);
+    EXPECT_EQ(frame[3], 0xff);
+}
+
+TEST_F(Poly1305Test, verifiesTheTag)
+{
+    Poly1305 valid{_key};
+    valid.update(ByteView{_message});
+    EXPECT_NO_THROW(valid.verify(_expectedTag));
+
+    auto wrongTag = _expectedTag;
+    wrongTag[5] ^= 1;
+    Poly1305 mismatch{_key};
+    mismatch.update(ByteView{_message});
+    EXPECT_EQ(mismatch.tryVerify(wrongTag).getStatus(), VerificationStatus::Mismatch);
+    EXPECT_THROW(mismatch.verify(wrongTag), MoCOCrWException);
+
+    Poly1305 tooShort{_key};
+    tooShort.update(ByteView{_message});
+    EXPECT_EQ(tooShort.tryVerify(ByteView{_expectedTag}.subview(1)).getStatus(),
+              VerificationStatus::InvalidLength);
+}
+
+TEST_F(Poly1305Test, rejectsKeysOfWrongSize)
+{
+    EXPECT_THROW(Poly1305{std::vector<uint8_t>(16)}, MoCOCrWException);
+    EXPECT_THROW(Poly1305{std::vector<uint8_t>(33)}, MoCOCrWException);
+}
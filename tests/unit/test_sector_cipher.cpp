@@ -0,0 +1,127 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2022 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+
+#include "mococrw/error.h"
+#include "mococrw/sector_cipher.h"
+#include "mococrw/util.h"
+
+using namespace mococrw;
+
+class AESXTSSectorCipherTest : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        _key256 = utility::fromHex(
+                "2718281828459045235360287471352662497757247093699959574966967627"
+                "3141592653589793238462643383279502884197169399375105820974944592");
+        _data.resize(64 * AESXTSSectorCipher::DefaultSectorSize);
+        for (size_t i = 0; i < _data.size(); i++) {
+            _data[i] = static_cast<uint8_t>(i * 13 + i / 4096);
+        }
+    }
+
+protected:
+    std::vector<uint8_t> _key256;
+    std::vector<uint8_t> _data;
+};
+
+TEST_F(AESXTSSectorCipherTest, matchesIEEE1619TestVector)
+{
+    // IEEE 1619-2007, XTS-AES-128 vector 2
+    auto key = utility::fromHex(
+            "1111111111111111111111111111111122222222222222222222222222222222");
+    AESXTSSectorCipher cipher{SymmetricCipherKeySize::S_128, key, 32};
+
+    std::vector<uint8_t> plaintext(32, 0x44);
+    std::vector<uint8_t> ciphertext(32);
+    cipher.encryptSector(0x3333333333, plaintext.data(), ciphertext.data());
+    EXPECT_EQ(utility::toHex(ciphertext),
+              "c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0");
+
+    std::vector<uint8_t> decrypted(32);
+    cipher.decryptSector(0x3333333333, ciphertext.data(), decrypted.data());
+    EXPECT_EQ(decrypted, plaintext);
+}
+
+TEST_F(AESXTSSectorCipherTest, batchMatchesSingleSectors)
+{
+    AESXTSSectorCipher cipher{SymmetricCipherKeySize::S_256, _key256};
+    const size_t sectorSize = cipher.getSectorSize();
+    const uint64_t firstSector = 1000;
+
+    std::vector<uint8_t> batch(_data.size());
+    cipher.encryptSectors(firstSector, _data.data(), _data.size(), batch.data(), 4);
+
+    for (size_t i = 0; i < _data.size() / sectorSize; i++) {
+        std::vector<uint8_t> sector(sectorSize);
+        cipher.encryptSector(firstSector + i, _data.data() + i * sectorSize, sector.data());
+        EXPECT_TRUE(std::equal(sector.begin(), sector.end(), batch.begin() + i * sectorSize));
+    }
+
+    /* different sectors with identical content encrypt differently */
+    std::vector<uint8_t> zeroSectors(2 * sectorSize);
+    cipher.encryptSectors(0, zeroSectors.data(), zeroSectors.size(), zeroSectors.data());
+    EXPECT_FALSE(std::equal(zeroSectors.begin(),
+                            zeroSectors.begin() + sectorSize,
+                            zeroSectors.begin() + sectorSize));
+}
+
+TEST_F(AESXTSSectorCipherTest, inPlaceRoundTrip)
+{
+    for (size_t sectorSize : {size_t{16}, size_t{17}, size_t{512}, size_t{4096}}) {
+        AESXTSSectorCipher cipher{SymmetricCipherKeySize::S_256, _key256, sectorSize};
+        std::vector<uint8_t> buffer(_data.begin(), _data.begin() + 60 * sectorSize);
+
+        cipher.encryptSectors(7, buffer.data(), buffer.size(), buffer.data());
+        EXPECT_FALSE(std::equal(buffer.begin(), buffer.end(), _data.begin()));
+
+        /* rewrite a single sector in the middle */
+        uint8_t *sector = buffer.data() + 30 * sectorSize;
+        cipher.decryptSector(7 + 30, sector, sector);
+        sector[0] ^= 0xff;
+        cipher.encryptSector(7 + 30, sector, sector);
+
+        cipher.decryptSectors(7, buffer.data(), buffer.size(), buffer.data(), 3);
+        buffer[30 * sectorSize] ^= 0xff;
+        EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), _data.begin()));
+    }
+}
+
+TEST_F(AESXTSSectorCipherTest, throwsOnInvalidParameters)
+{
+    EXPECT_THROW(AESXTSSectorCipher(SymmetricCipherKeySize::S_256, std::vector<uint8_t>(32, 1)),
+                 MoCOCrWException);
+    EXPECT_THROW(AESXTSSectorCipher(SymmetricCipherKeySize::S_128, std::vector<uint8_t>(32, 1)),
+                 MoCOCrWException);
+    EXPECT_THROW(AESXTSSectorCipher(SymmetricCipherKeySize::S_256, _key256, 15),
+                 MoCOCrWException);
+    EXPECT_THROW(AESXTSSectorCipher(SymmetricCipherKeySize::S_256,
+                                    _key256,
+                                    AESXTSSectorCipher::MaxSectorSize + 1),
+                 MoCOCrWException);
+    EXPECT_NO_THROW(AESXTSSectorCipher(
+            SymmetricCipherKeySize::S_256, _key256, AESXTSSectorCipher::MaxSectorSize));
+
+    AESXTSSectorCipher cipher{SymmetricCipherKeySize::S_256, _key256};
+    EXPECT_THROW(cipher.encryptSectors(0, _data.data(), 4097, _data.data()), MoCOCrWException);
+}
@@ -700,6 +700,8 @@ TEST_P(SignatureTest, testUnsuccessfulSignatureAndVerificationWithModifiedSignat
     signature.back() ^= 0xaa;
     ASSERT_THROW(dataSet.verifyCtx->verifyMessage(signature, signVerifyTestMessage),
                  MoCOCrWException);
+    EXPECT_EQ(dataSet.verifyCtx->tryVerifyMessage(signature, signVerifyTestMessage).getStatus(),
+              VerificationStatus::Mismatch);
 }
 
 /**
@@ -709,6 +711,7 @@ TEST_P(SignatureTest, testSuccessfullVerificationOfKnownValidSignature)
 {
     auto param = GetParam();
     EXPECT_NO_THROW(param.verifyCtx->verifyMessage(param.validSignature, signVerifyTestMessage));
+    EXPECT_TRUE(param.verifyCtx->tryVerifyMessage(param.validSignature, signVerifyTestMessage));
 }
 
 INSTANTIATE_TEST_CASE_P(testSuccessfulSigningAndVerification,
@@ -924,6 +927,28 @@ TEST_F(SignatureTest, testfailedEccVerificationInIEEE1363FormatWhenSignatureTooL
                  MoCOCrWException);
 }
 
+/**
+ * @brief The non-throwing verification reports malformed input as an invalid length
+ */
+TEST_F(SignatureTest, testTryVerifyDigestReportsInvalidLengths)
+{
+    auto verifyCtx = ECDSASignaturePublicKeyCtx(
+            _validEccPublicKey, DigestTypes::SHA1, ECDSASignatureFormat::IEEE1363);
+    EXPECT_TRUE(verifyCtx.tryVerifyDigest(_validEccIEEE1363SignatureSHA1, _testMessageDigestSHA1));
+
+    auto tooShortSignature = _validEccIEEE1363SignatureSHA1;
+    tooShortSignature.pop_back();
+    EXPECT_EQ(verifyCtx.tryVerifyDigest(tooShortSignature, _testMessageDigestSHA1).getStatus(),
+              VerificationStatus::InvalidLength);
+    EXPECT_EQ(verifyCtx.tryVerifyDigest(_validEccIEEE1363SignatureSHA1, signVerifyTestMessage)
+                      .getStatus(),
+              VerificationStatus::InvalidLength);
+    EXPECT_EQ(verifyCtx.tryVerifyDigest(_eccIEEE1363SignatureSHA1SwappedInts,
+                                        _testMessageDigestSHA1)
+                      .getStatus(),
+              VerificationStatus::Mismatch);
+}
+
 /**
  * @brief Test that generated signature in IEEE1363 format can be verified successfully.
  */
@@ -939,6 +964,24 @@ TEST_F(SignatureTest, testSuccessfulEccMessageSigningAndVerificationInIEEE1363Fo
     ASSERT_NO_THROW(verifyCtx1.verifyMessage(signature, signVerifyTestMessage));
 }
 
+/**
+ * @brief Test that ECDSA signatures can be created and verified with BLAKE2 digests.
+ */
+TEST_F(SignatureTest, testSuccessfulEccMessageSigningAndVerificationWithBlake2)
+{
+    for (auto digestType : {DigestTypes::BLAKE2b_512, DigestTypes::BLAKE2s_256}) {
+        auto signCtx = ECDSASignaturePrivateKeyCtx(_validEccPrivateKey, digestType);
+        auto signature = signCtx.signMessage(signVerifyTestMessage);
+
+        auto verifyCtx = ECDSASignaturePublicKeyCtx(_validEccPublicKey, digestType);
+        ASSERT_NO_THROW(verifyCtx.verifyMessage(signature, signVerifyTestMessage));
+        ASSERT_NO_THROW(verifyCtx.verifyDigest(signature,
+                                               Hash::fromDigestType(digestType)
+                                                       .update(signVerifyTestMessage)
+                                                       .digest()));
+    }
+}
+
 /**
  * @brief Test that modified generated signature in IEEE1363 format fails verification.
  */
@@ -985,3 +1028,43 @@ TEST_F(SignatureTest, testUnsuccessfulEd448VerificationWithWrongPublicKey)
     ASSERT_THROW(verifyCtx.verifyMessage(_validEd448Signature, signVerifyTestMessage),
                  MoCOCrWException);
 }
+
+/**
+ * @brief Tests that the ByteView overloads sign and verify a message inside a larger buffer
+ *        without copying it, interoperable with the std::vector overloads.
+ */
+TEST_F(SignatureTest, testByteViewOverloadsMatchVectorOverloads)
+{
+    std::vector<uint8_t> buffer(16, 0xaa);
+    buffer.insert(buffer.end(), signVerifyTestMessage.begin(), signVerifyTestMessage.end());
+    ByteView message = ByteView{buffer}.subview(16);
+    auto digest = sha256(signVerifyTestMessage);
+
+    auto padding = std::make_shared<PKCSPadding>();
+    RSASignaturePrivateKeyCtx rsaSignCtx{_validRsaPrivateKey, DigestTypes::SHA256, padding};
+    RSASignaturePublicKeyCtx rsaVerifyCtx{_validRsaPublicKey, DigestTypes::SHA256, padding};
+    /* PKCS#1 v1.5 signatures are deterministic. */
+    EXPECT_EQ(rsaSignCtx.signMessage(message), rsaSignCtx.signMessage(signVerifyTestMessage));
+    auto rsaSignature = rsaSignCtx.signDigest(ByteView{digest});
+    EXPECT_NO_THROW(rsaVerifyCtx.verifyMessage(rsaSignature, message));
+    EXPECT_NO_THROW(rsaVerifyCtx.verifyDigest(ByteView{rsaSignature}, ByteView{digest}));
+    EXPECT_THROW(rsaVerifyCtx.verifyMessage(rsaSignature, message.subview(1)), MoCOCrWException);
+
+    ECDSASignaturePrivateKeyCtx eccSignCtx{_validEccPrivateKey, DigestTypes::SHA256};
+    ECDSASignaturePublicKeyCtx eccVerifyCtx{_validEccPublicKey, DigestTypes::SHA256};
+    auto eccSignature = eccSignCtx.signMessage(message);
+    EXPECT_NO_THROW(eccVerifyCtx.verifyMessage(eccSignature, signVerifyTestMessage));
+    EXPECT_NO_THROW(eccVerifyCtx.verifyDigest(ByteView{eccSignature}, ByteView{digest}));
+    EXPECT_THROW(eccSignCtx.signDigest(ByteView{digest}.subview(1)), MoCOCrWException);
+
+    EdDSASignaturePrivateKeyCtx edSignCtx{_validEd25519PrivateKey};
+    EdDSASignaturePublicKeyCtx edVerifyCtx{_validEd25519PublicKey};
+    auto edSignature = edSignCtx.signMessage(message);
+    EXPECT_EQ(edSignature, edSignCtx.signMessage(signVerifyTestMessage));
+    EXPECT_NO_THROW(edVerifyCtx.verifyMessage(ByteView{edSignature}, message));
+
+    /* Through the interfaces */
+    MessageSignatureCtx &signInterface = edSignCtx;
+    MessageVerificationCtx &verifyInterface = edVerifyCtx;
+    EXPECT_NO_THROW(verifyInterface.verifyMessage(signInterface.signMessage(message), message));
+}
@@ -19,6 +19,9 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
+#include <thread>
 
 #include "mococrw/error.h"
 #include "mococrw/symmetric_crypto.h"
@@ -167,11 +170,9 @@ TEST_P(SymmetricCipherTest, DoubleCreationUsesDifferentIVs)
     auto ciphertext1 = encryptor1->finish();
 
     if (ciphertext0.size() > 0 || ciphertext1.size() > 0) {
-        if ((operationMode != SymmetricCipherMode::GCM &&
-             operationMode != SymmetricCipherMode::CTR) ||
-            ciphertext0.size() > 1) {
-            /* Don't compare AES-GCM and AES-CTR encryptions with different IVs
-             * if the ciphertext is only 1 byte. Because GCM and CTR are stream
+        if (operationMode == SymmetricCipherMode::CBC || ciphertext0.size() > 1) {
+            /* Don't compare AES-GCM, AES-CTR and ChaCha20-Poly1305 encryptions with different IVs
+             * if the ciphertext is only 1 byte. Because these are stream
              * ciphers, it does occasionally happen that two different IVs with
              * two different keys yield the same byte in the ciphertext. With
              * block ciphers, this is not a problem, because they always
@@ -251,6 +252,10 @@ static std::vector<EncrytDecryptTestData> prepareTestDataForMode(SymmetricCipher
     std::vector<EncrytDecryptTestData> testData;
     for (const auto &elem : PLAINTEXT_STRINGS_OF_DIFFERENT_LENGTH) {
         for (const auto keySize : SUPPORTED_KEY_SIZES) {
+            if (mode == SymmetricCipherMode::CHACHA20_POLY1305 &&
+                keySize != SymmetricCipherKeySize::S_256) {
+                continue;
+            }
             testData.emplace_back(std::make_tuple(keySize, mode, elem));
         }
     }
@@ -269,8 +274,16 @@ INSTANTIATE_TEST_CASE_P(CTR,
                         SymmetricCipherTest,
                         testing::ValuesIn(prepareTestDataForMode(SymmetricCipherMode::CTR)));
 
+INSTANTIATE_TEST_CASE_P(
+        CHACHA20_POLY1305,
+        SymmetricCipherTest,
+        testing::ValuesIn(prepareTestDataForMode(SymmetricCipherMode::CHACHA20_POLY1305)));
+
 static const std::vector<SymmetricCipherMode> AllSupportedCipherModesToTest{
-        SymmetricCipherMode::CBC, SymmetricCipherMode::GCM, SymmetricCipherMode::CTR};
+        SymmetricCipherMode::CBC,
+        SymmetricCipherMode::GCM,
+        SymmetricCipherMode::CTR,
+        SymmetricCipherMode::CHACHA20_POLY1305};
 
 class SymmetricCipherAdvancedTest : public SymmetricCipherBase,
                                     public testing::TestWithParam<SymmetricCipherMode>
@@ -436,6 +449,204 @@ TEST_P(SymmetricCipherAdvancedTest, readDecryptedTextInChunks)
     ASSERT_THAT(decryptedText, ::testing::ElementsAreArray(_plaintext));
 }
 
+TEST_P(SymmetricCipherAdvancedTest, ringBufferMemoryStrategyWithSmallReads)
+{
+    auto operationMode = GetParam();
+    auto builder = AESCipherBuilder{operationMode, SymmetricCipherKeySize::S_256, _secretKey};
+    builder.setMemoryStrategy([]() { return std::make_unique<RingBufferMemoryStrategy>(); });
+
+    std::unique_ptr<AESCipher> encryptor = isAuthenticatedCipherMode(operationMode)
+                                                   ? builder.buildAuthenticatedEncryptor()
+                                                   : builder.buildEncryptor();
+    encryptor->update(_plaintext);
+
+    // Read the ciphertext in many small chunks
+    std::vector<uint8_t> ciphertext;
+    while (true) {
+        auto chunk = encryptor->read(7);
+        if (chunk.empty()) {
+            break;
+        }
+        ciphertext.insert(ciphertext.end(), chunk.begin(), chunk.end());
+    }
+    auto rest = encryptor->finish();
+    ciphertext.insert(ciphertext.end(), rest.begin(), rest.end());
+
+    builder.setIV(encryptor->getIV());
+    std::unique_ptr<AESCipher> decryptor;
+    if (isAuthenticatedCipherMode(operationMode)) {
+        auto authenticatedDecryptor = builder.buildAuthenticatedDecryptor();
+        authenticatedDecryptor->setAuthTag(
+                dynamic_cast<AuthenticatedAESCipher *>(encryptor.get())->getAuthTag());
+        decryptor = std::move(authenticatedDecryptor);
+    } else {
+        decryptor = builder.buildDecryptor();
+    }
+    decryptor->update(ciphertext);
+
+    ASSERT_EQ(decryptor->finish(), _plaintext);
+}
+
+TEST_P(SymmetricCipherAdvancedTest, throwsIfMemoryStrategyFactoryReturnsNothing)
+{
+    auto operationMode = GetParam();
+    auto builder = AESCipherBuilder{operationMode, SymmetricCipherKeySize::S_256, _secretKey};
+    builder.setMemoryStrategy([]() { return nullptr; });
+
+    if (isAuthenticatedCipherMode(operationMode)) {
+        ASSERT_THROW(builder.buildAuthenticatedEncryptor(), MoCOCrWException);
+    } else {
+        ASSERT_THROW(builder.buildEncryptor(), MoCOCrWException);
+    }
+}
+
+TEST_P(SymmetricCipherAdvancedTest, tryUpdateRespectsBackpressure)
+{
+    auto operationMode = GetParam();
+    auto iv = std::vector<uint8_t>(AESCipherBuilder::getDefaultIVLength(operationMode), 0x17);
+    auto builder = AESCipherBuilder{operationMode, SymmetricCipherKeySize::S_256, _secretKey}.setIV(
+            iv);
+    auto buildEncryptor = [&]() -> std::unique_ptr<AESCipher> {
+        return isAuthenticatedCipherMode(operationMode) ? builder.buildAuthenticatedEncryptor()
+                                                        : builder.buildEncryptor();
+    };
+
+    auto referenceEncryptor = buildEncryptor();
+    referenceEncryptor->update(_plaintext);
+    auto referenceCiphertext = referenceEncryptor->finish();
+
+    const size_t highWaterMark = 1000;
+    builder.setMemoryStrategy([highWaterMark]() {
+        return std::make_unique<BoundedMemoryStrategy>(
+                highWaterMark, BoundedMemoryStrategy::OverflowPolicy::Backpressure);
+    });
+    auto encryptor = buildEncryptor();
+
+    // update() refuses input which would exceed the high-water mark without consuming it
+    ASSERT_THROW(encryptor->update(_plaintext), MoCOCrWException);
+
+    std::vector<uint8_t> ciphertext;
+    size_t consumed = 0;
+    while (consumed < _plaintext.size()) {
+        consumed += encryptor->tryUpdate(_plaintext.data() + consumed,
+                                         _plaintext.size() - consumed);
+        auto chunk = encryptor->readAll();
+        ASSERT_LE(chunk.size(), highWaterMark);
+        ciphertext.insert(ciphertext.end(), chunk.begin(), chunk.end());
+    }
+    auto rest = encryptor->finish();
+    ciphertext.insert(ciphertext.end(), rest.begin(), rest.end());
+
+    ASSERT_EQ(ciphertext, referenceCiphertext);
+}
+
+TEST_P(SymmetricCipherAdvancedTest, spillToFileMemoryStrategy)
+{
+    auto operationMode = GetParam();
+    auto builder = AESCipherBuilder{operationMode, SymmetricCipherKeySize::S_256, _secretKey};
+    builder.setMemoryStrategy([]() {
+        return std::make_unique<BoundedMemoryStrategy>(
+                4096, BoundedMemoryStrategy::OverflowPolicy::SpillToFile);
+    });
+    std::unique_ptr<AESCipher> encryptor = isAuthenticatedCipherMode(operationMode)
+                                                   ? builder.buildAuthenticatedEncryptor()
+                                                   : builder.buildEncryptor();
+    // Write everything before reading anything, so most of the output is spilled
+    for (size_t i = 0; i < 4; i++) {
+        encryptor->update(_plaintext);
+    }
+    auto ciphertext = encryptor->finish();
+
+    builder.setIV(encryptor->getIV());
+    std::unique_ptr<AESCipher> decryptor;
+    if (isAuthenticatedCipherMode(operationMode)) {
+        auto authenticatedDecryptor = builder.buildAuthenticatedDecryptor();
+        authenticatedDecryptor->setAuthTag(
+                dynamic_cast<AuthenticatedAESCipher *>(encryptor.get())->getAuthTag());
+        decryptor = std::move(authenticatedDecryptor);
+    } else {
+        decryptor = builder.buildDecryptor();
+    }
+    decryptor->update(ciphertext);
+    auto decrypted = decryptor->finish();
+
+    ASSERT_EQ(decrypted.size(), 4 * _plaintext.size());
+    for (size_t i = 0; i < 4; i++) {
+        ASSERT_TRUE(std::equal(_plaintext.begin(),
+                               _plaintext.end(),
+                               decrypted.begin() + i * _plaintext.size()));
+    }
+}
+
+TEST_P(SymmetricCipherAdvancedTest, callerBufferUpdateMatchesBufferedUpdate)
+{
+    auto operationMode = GetParam();
+    auto iv = std::vector<uint8_t>(AESCipherBuilder::getDefaultIVLength(operationMode), 0x42);
+    auto builder = AESCipherBuilder{operationMode, SymmetricCipherKeySize::S_256, _secretKey}.setIV(
+            iv);
+    auto buildCipher = [&](bool encrypt) -> std::unique_ptr<AESCipher> {
+        if (isAuthenticatedCipherMode(operationMode)) {
+            return encrypt ? builder.buildAuthenticatedEncryptor()
+                           : builder.buildAuthenticatedDecryptor();
+        }
+        return encrypt ? builder.buildEncryptor() : builder.buildDecryptor();
+    };
+
+    auto referenceEncryptor = buildCipher(true);
+    referenceEncryptor->update(_plaintext);
+    auto referenceCiphertext = referenceEncryptor->finish();
+
+    // When: encrypting into a caller provided buffer in chunks which are not block aligned
+    auto encryptor = buildCipher(true);
+    std::vector<uint8_t> ciphertext(encryptor->getMaxUpdateOutputLength(_plaintext.size()) +
+                                    encryptor->getMaxFinishOutputLength());
+    size_t written = 0;
+    const size_t chunkSize = 1000;
+    for (size_t offset = 0; offset < _plaintext.size(); offset += chunkSize) {
+        auto length = std::min(chunkSize, _plaintext.size() - offset);
+        written += encryptor->update(_plaintext.data() + offset,
+                                     length,
+                                     ciphertext.data() + written,
+                                     ciphertext.size() - written);
+    }
+    written += encryptor->finish(ciphertext.data() + written, ciphertext.size() - written);
+    ciphertext.resize(written);
+
+    // Then: the ciphertext is the same as with the buffered interface
+    ASSERT_EQ(ciphertext, referenceCiphertext);
+
+    auto decryptor = buildCipher(false);
+    auto authenticatedDecryptor = dynamic_cast<AuthenticatedEncryptionI *>(decryptor.get());
+    if (authenticatedDecryptor) {
+        authenticatedDecryptor->setAuthTag(
+                dynamic_cast<AuthenticatedEncryptionI *>(encryptor.get())->getAuthTag());
+    }
+    std::vector<uint8_t> decrypted(decryptor->getMaxUpdateOutputLength(ciphertext.size()) +
+                                   decryptor->getMaxFinishOutputLength());
+    written = decryptor->update(
+            ciphertext.data(), ciphertext.size(), decrypted.data(), decrypted.size());
+    written += decryptor->finish(decrypted.data() + written, decrypted.size() - written);
+    decrypted.resize(written);
+
+    ASSERT_EQ(decrypted, _plaintext);
+}
+
+TEST_P(SymmetricCipherAdvancedTest, callerBufferUpdateThrowsIfOutputBufferIsTooSmall)
+{
+    auto operationMode = GetParam();
+    auto builder = AESCipherBuilder{operationMode, SymmetricCipherKeySize::S_256, _secretKey};
+    std::unique_ptr<AESCipher> encryptor;
+    if (isAuthenticatedCipherMode(operationMode)) {
+        encryptor = builder.buildAuthenticatedEncryptor();
+    } else {
+        encryptor = builder.buildEncryptor();
+    }
+
+    std::vector<uint8_t> out(_plaintext.size() - 1);
+    ASSERT_THROW(encryptor->update(_plaintext.data(), _plaintext.size(), out.data(), out.size()),
+                 MoCOCrWException);
+}
+
 INSTANTIATE_TEST_CASE_P(Chunks,
                         SymmetricCipherAdvancedTest,
                         testing::ValuesIn(AllSupportedCipherModesToTest));
@@ -563,6 +774,29 @@ TEST_F(SymmetricAuthenticatedCipherTest, authenticatesAssociatedData)
     ASSERT_THAT(decryptedText, ::testing::ElementsAreArray(_plaintext));
 }
 
+TEST_F(SymmetricAuthenticatedCipherTest, byteViewOverloadsMatchVectorOverloads)
+{
+    auto encryptor =
+            AESCipherBuilder{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, _secretKey}
+                    .buildAuthenticatedEncryptor();
+    encryptor->addAssociatedData(_associatedData);
+    encryptor->update(_plaintext);
+    auto ciphertext = encryptor->finish();
+
+    auto viewEncryptor =
+            AESCipherBuilder{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, _secretKey}
+                    .setIV(encryptor->getIV())
+                    .buildAuthenticatedEncryptor();
+    ByteView associatedData{_associatedData};
+    viewEncryptor->addAssociatedData(associatedData.subview(0, 1));
+    viewEncryptor->addAssociatedData(associatedData.subview(1));
+    ByteView plaintext{_plaintext};
+    viewEncryptor->update(plaintext.subview(0, 7));
+    viewEncryptor->update(plaintext.subview(7));
+    EXPECT_EQ(viewEncryptor->finish(), ciphertext);
+    EXPECT_EQ(viewEncryptor->getAuthTag(), encryptor->getAuthTag());
+}
+
 TEST_F(SymmetricAuthenticatedCipherTest, throwsIfaddAssociatedDataCalledAfterUpdate)
 {
     auto encryptor =
@@ -605,6 +839,281 @@ TEST_F(SymmetricAuthenticatedCipherTest, throwsIfAssociatedDataMissingOrModified
     ASSERT_THROW(decryptor2->finish(), MoCOCrWException);
 }
 
+TEST_F(SymmetricAuthenticatedCipherTest, inPlaceEncryptionAndDecryption)
+{
+    for (auto mode : {SymmetricCipherMode::GCM, SymmetricCipherMode::CTR}) {
+        auto builder = AESCipherBuilder{mode, SymmetricCipherKeySize::S_256, _secretKey};
+        std::unique_ptr<AESCipher> encryptor = isAuthenticatedCipherMode(mode)
+                                                       ? builder.buildAuthenticatedEncryptor()
+                                                       : builder.buildEncryptor();
+        encryptor->update(_plaintext);
+        auto referenceCiphertext = encryptor->finish();
+
+        builder.setIV(encryptor->getIV());
+        std::unique_ptr<AESCipher> inPlaceEncryptor =
+                isAuthenticatedCipherMode(mode) ? builder.buildAuthenticatedEncryptor()
+                                                : builder.buildEncryptor();
+        auto buffer = _plaintext;
+        ASSERT_EQ(inPlaceEncryptor->update(
+                          buffer.data(), buffer.size(), buffer.data(), buffer.size()),
+                  buffer.size());
+        ASSERT_EQ(inPlaceEncryptor->finish(nullptr, 0), 0u);
+        ASSERT_EQ(buffer, referenceCiphertext);
+
+        std::unique_ptr<AESCipher> decryptor;
+        if (isAuthenticatedCipherMode(mode)) {
+            auto authenticatedDecryptor = builder.buildAuthenticatedDecryptor();
+            authenticatedDecryptor->setAuthTag(
+                    dynamic_cast<AuthenticatedAESCipher *>(inPlaceEncryptor.get())->getAuthTag());
+            decryptor = std::move(authenticatedDecryptor);
+        } else {
+            decryptor = builder.buildDecryptor();
+        }
+        decryptor->update(buffer.data(), buffer.size(), buffer.data(), buffer.size());
+        ASSERT_EQ(decryptor->finish(nullptr, 0), 0u);
+        ASSERT_EQ(buffer, _plaintext);
+    }
+}
+
+TEST_F(SymmetricAuthenticatedCipherTest, chacha20Poly1305MatchesReferenceVector)
+{
+    // https://tools.ietf.org/html/rfc8439#section-2.8.2
+    std::string plaintextString =
+            "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the "
+            "future, sunscreen would be it.";
+    std::vector<uint8_t> plaintext{plaintextString.begin(), plaintextString.end()};
+    auto key = utility::fromHex("808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f");
+    auto iv = utility::fromHex("070000004041424344454647");
+    auto associatedData = utility::fromHex("50515253c0c1c2c3c4c5c6c7");
+    auto expectedCiphertext = utility::fromHex(
+            "d31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d63dbea45e8ca9671282fafb"
+            "69da92728b1a71de0a9e060b2905d6a5b67ecd3b3692ddbd7f2d778b8c9803aee328091b58fab324e4fad6"
+            "75945585808b4831d7bc3ff4def08e4b7a9de576d26586cec64b6116");
+    auto expectedTag = utility::fromHex("1ae10b594f09e26a7e902ecbd0600691");
+
+    auto builder = AESCipherBuilder{SymmetricCipherMode::CHACHA20_POLY1305,
+                                    SymmetricCipherKeySize::S_256,
+                                    key}
+                           .setIV(iv);
+    auto encryptor = builder.buildAuthenticatedEncryptor();
+    encryptor->addAssociatedData(associatedData);
+    encryptor->update(plaintext);
+    EXPECT_EQ(encryptor->finish(), expectedCiphertext);
+    EXPECT_EQ(encryptor->getAuthTag(), expectedTag);
+
+    auto decryptor = builder.buildAuthenticatedDecryptor();
+    decryptor->addAssociatedData(associatedData);
+    decryptor->update(expectedCiphertext);
+    decryptor->setAuthTag(expectedTag);
+    EXPECT_EQ(decryptor->finish(), plaintext);
+
+    auto modifiedTag = expectedTag;
+    modifiedTag[0] ^= 0x01;
+    auto failingDecryptor = builder.buildAuthenticatedDecryptor();
+    failingDecryptor->addAssociatedData(associatedData);
+    failingDecryptor->update(expectedCiphertext);
+    failingDecryptor->setAuthTag(modifiedTag);
+    EXPECT_THROW(failingDecryptor->finish(), MoCOCrWException);
+
+    AESKey aesKey{SymmetricCipherMode::CHACHA20_POLY1305, SymmetricCipherKeySize::S_256, key};
+    auto sealed = aeadSeal(aesKey, iv, associatedData, plaintext);
+    expectedCiphertext.insert(expectedCiphertext.end(), expectedTag.begin(), expectedTag.end());
+    EXPECT_EQ(sealed, expectedCiphertext);
+}
+
+TEST_F(SymmetricAuthenticatedCipherTest, chacha20Poly1305RequiresA256BitKey)
+{
+    EXPECT_THROW(AESCipherBuilder(SymmetricCipherMode::CHACHA20_POLY1305,
+                                  SymmetricCipherKeySize::S_128,
+                                  std::vector<uint8_t>(16))
+                         .buildAuthenticatedEncryptor(),
+                 MoCOCrWException);
+}
+
+TEST_F(SymmetricAuthenticatedCipherTest, chacha20Poly1305RequiresA96BitNonce)
+{
+    std::vector<uint8_t> key(32, 0x42);
+    for (size_t nonceLength : {8, 11, 13, 16}) {
+        std::vector<uint8_t> nonce(nonceLength, 0x24);
+        auto builder = AESCipherBuilder{
+                SymmetricCipherMode::CHACHA20_POLY1305, SymmetricCipherKeySize::S_256, key}
+                               .setIV(nonce);
+        EXPECT_THROW(builder.buildAuthenticatedEncryptor(), MoCOCrWException);
+        EXPECT_THROW(builder.buildAuthenticatedDecryptor(), MoCOCrWException);
+
+        AESKey aesKey{SymmetricCipherMode::CHACHA20_POLY1305, SymmetricCipherKeySize::S_256, key};
+        EXPECT_THROW(aeadSeal(aesKey, nonce, {}, _plaintext), MoCOCrWException);
+        EXPECT_THROW(aeadOpen(aesKey, nonce, {}, std::vector<uint8_t>(32)), MoCOCrWException);
+        AEADRecord record{nonce.data(), nonce.size(), nullptr, 0, nullptr, 0};
+        EXPECT_THROW(aeadSealBatch(aesKey, {record}), MoCOCrWException);
+    }
+}
+
+TEST_F(SymmetricAuthenticatedCipherTest, aeadSealMatchesBuilder)
+{
+    AESKey key{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, _secretKey};
+    auto iv = utility::fromHex("db0a66d2e812a3416c72f9c1");
+
+    for (size_t length : {0, 1, 200, 4096}) {
+        std::vector<uint8_t> plaintext(_plaintext.begin(), _plaintext.begin() + length);
+        auto encryptor = AESCipherBuilder{SymmetricCipherMode::GCM,
+                                          SymmetricCipherKeySize::S_256,
+                                          _secretKey}
+                                 .setIV(iv)
+                                 .buildAuthenticatedEncryptor();
+        encryptor->addAssociatedData(_associatedData);
+        encryptor->update(plaintext);
+        auto expected = encryptor->finish();
+        auto tag = encryptor->getAuthTag();
+        expected.insert(expected.end(), tag.begin(), tag.end());
+
+        auto sealed = aeadSeal(key, iv, _associatedData, plaintext);
+        EXPECT_EQ(sealed, expected);
+        EXPECT_EQ(aeadOpen(key, iv, _associatedData, sealed), plaintext);
+    }
+
+    auto sealed = aeadSeal(key, iv, {}, _plaintext, 12);
+    EXPECT_EQ(sealed.size(), _plaintext.size() + 12);
+    EXPECT_EQ(aeadOpen(key, iv, {}, sealed, 12), _plaintext);
+}
+
+TEST_F(SymmetricAuthenticatedCipherTest, aeadSealAndOpenInPlace)
+{
+    AESKey gcmKey{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, _secretKey};
+    AESKey key{SymmetricCipherMode::CTR, SymmetricCipherKeySize::S_256, _secretKey};
+    key = gcmKey;
+    auto iv = utility::cryptoRandomBytes(12);
+    auto expected = aeadSeal(key, iv, _associatedData, _plaintext);
+
+    std::vector<uint8_t> buffer(_plaintext);
+    buffer.resize(_plaintext.size() + AESKey::DefaultAuthTagLength);
+    EXPECT_THROW(aeadSeal(key,
+                          iv.data(),
+                          iv.size(),
+                          _associatedData.data(),
+                          _associatedData.size(),
+                          buffer.data(),
+                          _plaintext.size(),
+                          buffer.data(),
+                          buffer.size() - 1),
+                 MoCOCrWException);
+    EXPECT_EQ(aeadSeal(key,
+                       iv.data(),
+                       iv.size(),
+                       _associatedData.data(),
+                       _associatedData.size(),
+                       buffer.data(),
+                       _plaintext.size(),
+                       buffer.data(),
+                       buffer.size()),
+              buffer.size());
+    EXPECT_EQ(buffer, expected);
+
+    EXPECT_EQ(aeadOpen(key,
+                       iv.data(),
+                       iv.size(),
+                       _associatedData.data(),
+                       _associatedData.size(),
+                       buffer.data(),
+                       buffer.size(),
+                       buffer.data(),
+                       buffer.size()),
+              _plaintext.size());
+    buffer.resize(_plaintext.size());
+    EXPECT_EQ(buffer, _plaintext);
+}
+
+TEST_F(SymmetricAuthenticatedCipherTest, aeadOpenThrowsAndCleansesOnAuthenticationFailure)
+{
+    AESKey key{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, _secretKey};
+    auto iv = utility::cryptoRandomBytes(12);
+    auto sealed = aeadSeal(key, iv, _associatedData, _plaintext);
+
+    auto modified = sealed;
+    modified[10] ^= 0x01;
+    std::vector<uint8_t> out(_plaintext.size(), 0xaa);
+    EXPECT_THROW(aeadOpen(key,
+                          iv.data(),
+                          iv.size(),
+                          _associatedData.data(),
+                          _associatedData.size(),
+                          modified.data(),
+                          modified.size(),
+                          out.data(),
+                          out.size()),
+                 MoCOCrWException);
+    EXPECT_EQ(out, std::vector<uint8_t>(out.size(), 0));
+
+    EXPECT_THROW(aeadOpen(key, iv, {}, sealed), MoCOCrWException);
+    EXPECT_THROW(aeadOpen(key, utility::cryptoRandomBytes(12), _associatedData, sealed),
+                 MoCOCrWException);
+    EXPECT_THROW(aeadOpen(key, iv, _associatedData, std::vector<uint8_t>(15)),
+                 MoCOCrWException);
+    EXPECT_THROW(aeadSeal(key, {}, _associatedData, _plaintext), MoCOCrWException);
+    EXPECT_THROW(aeadSeal(key, iv, _associatedData, _plaintext, 17), MoCOCrWException);
+
+    AESKey ctrKey{SymmetricCipherMode::CTR, SymmetricCipherKeySize::S_256, _secretKey};
+    EXPECT_THROW(aeadSeal(ctrKey, iv, _associatedData, _plaintext), MoCOCrWException);
+}
+
+TEST_F(SymmetricAuthenticatedCipherTest, aeadSealBatchMatchesSingleMessages)
+{
+    for (auto mode : {SymmetricCipherMode::GCM, SymmetricCipherMode::CHACHA20_POLY1305}) {
+        AESKey key{mode, SymmetricCipherKeySize::S_256, _secretKey};
+
+        std::vector<std::vector<uint8_t>> nonces;
+        for (size_t i = 0; i < 300; i++) {
+            nonces.push_back(utility::cryptoRandomBytes(12));
+        }
+        std::vector<AEADRecord> records;
+        for (size_t i = 0; i < nonces.size(); i++) {
+            records.push_back({nonces[i].data(),
+                               nonces[i].size(),
+                               _associatedData.data(),
+                               i % 3 == 0 ? 0 : _associatedData.size(),
+                               _plaintext.data() + i,
+                               i * 7});
+        }
+
+        auto batch = aeadSealBatch(key, records, AESKey::DefaultAuthTagLength, 4);
+        ASSERT_EQ(batch.size(), records.size());
+        EXPECT_EQ(batch.arena.size(), aeadSealBatchLength(records));
+
+        for (size_t i = 0; i < records.size(); i++) {
+            std::vector<uint8_t> aad(_associatedData.begin(),
+                                     _associatedData.begin() + records[i].associatedDataLength);
+            std::vector<uint8_t> plaintext(_plaintext.begin() + i,
+                                           _plaintext.begin() + i + records[i].plaintextLength);
+            std::vector<uint8_t> sealed(batch.data(i), batch.data(i) + batch.length(i));
+            EXPECT_EQ(sealed, aeadSeal(key, nonces[i], aad, plaintext));
+            EXPECT_EQ(aeadOpen(key, nonces[i], aad, sealed), plaintext);
+        }
+    }
+}
+
+TEST_F(SymmetricAuthenticatedCipherTest, aeadSealBatchIntoCallerBuffer)
+{
+    AESKey key{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, _secretKey};
+    auto nonce = utility::cryptoRandomBytes(12);
+    std::vector<AEADRecord> records{
+            {nonce.data(), nonce.size(), nullptr, 0, _plaintext.data(), 100},
+            {nonce.data(), 8, nullptr, 0, _plaintext.data(), 0}};
+
+    std::vector<uint8_t> buffer(aeadSealBatchLength(records, 12));
+    EXPECT_THROW(aeadSealBatch(key, records, buffer.data(), buffer.size() - 1, 12),
+                 MoCOCrWException);
+    auto offsets = aeadSealBatch(key, records, buffer.data(), buffer.size(), 12);
+    EXPECT_EQ(offsets, (std::vector<size_t>{0, 112, 124}));
+
+    EXPECT_EQ(aeadSealBatch(key, {}).size(), 0u);
+
+    records.push_back({nonce.data(), 0, nullptr, 0, _plaintext.data(), 1});
+    EXPECT_THROW(aeadSealBatch(key, records), MoCOCrWException);
+
+    AESKey cbcKey{SymmetricCipherMode::CBC, SymmetricCipherKeySize::S_256, _secretKey};
+    EXPECT_THROW(aeadSealBatch(cbcKey, records), MoCOCrWException);
+}
+
 TEST_F(SymmetricAuthenticatedCipherTest, cipherTextSameWithAndWithoutAssociatedData)
 {
     const std::vector<uint8_t> iv = utility::fromHex("db0a66d2e812a3416c72f9c10280d100");
@@ -623,3 +1132,383 @@ TEST_F(SymmetricAuthenticatedCipherTest, cipherTextSameWithAndWithoutAssociatedD
 
     ASSERT_EQ(ciphertext1, ciphertext2);
 }
+
+class AESKeyTest : public SymmetricCipherAdvancedTest
+{
+public:
+    std::vector<uint8_t> encryptWithKey(const AESKey &key,
+                                        const std::vector<uint8_t> &iv,
+                                        std::vector<uint8_t> *tag = nullptr)
+    {
+        if (isAuthenticatedCipherMode(key.getMode())) {
+            auto encryptor = key.createAuthenticatedEncryptor(iv);
+            encryptor->addAssociatedData(_associatedData);
+            encryptor->update(_plaintext);
+            auto ciphertext = encryptor->finish();
+            *tag = encryptor->getAuthTag();
+            return ciphertext;
+        }
+        auto encryptor = key.createEncryptor(iv);
+        encryptor->update(_plaintext);
+        return encryptor->finish();
+    }
+
+    std::vector<uint8_t> decryptWithKey(const AESKey &key,
+                                        const std::vector<uint8_t> &iv,
+                                        const std::vector<uint8_t> &ciphertext,
+                                        const std::vector<uint8_t> &tag)
+    {
+        if (isAuthenticatedCipherMode(key.getMode())) {
+            auto decryptor = key.createAuthenticatedDecryptor(iv);
+            decryptor->addAssociatedData(_associatedData);
+            decryptor->update(ciphertext);
+            decryptor->setAuthTag(tag);
+            return decryptor->finish();
+        }
+        auto decryptor = key.createDecryptor(iv);
+        decryptor->update(ciphertext);
+        return decryptor->finish();
+    }
+};
+
+TEST_P(AESKeyTest, ciphersMatchBuilderForEveryIV)
+{
+    auto operationMode = GetParam();
+    AESKey key{operationMode, SymmetricCipherKeySize::S_256, _secretKey};
+
+    for (int i = 0; i < 5; i++) {
+        auto iv = utility::cryptoRandomBytes(AESCipherBuilder::getDefaultIVLength(operationMode));
+        auto builder =
+                AESCipherBuilder{operationMode, SymmetricCipherKeySize::S_256, _secretKey}.setIV(
+                        iv);
+
+        std::vector<uint8_t> tag;
+        auto ciphertext = encryptWithKey(key, iv, &tag);
+
+        if (isAuthenticatedCipherMode(operationMode)) {
+            auto encryptor = builder.buildAuthenticatedEncryptor();
+            encryptor->addAssociatedData(_associatedData);
+            encryptor->update(_plaintext);
+            EXPECT_EQ(encryptor->finish(), ciphertext);
+            EXPECT_EQ(encryptor->getAuthTag(), tag);
+        } else {
+            auto encryptor = builder.buildEncryptor();
+            encryptor->update(_plaintext);
+            EXPECT_EQ(encryptor->finish(), ciphertext);
+        }
+
+        EXPECT_EQ(decryptWithKey(key, iv, ciphertext, tag), _plaintext);
+    }
+}
+
+TEST_P(AESKeyTest, clonedKeysCanBeUsedConcurrently)
+{
+    auto operationMode = GetParam();
+    AESKey key{operationMode, SymmetricCipherKeySize::S_256, _secretKey};
+    auto iv = utility::cryptoRandomBytes(AESCipherBuilder::getDefaultIVLength(operationMode));
+
+    std::vector<uint8_t> tag;
+    auto expectedCiphertext = encryptWithKey(key, iv, &tag);
+
+    std::vector<int> failures(4, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < failures.size(); t++) {
+        threads.emplace_back([&, t, threadKey = key.clone()]() {
+            for (int i = 0; i < 10; i++) {
+                std::vector<uint8_t> threadTag;
+                auto ciphertext = encryptWithKey(threadKey, iv, &threadTag);
+                if (ciphertext != expectedCiphertext || threadTag != tag ||
+                    decryptWithKey(threadKey, iv, ciphertext, threadTag) != _plaintext) {
+                    failures[t]++;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(failures, std::vector<int>(failures.size(), 0));
+}
+
+TEST_P(AESKeyTest, throwsOnInvalidParameters)
+{
+    auto operationMode = GetParam();
+    EXPECT_THROW(AESKey(operationMode, SymmetricCipherKeySize::S_256, std::vector<uint8_t>(12, 1)),
+                 MoCOCrWException);
+
+    AESKey key{operationMode, SymmetricCipherKeySize::S_256, _secretKey};
+    std::vector<uint8_t> shortIv(9, 1);
+    if (isAuthenticatedCipherMode(operationMode)) {
+        EXPECT_THROW(key.createEncryptor(shortIv), MoCOCrWException);
+        EXPECT_THROW(key.createDecryptor(shortIv), MoCOCrWException);
+        EXPECT_THROW(key.createAuthenticatedEncryptor({}), MoCOCrWException);
+        if (operationMode == SymmetricCipherMode::CHACHA20_POLY1305) {
+            EXPECT_THROW(key.createAuthenticatedEncryptor(shortIv), MoCOCrWException);
+            EXPECT_THROW(key.createAuthenticatedDecryptor(shortIv), MoCOCrWException);
+        } else {
+            EXPECT_NO_THROW(key.createAuthenticatedEncryptor(shortIv));
+        }
+    } else {
+        EXPECT_THROW(key.createAuthenticatedEncryptor(shortIv), MoCOCrWException);
+        EXPECT_THROW(key.createAuthenticatedDecryptor(shortIv), MoCOCrWException);
+        EXPECT_THROW(key.createEncryptor(shortIv), MoCOCrWException);
+        EXPECT_THROW(key.createDecryptor(shortIv), MoCOCrWException);
+    }
+
+    AESKey movedTo{std::move(key)};
+    EXPECT_EQ(movedTo.getMode(), operationMode);
+}
+
+INSTANTIATE_TEST_CASE_P(AllModes, AESKeyTest, testing::ValuesIn(AllSupportedCipherModesToTest));
+
+class AESKeyBulkTest : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        _secretKey = utility::fromHex(
+                "0000000000000000000000000000000011111111111111111111111111111111");
+        // The counter overflows the lower 64 bit within the first segment.
+        _iv = utility::fromHex("000102030405060708fffffffffffff0");
+        _data.resize(3 * AESKey::BulkSegmentSize + 37);
+        for (size_t i = 0; i < _data.size(); i++) {
+            _data[i] = static_cast<uint8_t>(i * 7 + 3);
+        }
+    }
+
+    std::vector<uint8_t> serial(std::unique_ptr<AESCipher> cipher, const std::vector<uint8_t> &in)
+    {
+        cipher->update(in);
+        return cipher->finish();
+    }
+
+    std::vector<uint8_t> _secretKey;
+    std::vector<uint8_t> _iv;
+    std::vector<uint8_t> _data;
+};
+
+TEST_F(AESKeyBulkTest, ctrMatchesSerialCipher)
+{
+    AESKey key{SymmetricCipherMode::CTR, SymmetricCipherKeySize::S_256, _secretKey};
+
+    for (size_t length : {size_t{0},
+                          size_t{1},
+                          size_t{17},
+                          AESKey::BulkSegmentSize - 1,
+                          AESKey::BulkSegmentSize,
+                          _data.size()}) {
+        std::vector<uint8_t> plaintext(_data.begin(), _data.begin() + length);
+        auto expected = serial(key.createEncryptor(_iv), plaintext);
+
+        auto ciphertext = key.bulkEncrypt(_iv, plaintext, 4);
+        EXPECT_EQ(ciphertext, expected);
+        EXPECT_EQ(key.bulkDecrypt(_iv, ciphertext, SymmetricCipherPadding::NO, 4), plaintext);
+        EXPECT_EQ(key.bulkDecrypt(_iv, ciphertext, SymmetricCipherPadding::PKCS, 1), plaintext);
+    }
+}
+
+TEST_F(AESKeyBulkTest, cbcDecryptionMatchesSerialCipher)
+{
+    AESKey key{SymmetricCipherMode::CBC, SymmetricCipherKeySize::S_256, _secretKey};
+
+    for (size_t length :
+         {size_t{0}, size_t{15}, AESKey::BulkSegmentSize, _data.size(), _data.size() - 37}) {
+        std::vector<uint8_t> plaintext(_data.begin(), _data.begin() + length);
+        auto ciphertext = serial(key.createEncryptor(_iv), plaintext);
+        EXPECT_EQ(key.bulkDecrypt(_iv, ciphertext, SymmetricCipherPadding::PKCS, 4), plaintext);
+
+        if (length % 16 == 0) {
+            auto unpadded = serial(key.createEncryptor(_iv, SymmetricCipherPadding::NO), plaintext);
+            EXPECT_EQ(key.bulkDecrypt(_iv, unpadded, SymmetricCipherPadding::NO, 4), plaintext);
+        }
+    }
+}
+
+TEST_F(AESKeyBulkTest, inPlaceProcessing)
+{
+    for (auto mode : {SymmetricCipherMode::CBC, SymmetricCipherMode::CTR}) {
+        AESKey key{mode, SymmetricCipherKeySize::S_128, std::vector<uint8_t>(16, 0x42)};
+        auto buffer = serial(key.createEncryptor(_iv), _data);
+
+        size_t length = key.bulkDecrypt(_iv,
+                                        buffer.data(),
+                                        buffer.size(),
+                                        buffer.data(),
+                                        buffer.size(),
+                                        SymmetricCipherPadding::PKCS,
+                                        3);
+        buffer.resize(length);
+        EXPECT_EQ(buffer, _data);
+    }
+}
+
+TEST_F(AESKeyBulkTest, throwsOnInvalidParameters)
+{
+    AESKey cbcKey{SymmetricCipherMode::CBC, SymmetricCipherKeySize::S_256, _secretKey};
+    AESKey ctrKey{SymmetricCipherMode::CTR, SymmetricCipherKeySize::S_256, _secretKey};
+    AESKey gcmKey{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, _secretKey};
+
+    EXPECT_THROW(cbcKey.bulkEncrypt(_iv, _data), MoCOCrWException);
+    EXPECT_THROW(gcmKey.bulkEncrypt(_iv, _data), MoCOCrWException);
+    EXPECT_THROW(gcmKey.bulkDecrypt(_iv, _data), MoCOCrWException);
+    EXPECT_THROW(cbcKey.bulkDecrypt(_iv, _data), MoCOCrWException);
+    EXPECT_THROW(ctrKey.bulkDecrypt(std::vector<uint8_t>(12), _data), MoCOCrWException);
+
+    std::vector<uint8_t> out(10);
+    EXPECT_THROW(ctrKey.bulkEncrypt(_iv, _data.data(), 11, out.data(), out.size()),
+                 MoCOCrWException);
+
+    auto ciphertext = serial(cbcKey.createEncryptor(_iv, SymmetricCipherPadding::NO),
+                             std::vector<uint8_t>(_data.begin(), _data.begin() + 64));
+    /* The decrypted last block doesn't contain valid padding. */
+    EXPECT_THROW(cbcKey.bulkDecrypt(_iv, ciphertext), MoCOCrWException);
+}
+
+TEST_F(AESKeyBulkTest, seekableCTRDecryptionOfArbitraryRanges)
+{
+    AESKey key{SymmetricCipherMode::CTR, SymmetricCipherKeySize::S_256, _secretKey};
+    auto ciphertext = key.bulkEncrypt(_iv, _data);
+    SeekableCTRDecryptor decryptor{key, _iv};
+
+    for (size_t offset : {0, 1, 15, 16, 4095, 1000003}) {
+        for (size_t length : {0, 1, 16, 33, 70000}) {
+            std::vector<uint8_t> range(ciphertext.begin() + offset,
+                                       ciphertext.begin() + offset + length);
+            std::vector<uint8_t> expected(_data.begin() + offset, _data.begin() + offset + length);
+            EXPECT_EQ(decryptor.decrypt(offset, range), expected);
+        }
+    }
+
+    /* in place */
+    std::vector<uint8_t> range(ciphertext.begin() + 100, ciphertext.begin() + 200);
+    decryptor.decrypt(100, range.data(), range.size(), range.data());
+    EXPECT_EQ(range, std::vector<uint8_t>(_data.begin() + 100, _data.begin() + 200));
+}
+
+TEST_F(AESKeyBulkTest, seekableCTRDecryptionFromMultipleThreads)
+{
+    AESKey key{SymmetricCipherMode::CTR, SymmetricCipherKeySize::S_128, std::vector<uint8_t>(16)};
+    auto ciphertext = key.bulkEncrypt(_iv, _data);
+    SeekableCTRDecryptor decryptor{key, _iv};
+
+    std::vector<int> failures(4, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < failures.size(); t++) {
+        threads.emplace_back([&, t]() {
+            for (size_t i = 0; i < 200; i++) {
+                size_t offset = (t * 7919 + i * 104729) % (_data.size() - 512);
+                std::vector<uint8_t> out(512);
+                decryptor.decrypt(offset, ciphertext.data() + offset, out.size(), out.data());
+                if (!std::equal(out.begin(), out.end(), _data.begin() + offset)) {
+                    failures[t]++;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(failures, std::vector<int>(failures.size(), 0));
+}
+
+TEST_F(AESKeyBulkTest, seekableCTRDecryptorThrowsOnInvalidParameters)
+{
+    AESKey ctrKey{SymmetricCipherMode::CTR, SymmetricCipherKeySize::S_256, _secretKey};
+    AESKey cbcKey{SymmetricCipherMode::CBC, SymmetricCipherKeySize::S_256, _secretKey};
+
+    EXPECT_THROW(SeekableCTRDecryptor(cbcKey, _iv), MoCOCrWException);
+    EXPECT_THROW(SeekableCTRDecryptor(ctrKey, std::vector<uint8_t>(12)), MoCOCrWException);
+}
+
+TEST(GCMNonceSequencerTest, createsFixedFieldAndBigEndianCounter)
+{
+    GCMNonceSequencer nonces{utility::fromHex("a1b2c3d4"), 0xfffffffe};
+    EXPECT_EQ(utility::toHex(nonces.next()), "a1b2c3d400000000fffffffe");
+    EXPECT_EQ(utility::toHex(nonces.next()), "a1b2c3d400000000ffffffff");
+
+    uint8_t nonce[12];
+    nonces.next(nonce);
+    EXPECT_EQ(utility::toHex(std::vector<uint8_t>(nonce, nonce + sizeof(nonce))),
+              "a1b2c3d40000000100000000");
+    EXPECT_EQ(nonces.getInvocationCount(), 0x100000001u);
+}
+
+TEST(GCMNonceSequencerTest, enforcesInvocationLimit)
+{
+    GCMNonceSequencer nonces{std::vector<uint8_t>(4), 0, 3};
+    for (int i = 0; i < 3; i++) {
+        nonces.next();
+    }
+    EXPECT_THROW(nonces.next(), MoCOCrWException);
+    EXPECT_EQ(nonces.getInvocationCount(), 3u);
+
+    GCMNonceSequencer exhausted{std::vector<uint8_t>(4), std::numeric_limits<uint64_t>::max()};
+    EXPECT_THROW(exhausted.next(), MoCOCrWException);
+
+    EXPECT_THROW(GCMNonceSequencer(std::vector<uint8_t>(12)), MoCOCrWException);
+}
+
+TEST(GCMNonceSequencerTest, noncesAreUniqueAcrossThreads)
+{
+    const size_t threads = 4;
+    const size_t noncesPerThread = 5000;
+    GCMNonceSequencer nonces{utility::fromHex("00010203")};
+    std::vector<std::vector<std::vector<uint8_t>>> created(threads);
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            for (size_t i = 0; i < noncesPerThread; i++) {
+                created[t].push_back(nonces.next());
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    std::set<std::vector<uint8_t>> unique;
+    for (const auto &perThread : created) {
+        unique.insert(perThread.begin(), perThread.end());
+    }
+    EXPECT_EQ(unique.size(), threads * noncesPerThread);
+    EXPECT_EQ(nonces.getInvocationCount(), threads * noncesPerThread);
+}
+
+TEST(GCMNonceSequencerTest, plugsIntoBuilderAndAESKey)
+{
+    auto secretKey = utility::fromHex(
+            "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+    std::vector<uint8_t> plaintext(100, 0x5a);
+    AESKey key{SymmetricCipherMode::GCM, SymmetricCipherKeySize::S_256, secretKey};
+    GCMNonceSequencer nonces{utility::fromHex("cafebabe")};
+
+    auto nonce = nonces.next();
+    auto encryptor = AESCipherBuilder{SymmetricCipherMode::GCM,
+                                      SymmetricCipherKeySize::S_256,
+                                      secretKey}
+                             .setIV(nonce)
+                             .buildAuthenticatedEncryptor();
+    encryptor->update(plaintext);
+    auto ciphertext = encryptor->finish();
+    auto tag = encryptor->getAuthTag();
+    ciphertext.insert(ciphertext.end(), tag.begin(), tag.end());
+    EXPECT_EQ(aeadOpen(key, nonce, {}, ciphertext), plaintext);
+
+    uint8_t nextNonce[12];
+    nonces.next(nextNonce);
+    std::vector<uint8_t> sealed(plaintext.size() + AESKey::DefaultAuthTagLength);
+    aeadSeal(key,
+             nextNonce,
+             sizeof(nextNonce),
+             nullptr,
+             0,
+             plaintext.data(),
+             plaintext.size(),
+             sealed.data(),
+             sealed.size());
+    EXPECT_EQ(aeadOpen(key, std::vector<uint8_t>(nextNonce, nextNonce + 12), {}, sealed),
+              plaintext);
+}
@@ -20,10 +20,19 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#include "mococrw/error.h"
 #include "mococrw/symmetric_memory.h"
 
 using namespace mococrw;
 
+template <class MemoryStrategy>
 class SymmetricCipherMemoryStrategy : public ::testing::Test
 {
 protected:
@@ -46,77 +55,250 @@ protected:
         ASSERT_THAT(readData, ::testing::ElementsAreArray(expected));
     }
 
-    QueueOfVectorsMemoryStrategy sut;
+    MemoryStrategy sut;
 
     const int NUMBER_OF_TEST_BLOCKS = 4;
     const int TEST_BLOCK_LENGTH = 16;
     std::vector<uint8_t> _expectedData;
 };
 
-TEST_F(SymmetricCipherMemoryStrategy, SeveralWritesAndReadAll)
+using MemoryStrategies = ::testing::Types<QueueOfVectorsMemoryStrategy, RingBufferMemoryStrategy>;
+TYPED_TEST_CASE(SymmetricCipherMemoryStrategy, MemoryStrategies);
+
+TYPED_TEST(SymmetricCipherMemoryStrategy, SeveralWritesAndReadAll)
 {
-    sut.write({std::begin(_expectedData), std::begin(_expectedData) + 3});
-    sut.write({std::begin(_expectedData) + 3, std::begin(_expectedData) + 7});
-    sut.write({std::begin(_expectedData) + 7, std::end(_expectedData)});
+    this->sut.write({std::begin(this->_expectedData), std::begin(this->_expectedData) + 3});
+    this->sut.write({std::begin(this->_expectedData) + 3, std::begin(this->_expectedData) + 7});
+    this->sut.write({std::begin(this->_expectedData) + 7, std::end(this->_expectedData)});
 
-    auto readChunk = sut.readAll();
-    ASSERT_THAT(readChunk, ::testing::ElementsAreArray(_expectedData));
+    auto readChunk = this->sut.readAll();
+    ASSERT_THAT(readChunk, ::testing::ElementsAreArray(this->_expectedData));
 }
 
-TEST_F(SymmetricCipherMemoryStrategy, ReadMoreThanQueueHolds)
+TYPED_TEST(SymmetricCipherMemoryStrategy, ReadMoreThanQueueHolds)
 {
-    sut.write({std::begin(_expectedData), std::begin(_expectedData) + 3});
-    sut.write({std::begin(_expectedData) + 3, std::begin(_expectedData) + 20});
+    this->sut.write({std::begin(this->_expectedData), std::begin(this->_expectedData) + 3});
+    this->sut.write({std::begin(this->_expectedData) + 3, std::begin(this->_expectedData) + 20});
 
-    auto readChunk = sut.read(_expectedData.size());
+    auto readChunk = this->sut.read(this->_expectedData.size());
     ASSERT_EQ(readChunk.size(), 20);
 }
 
-TEST_F(SymmetricCipherMemoryStrategy, EmptyReadAll)
+TYPED_TEST(SymmetricCipherMemoryStrategy, EmptyReadAll)
 {
-    auto readBlock = sut.read(TEST_BLOCK_LENGTH);
+    auto readBlock = this->sut.read(this->TEST_BLOCK_LENGTH);
     ASSERT_TRUE(readBlock.empty());
 }
 
-TEST_F(SymmetricCipherMemoryStrategy, ReadInWrittenBlockSizes)
+TYPED_TEST(SymmetricCipherMemoryStrategy, ReadInWrittenBlockSizes)
+{
+    auto dataPacketizer = std::begin(this->_expectedData);
+
+    for (int i = 0; i < this->NUMBER_OF_TEST_BLOCKS - 1; ++i) {
+        this->sut.write({dataPacketizer, dataPacketizer + this->TEST_BLOCK_LENGTH});
+        dataPacketizer += this->TEST_BLOCK_LENGTH;
+    }
+
+    auto readBlock1 = this->sut.read(this->TEST_BLOCK_LENGTH);
+    auto readBlock2 = this->sut.read(this->TEST_BLOCK_LENGTH);
+
+    this->sut.write({dataPacketizer, dataPacketizer + this->TEST_BLOCK_LENGTH});
+    dataPacketizer += this->TEST_BLOCK_LENGTH;
+
+    auto readBlock3 = this->sut.read(this->TEST_BLOCK_LENGTH);
+    auto readBlock4 = this->sut.read(this->TEST_BLOCK_LENGTH);
+
+    this->assembleFromChunksAndCompareWithExpected(
+            this->_expectedData, {readBlock1, readBlock2, readBlock3, readBlock4});
+}
+
+TYPED_TEST(SymmetricCipherMemoryStrategy, ReadInUnalignedBlockSizes)
+{
+    auto dataPacketizer = std::begin(this->_expectedData);
+    for (int i = 0; i < this->NUMBER_OF_TEST_BLOCKS - 1; ++i) {
+        this->sut.write({dataPacketizer, dataPacketizer + this->TEST_BLOCK_LENGTH});
+        dataPacketizer += this->TEST_BLOCK_LENGTH;
+    }
+
+    auto readBlock1 = this->sut.read(this->TEST_BLOCK_LENGTH / 2);
+    auto readBlock2 = this->sut.read(this->TEST_BLOCK_LENGTH * 1.6);
+
+    this->sut.write({dataPacketizer, dataPacketizer + this->TEST_BLOCK_LENGTH});
+    dataPacketizer += this->TEST_BLOCK_LENGTH;
+
+    auto readBlock3 = this->sut.read(this->TEST_BLOCK_LENGTH);
+    auto readBlock4 = this->sut.readAll();
+
+    this->assembleFromChunksAndCompareWithExpected(
+            this->_expectedData, {readBlock1, readBlock2, readBlock3, readBlock4});
+}
+
+TEST(RingBufferMemoryStrategyTest, ManySmallReadsWrapAroundAndGrowBuffer)
+{
+    RingBufferMemoryStrategy sut(8);
+    std::vector<uint8_t> written;
+    std::vector<uint8_t> read;
+    uint8_t counter = 0;
+
+    // Interleave writes and reads of different sizes, so the cursor wraps around several times
+    // and the buffer has to grow while it holds wrapped data.
+    for (size_t round = 1; round < 50; round++) {
+        std::vector<uint8_t> chunk(round % 13 + 1);
+        for (auto &byte : chunk) {
+            byte = counter++;
+        }
+        written.insert(written.end(), chunk.begin(), chunk.end());
+        sut.write(chunk);
+
+        auto readChunk = sut.read(round % 7 + 1);
+        read.insert(read.end(), readChunk.begin(), readChunk.end());
+        ASSERT_EQ(sut.size(), written.size() - read.size());
+    }
+    auto rest = sut.readAll();
+    read.insert(read.end(), rest.begin(), rest.end());
+
+    ASSERT_EQ(read, written);
+    ASSERT_EQ(sut.size(), 0u);
+    ASSERT_GE(sut.capacity(), 8u);
+}
+
+TEST(RingBufferMemoryStrategyTest, GrowsGeometrically)
 {
-    auto dataPacketizer = std::begin(_expectedData);
+    RingBufferMemoryStrategy sut;
+    sut.write(std::vector<uint8_t>(100, 1));
+    ASSERT_EQ(sut.capacity(), 100u);
+    sut.write(std::vector<uint8_t>(1, 2));
+    ASSERT_EQ(sut.capacity(), 200u);
+}
+
+class BoundedMemoryStrategyTest : public ::testing::Test
+{
+protected:
+    std::vector<uint8_t> makeData(size_t length, uint8_t seed)
+    {
+        std::vector<uint8_t> data(length);
+        for (size_t i = 0; i < length; i++) {
+            data[i] = static_cast<uint8_t>(seed + i);
+        }
+        return data;
+    }
 
-    for (int i = 0; i < NUMBER_OF_TEST_BLOCKS - 1; ++i) {
-        sut.write({dataPacketizer, dataPacketizer + TEST_BLOCK_LENGTH});
-        dataPacketizer += TEST_BLOCK_LENGTH;
+    // The unlinked file is still reachable through /proc while its descriptor is open.
+    int findSpillFileDescriptor()
+    {
+        int spillFd = -1;
+        DIR *fdDirectory = opendir("/proc/self/fd");
+        if (fdDirectory == nullptr) {
+            return spillFd;
+        }
+        while (auto *entry = readdir(fdDirectory)) {
+            std::string path = std::string("/proc/self/fd/") + entry->d_name;
+            char target[4096];
+            auto length = readlink(path.c_str(), target, sizeof(target) - 1);
+            if (length > 0 &&
+                std::string(target, length).find("mococrw-spill-") != std::string::npos) {
+                spillFd = std::stoi(entry->d_name);
+            }
+        }
+        closedir(fdDirectory);
+        return spillFd;
     }
+};
 
-    auto readBlock1 = sut.read(TEST_BLOCK_LENGTH);
-    auto readBlock2 = sut.read(TEST_BLOCK_LENGTH);
+TEST_F(BoundedMemoryStrategyTest, BackpressureReportsAvailableCapacity)
+{
+    BoundedMemoryStrategy sut(100, BoundedMemoryStrategy::OverflowPolicy::Backpressure);
+    ASSERT_EQ(sut.availableCapacity(), 100u);
 
-    sut.write({dataPacketizer, dataPacketizer + TEST_BLOCK_LENGTH});
-    dataPacketizer += TEST_BLOCK_LENGTH;
+    sut.write(makeData(60, 0));
+    ASSERT_EQ(sut.availableCapacity(), 40u);
 
-    auto readBlock3 = sut.read(TEST_BLOCK_LENGTH);
-    auto readBlock4 = sut.read(TEST_BLOCK_LENGTH);
+    // Exceeding the high-water mark is possible, e.g. for the final block of a cipher
+    sut.write(makeData(50, 60));
+    ASSERT_EQ(sut.availableCapacity(), 0u);
 
-    assembleFromChunksAndCompareWithExpected(_expectedData,
-                                             {readBlock1, readBlock2, readBlock3, readBlock4});
+    ASSERT_EQ(sut.read(30), makeData(30, 0));
+    ASSERT_EQ(sut.availableCapacity(), 20u);
+    ASSERT_EQ(sut.readAll(), makeData(80, 30));
+    ASSERT_EQ(sut.availableCapacity(), 100u);
 }
 
-TEST_F(SymmetricCipherMemoryStrategy, ReadInUnalignedBlockSizes)
+TEST_F(BoundedMemoryStrategyTest, SpillToFileKeepsOrderOfData)
 {
-    auto dataPacketizer = std::begin(_expectedData);
-    for (int i = 0; i < NUMBER_OF_TEST_BLOCKS - 1; ++i) {
-        sut.write({dataPacketizer, dataPacketizer + TEST_BLOCK_LENGTH});
-        dataPacketizer += TEST_BLOCK_LENGTH;
+    BoundedMemoryStrategy sut(64, BoundedMemoryStrategy::OverflowPolicy::SpillToFile);
+    ASSERT_EQ(sut.availableCapacity(), std::numeric_limits<size_t>::max());
+
+    auto data = makeData(1000, 7);
+    std::vector<uint8_t> read;
+    size_t written = 0;
+    for (size_t chunkSize : {10u, 100u, 3u, 300u, 50u}) {
+        sut.write({data.begin() + written, data.begin() + written + chunkSize});
+        written += chunkSize;
+        auto chunk = sut.read(17);
+        read.insert(read.end(), chunk.begin(), chunk.end());
     }
+    ASSERT_GT(sut.spilledSize(), 0u);
+    ASSERT_EQ(sut.size(), written - read.size());
 
-    auto readBlock1 = sut.read(TEST_BLOCK_LENGTH / 2);
-    auto readBlock2 = sut.read(TEST_BLOCK_LENGTH * 1.6);
+    // Drain completely so the spill file is reused from the beginning
+    while (sut.size() > 0) {
+        auto chunk = sut.read(40);
+        ASSERT_LE(chunk.size(), 40u);
+        read.insert(read.end(), chunk.begin(), chunk.end());
+    }
+    ASSERT_EQ(sut.spilledSize(), 0u);
 
-    sut.write({dataPacketizer, dataPacketizer + TEST_BLOCK_LENGTH});
-    dataPacketizer += TEST_BLOCK_LENGTH;
+    sut.write({data.begin() + written, data.end()});
+    auto rest = sut.readAll();
+    read.insert(read.end(), rest.begin(), rest.end());
 
-    auto readBlock3 = sut.read(TEST_BLOCK_LENGTH);
-    auto readBlock4 = sut.readAll();
+    ASSERT_EQ(read, data);
+}
+
+TEST_F(BoundedMemoryStrategyTest, SpillFileDoesNotContainPlaintext)
+{
+    BoundedMemoryStrategy sut(64, BoundedMemoryStrategy::OverflowPolicy::SpillToFile);
+    std::vector<uint8_t> plaintext(4096, 'P');
+    sut.write(plaintext);
+    ASSERT_EQ(sut.spilledSize(), 4096u - 64u);
+
+    auto spillFd = findSpillFileDescriptor();
+    ASSERT_GE(spillFd, 0);
+    std::ifstream file("/proc/self/fd/" + std::to_string(spillFd), std::ios::binary);
+    std::vector<uint8_t> fileContent{std::istreambuf_iterator<char>(file),
+                                     std::istreambuf_iterator<char>()};
+
+    ASSERT_EQ(fileContent.size(), sut.spilledSize());
+    ASSERT_LT(std::count(fileContent.begin(), fileContent.end(), 'P'), 100);
+    ASSERT_EQ(sut.readAll(), plaintext);
+}
+
+TEST_F(BoundedMemoryStrategyTest, FailedSpillMakesAllFurtherAccessesThrow)
+{
+    BoundedMemoryStrategy sut(64, BoundedMemoryStrategy::OverflowPolicy::SpillToFile);
+    sut.write(makeData(128, 0));
+    ASSERT_EQ(sut.spilledSize(), 64u);
+
+    // Replace the spill file with a read-only descriptor, so that the next pwrite() fails.
+    auto spillFd = findSpillFileDescriptor();
+    ASSERT_GE(spillFd, 0);
+    int readOnlyFd = open("/dev/null", O_RDONLY);
+    ASSERT_GE(readOnlyFd, 0);
+    ASSERT_EQ(dup2(readOnlyFd, spillFd), spillFd);
+    close(readOnlyFd);
+
+    ASSERT_THROW(sut.write(makeData(64, 128)), MoCOCrWException);
+    ASSERT_THROW(sut.write(makeData(1, 192)), MoCOCrWException);
+    ASSERT_THROW(sut.read(16), MoCOCrWException);
+    ASSERT_THROW(sut.readAll(), MoCOCrWException);
+}
+
+TEST_F(BoundedMemoryStrategyTest, ThrowsOnInvalidParameters)
+{
+    ASSERT_THROW(BoundedMemoryStrategy(0, BoundedMemoryStrategy::OverflowPolicy::Backpressure),
+                 MoCOCrWException);
 
-    assembleFromChunksAndCompareWithExpected(_expectedData,
-                                             {readBlock1, readBlock2, readBlock3, readBlock4});
+    BoundedMemoryStrategy sut(
+            4, BoundedMemoryStrategy::OverflowPolicy::SpillToFile, "/nonexistent/directory");
+    ASSERT_THROW(sut.write(makeData(10, 0)), MoCOCrWException);
 }
@@ -19,6 +19,11 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <set>
+#include <thread>
 
 #include "util.cpp"
 
@@ -78,3 +83,81 @@ TEST_F(UtilTest, testFromHex)
 
     ASSERT_THROW(result = mococrw::utility::fromHex("  deadbeef"), mococrw::MoCOCrWException);
 }
+
+TEST_F(UtilTest, randomPoolNeverRepeatsBytes)
+{
+    using mococrw::utility::RandomPool;
+
+    std::set<std::vector<uint8_t>> seen;
+    for (size_t length : {1, 12, 16, 100, 4095, 4096, 10000}) {
+        for (int i = 0; i < 100; i++) {
+            std::vector<uint8_t> buffer(length);
+            RandomPool::fill(buffer.data(), buffer.size());
+            if (length >= 12) {
+                EXPECT_TRUE(seen.insert(buffer).second);
+            }
+        }
+    }
+
+    RandomPool::discardBuffer();
+    RandomPool::fill(nullptr, 0);
+    EXPECT_EQ(mococrw::utility::cryptoRandomBytes(32).size(), 32u);
+}
+
+TEST_F(UtilTest, randomPoolFromMultipleThreads)
+{
+    const size_t threads = 4;
+    const size_t valuesPerThread = 2000;
+    std::vector<std::vector<std::vector<uint8_t>>> values(threads);
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&values, t, valuesPerThread]() {
+            for (size_t i = 0; i < valuesPerThread; i++) {
+                values[t].push_back(mococrw::utility::cryptoRandomBytes(16));
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    std::set<std::vector<uint8_t>> unique;
+    for (const auto &perThread : values) {
+        unique.insert(perThread.begin(), perThread.end());
+    }
+    EXPECT_EQ(unique.size(), threads * valuesPerThread);
+}
+
+TEST_F(UtilTest, randomPoolDiffersAfterFork)
+{
+    using mococrw::utility::RandomPool;
+
+    // Make sure the buffer of this thread holds unused bytes when forking.
+    uint8_t primer = 0;
+    RandomPool::fill(&primer, 1);
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        uint8_t childBytes[32];
+        RandomPool::fill(childBytes, sizeof(childBytes));
+        bool written = write(fds[1], childBytes, sizeof(childBytes)) == sizeof(childBytes);
+        _exit(written ? 0 : 1);
+    }
+
+    std::vector<uint8_t> parentBytes(32);
+    RandomPool::fill(parentBytes.data(), parentBytes.size());
+
+    std::vector<uint8_t> childBytes(32);
+    ASSERT_EQ(read(fds[0], childBytes.data(), childBytes.size()),
+              static_cast<ssize_t>(childBytes.size()));
+    int status = 0;
+    waitpid(pid, &status, 0);
+    close(fds[0]);
+    close(fds[1]);
+
+    EXPECT_NE(parentBytes, childBytes);
+}
@@ -154,6 +154,28 @@ TEST_F(VerificationTest, testExpiredCertValidationFails)
     ASSERT_THROW(_root1_expired->verify(trustStore, intermediateCAs), MoCOCrWException);
 }
 
+TEST_F(VerificationTest, testTryVerifyReportsTheVerificationError)
+{
+    std::vector<X509Certificate> trustStore{*_root1.get()};
+
+    auto result = _root1_cert1->tryVerify(trustStore, {});
+    EXPECT_TRUE(result.isValid());
+
+    result = _root1_expired->tryVerify(trustStore, {});
+    EXPECT_EQ(result.getStatus(), VerificationStatus::CertificateInvalid);
+    EXPECT_EQ(result.getDetailCode(), X509_V_ERR_CERT_HAS_EXPIRED);
+    EXPECT_THAT(result.getMessage(), ::testing::HasSubstr("expired"));
+
+    result = _root1_cert1->tryVerify(std::vector<X509Certificate>{*_eccRoot.get()}, {});
+    EXPECT_FALSE(result);
+    EXPECT_EQ(result.getDetailCode(), X509_V_ERR_UNABLE_TO_GET_ISSUER_CERT_LOCALLY);
+
+    /* An invalid context is a usage error and still throws. */
+    VerificationContext ctx;
+    ctx.enforceCrlsForAllCAs();
+    EXPECT_THROW(_root1_cert1->tryVerify(ctx), MoCOCrWException);
+}
+
 TEST_F(VerificationTest, testExpiredEccCertValidationFails)
 {
     std::vector<X509Certificate> trustStore{*_eccRoot.get()};